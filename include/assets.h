@@ -0,0 +1,58 @@
+// Generated by tools/build_assets.py from assets/manifest.txt - do not edit
+#ifndef ASSETS_H
+#define ASSETS_H
+
+#include "rle_asset.h"
+
+// arrow_left: 50x50, 2 colours from arrow_left.xbm
+// 195 bytes RLE vs 350 bytes 1-bit / 5000 bytes RGB565
+static constexpr uint16_t ASSET_ARROW_LEFT_PALETTE[] = {0x0000, 0xFFFF};
+static constexpr uint8_t ASSET_ARROW_LEFT_DATA[] = {
+    0x0F, 0xCB, 0x1B, 0x0F, 0x13, 0x1F, 0x02, 0x0F, 0x0E, 0x1F, 0x06, 0x0F, 0x0B, 0x1F, 0x08, 0x0F,
+    0x08, 0x1A, 0x05, 0x1A, 0x0F, 0x05, 0x18, 0x0B, 0x18, 0x0F, 0x03, 0x17, 0x0F, 0x00, 0x17, 0x0F,
+    0x01, 0x17, 0x0F, 0x02, 0x17, 0x0F, 0x00, 0x15, 0x0F, 0x06, 0x15, 0x0E, 0x15, 0x0F, 0x08, 0x15,
+    0x0C, 0x15, 0x0F, 0x0A, 0x15, 0x0B, 0x15, 0x0F, 0x0A, 0x15, 0x0A, 0x15, 0x0F, 0x0C, 0x15, 0x09,
+    0x14, 0x0F, 0x0E, 0x14, 0x09, 0x14, 0x0F, 0x0F, 0x13, 0x08, 0x14, 0x0F, 0x1D, 0x14, 0x0F, 0x19,
+    0x1C, 0x0F, 0x15, 0x1B, 0x0F, 0x0F, 0x11, 0x05, 0x19, 0x0F, 0x0F, 0x13, 0x05, 0x17, 0x0F, 0x0F,
+    0x15, 0x05, 0x15, 0x0F, 0x0F, 0x17, 0x05, 0x13, 0x0F, 0x0F, 0x19, 0x05, 0x11, 0x0F, 0x0F, 0x1B,
+    0x0F, 0x19, 0x14, 0x0F, 0x1D, 0x14, 0x0F, 0x1D, 0x14, 0x08, 0x13, 0x0F, 0x0F, 0x14, 0x09, 0x14,
+    0x0F, 0x0E, 0x14, 0x09, 0x15, 0x0F, 0x0C, 0x15, 0x0A, 0x15, 0x0F, 0x0A, 0x15, 0x0B, 0x15, 0x0F,
+    0x0A, 0x15, 0x0C, 0x15, 0x0F, 0x08, 0x15, 0x0E, 0x15, 0x0F, 0x06, 0x15, 0x0F, 0x00, 0x17, 0x0F,
+    0x02, 0x17, 0x0F, 0x01, 0x17, 0x0F, 0x00, 0x17, 0x0F, 0x03, 0x18, 0x0B, 0x18, 0x0F, 0x05, 0x1A,
+    0x05, 0x1A, 0x0F, 0x08, 0x1F, 0x08, 0x0F, 0x0B, 0x1F, 0x06, 0x0F, 0x0E, 0x1F, 0x02, 0x0F, 0x13,
+    0x1B, 0x0F, 0xCB,
+};
+static constexpr RleAsset ASSET_ARROW_LEFT = {
+    "arrow_left", 50, 50, 2, ASSET_ARROW_LEFT_PALETTE, ASSET_ARROW_LEFT_DATA, sizeof(ASSET_ARROW_LEFT_DATA)
+};
+
+// arrow_right: 50x50, 2 colours from arrow_left.xbm (mirror)
+// 195 bytes RLE vs 350 bytes 1-bit / 5000 bytes RGB565
+static constexpr uint16_t ASSET_ARROW_RIGHT_PALETTE[] = {0x0000, 0xFFFF};
+static constexpr uint8_t ASSET_ARROW_RIGHT_DATA[] = {
+    0x0F, 0xCB, 0x1B, 0x0F, 0x13, 0x1F, 0x02, 0x0F, 0x0E, 0x1F, 0x06, 0x0F, 0x0B, 0x1F, 0x08, 0x0F,
+    0x08, 0x1A, 0x05, 0x1A, 0x0F, 0x05, 0x18, 0x0B, 0x18, 0x0F, 0x03, 0x17, 0x0F, 0x00, 0x17, 0x0F,
+    0x01, 0x17, 0x0F, 0x02, 0x17, 0x0F, 0x00, 0x15, 0x0F, 0x06, 0x15, 0x0E, 0x15, 0x0F, 0x08, 0x15,
+    0x0C, 0x15, 0x0F, 0x0A, 0x15, 0x0B, 0x15, 0x0F, 0x0A, 0x15, 0x0A, 0x15, 0x0F, 0x0C, 0x15, 0x09,
+    0x14, 0x0F, 0x0E, 0x14, 0x09, 0x13, 0x0F, 0x0F, 0x14, 0x0F, 0x1E, 0x14, 0x0F, 0x1D, 0x14, 0x0F,
+    0x19, 0x1C, 0x04, 0x11, 0x0F, 0x0F, 0x1B, 0x03, 0x13, 0x0F, 0x0F, 0x19, 0x03, 0x15, 0x0F, 0x0F,
+    0x17, 0x03, 0x17, 0x0F, 0x0F, 0x15, 0x03, 0x19, 0x0F, 0x0F, 0x13, 0x03, 0x1B, 0x0F, 0x0F, 0x11,
+    0x08, 0x14, 0x0F, 0x1D, 0x14, 0x0F, 0x1D, 0x14, 0x0F, 0x1E, 0x14, 0x0F, 0x0F, 0x13, 0x09, 0x14,
+    0x0F, 0x0E, 0x14, 0x09, 0x15, 0x0F, 0x0C, 0x15, 0x0A, 0x15, 0x0F, 0x0A, 0x15, 0x0B, 0x15, 0x0F,
+    0x0A, 0x15, 0x0C, 0x15, 0x0F, 0x08, 0x15, 0x0E, 0x15, 0x0F, 0x06, 0x15, 0x0F, 0x00, 0x17, 0x0F,
+    0x02, 0x17, 0x0F, 0x01, 0x17, 0x0F, 0x00, 0x17, 0x0F, 0x03, 0x18, 0x0B, 0x18, 0x0F, 0x05, 0x1A,
+    0x05, 0x1A, 0x0F, 0x08, 0x1F, 0x08, 0x0F, 0x0B, 0x1F, 0x06, 0x0F, 0x0E, 0x1F, 0x02, 0x0F, 0x13,
+    0x1B, 0x0F, 0xCB,
+};
+static constexpr RleAsset ASSET_ARROW_RIGHT = {
+    "arrow_right", 50, 50, 2, ASSET_ARROW_RIGHT_PALETTE, ASSET_ARROW_RIGHT_DATA, sizeof(ASSET_ARROW_RIGHT_DATA)
+};
+
+// Every asset, for the render benchmark
+static constexpr const RleAsset* ASSET_LIST[] = {
+    &ASSET_ARROW_LEFT,
+    &ASSET_ARROW_RIGHT,
+};
+static constexpr int ASSET_COUNT = 2;
+
+#endif
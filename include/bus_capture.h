@@ -0,0 +1,63 @@
+#ifndef BUS_CAPTURE_H
+#define BUS_CAPTURE_H
+
+#ifdef HEADLESS_DISPLAY
+
+#include <LovyanGFX.hpp>
+#include "st7789_capture.h"
+
+/**
+ * Bus_Capture - LovyanGFX bus that feeds an St7789Capture instead of SPI
+ *
+ * Build with -DHEADLESS_DISPLAY and LGFX uses this in place of Bus_SPI.
+ * The real Panel_ST7789 driver still generates every command, window and
+ * pixel, so the framebuffer and byte counters match what the board would
+ * receive. DMA calls complete immediately.
+ */
+class Bus_Capture : public lgfx::IBus {
+public:
+    Bus_Capture();
+    ~Bus_Capture() override;
+
+    St7789Capture& capture() { return model; }
+
+    lgfx::bus_type_t busType(void) const override { return lgfx::bus_type_t::bus_unknown; }
+    bool init(void) override { return true; }
+    void release(void) override {}
+
+    void beginTransaction(void) override {}
+    void endTransaction(void) override {}
+    void wait(void) override {}
+    bool busy(void) const override { return false; }
+    uint32_t getClock(void) const override { return clock; }
+    void setClock(uint32_t freq) override { clock = freq; }
+    void flush(void) override {}
+
+    bool writeCommand(uint32_t data, uint_fast8_t bit_length) override;
+    void writeData(uint32_t data, uint_fast8_t bit_length) override;
+    void writeDataRepeat(uint32_t data, uint_fast8_t bit_length, uint32_t count) override;
+    void writePixels(lgfx::pixelcopy_t* param, uint32_t length) override;
+    void writeBytes(const uint8_t* data, uint32_t length, bool dc, bool use_dma) override;
+
+    void initDMA(void) override {}
+    void addDMAQueue(const uint8_t* data, uint32_t length) override { writeBytes(data, length, true, true); }
+    void execDMAQueue(void) override {}
+    uint8_t* getDMABuffer(uint32_t length) override;
+
+    // Write-only panel
+    void beginRead(void) override {}
+    void endRead(void) override {}
+    uint32_t readData(uint_fast8_t /*bit_length*/) override { return 0; }
+    bool readBytes(uint8_t* /*dst*/, uint32_t /*length*/, bool /*use_dma*/) override { return false; }
+    void readPixels(void* /*dst*/, lgfx::pixelcopy_t* /*param*/, uint32_t /*length*/) override {}
+
+private:
+    St7789Capture model;
+    uint32_t clock;
+    uint8_t* dmaBuffer;
+    uint32_t dmaBufferSize;
+};
+
+#endif  // HEADLESS_DISPLAY
+
+#endif
@@ -2,29 +2,87 @@
 #define BUZZER_H
 
 #include <Arduino.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
 
+// One step of a cue: a tone, or silence when frequency is 0
+struct ToneStep {
+    uint16_t frequency;     // Hz, 0 = silence
+    uint16_t durationMs;
+};
+
+// A cue is a constexpr step table in flash
+struct BuzzerPattern {
+    const ToneStep* steps;
+    uint8_t count;
+};
+
+template <size_t N>
+constexpr BuzzerPattern makePattern(const ToneStep (&steps)[N]) {
+    return BuzzerPattern{steps, (uint8_t)N};
+}
+
+/**
+ * Buzzer - pattern sequencer on the LEDC tone output
+ *
+ * A cue plays step by step from a one-shot esp_timer: each step's
+ * deadline is measured from the start of the cue, so steps keep their
+ * length however busy loop() is and errors do not add up. Cues that
+ * arrive while one plays are queued; the start chirp and the alarm
+ * replace whatever is playing.
+ */
 class Buzzer {
 public:
     Buzzer();
-    
-    void begin();
-    
-    // Different beep patterns
+
+    void begin();   // Create the step timer
+
+    // Different beep patterns (warnings and the alarm are also started
+    // from the countdown's esp_timer task)
     void beepStart();        // Start timer - single chirp
     void beepYellowWarning(); // Yellow warning - two beeps
     void beepRedWarning();    // Red warning - three urgent beeps
     void beepFinished();      // Time's up - continuous alarm
-    
-    void update();  // Call in loop to handle non-blocking beeps
-    
+
+    /**
+     * Play a cue after the queued ones
+     * @param preempt  drop the playing and queued cues first
+     */
+    void play(const BuzzerPattern& pattern, bool preempt = false);
+    void stop();
+
+    void update();  // Steps without the esp_timer (fallback only)
+
+    bool isBusy() const { return active; }  // Cue playing (LEDC must stay clocked)
+
+    // Latest a step started after its deadline (since last call)
+    uint32_t getMaxLatenessUs() const { return maxLatenessUs; }
+    void resetStats() { maxLatenessUs = 0; }
+
+    static constexpr int QUEUE_SIZE = 4;
+    static constexpr int64_t LOCK_RETRY_US = 500;  // step timer found the lock taken
+
 private:
-    void tone(uint16_t frequency, unsigned long duration);
-    void noTone();
-    
-    bool isPlaying;
-    unsigned long toneEndTime;
+    void startStep();
+    void output(uint16_t frequency);
+    static void onStep(void* arg);
+    void nextStep();
+
+    BuzzerPattern current;
+    uint8_t stepIndex;
+    int64_t stepEndUs;          // deadline of the current step
+    volatile bool active;
+
+    BuzzerPattern queue[QUEUE_SIZE];
+    int queueHead;
+    int queueCount;
+
+    esp_timer_handle_t stepTimer;
+    SemaphoreHandle_t lock;     // loop, countdown task and step timer (which never waits)
+    uint32_t maxLatenessUs;
 };
 
 extern Buzzer buzzer;
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,67 @@
+#ifndef COUNTDOWN_SCHEDULE_H
+#define COUNTDOWN_SCHEDULE_H
+
+#include <stdint.h>
+
+// One-shot countdown events, in the order they normally fire
+enum CountdownEvent {
+    COUNTDOWN_YELLOW,
+    COUNTDOWN_RED,
+    COUNTDOWN_FINISHED,
+    COUNTDOWN_EVENT_COUNT
+};
+
+/**
+ * CountdownSchedule - deadlines of one countdown run
+ *
+ * start() turns the par time and warning thresholds into absolute
+ * deadlines on a 64-bit microsecond clock (esp_timer_get_time() on the
+ * device), so nothing wraps during any realistic uptime. The owner arms
+ * a hardware timer for nextDeadline() and calls fireDue() when it
+ * expires; each event fires exactly once per run.
+ *
+ * A warning at or above the par time would be due at the start and is
+ * left out, same as the old per-second transition check.
+ *
+ * Pure logic with no Arduino dependencies, so it can be driven by a
+ * virtual clock.
+ */
+class CountdownSchedule {
+public:
+    CountdownSchedule();
+
+    void start(uint64_t nowUs, uint32_t parMs, uint32_t yellowMs, uint32_t redMs);
+    void stop();
+
+    bool isRunning() const { return running; }
+    bool isFinished() const { return (fired & eventBit(COUNTDOWN_FINISHED)) != 0; }
+
+    /**
+     * Earliest deadline that has not fired yet
+     * @return false when nothing is left to fire
+     */
+    bool nextDeadline(uint64_t& deadlineUs) const;
+
+    /**
+     * Fire every event whose deadline is at or before nowUs
+     * @return bit mask of the events that fired now (1 << CountdownEvent)
+     */
+    uint8_t fireDue(uint64_t nowUs);
+
+    uint64_t getDeadline(CountdownEvent e) const { return deadline[e]; }
+
+    // Milliseconds left, rounded up (0 when not running)
+    uint32_t remainingMs(uint64_t nowUs) const;
+
+    static uint8_t eventBit(CountdownEvent e) { return 1 << e; }
+
+private:
+    bool running;
+    uint64_t startUs;
+    uint64_t durationUs;
+    uint64_t deadline[COUNTDOWN_EVENT_COUNT];
+    uint8_t armed;      // events scheduled for this run
+    uint8_t fired;      // events already fired
+};
+
+#endif
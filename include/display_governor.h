@@ -0,0 +1,119 @@
+#ifndef DISPLAY_GOVERNOR_H
+#define DISPLAY_GOVERNOR_H
+
+#include <stdint.h>
+
+// Refresh/backlight modes, slowest first
+enum DisplayMode {
+    DISPLAY_MODE_DIMMED,    // Idle past the dim timeout, backlight ramping down
+    DISPLAY_MODE_IDLE,      // Main screen, nothing happening
+    DISPLAY_MODE_MENU,      // Menu open (menu redraws on input only)
+    DISPLAY_MODE_ACTIVE,    // Recent encoder/IMU activity - level tracks the hand
+    DISPLAY_MODE_RUNNING,   // Countdown running
+    DISPLAY_MODE_FINAL,     // Last seconds of the countdown (sub-second digits)
+    DISPLAY_MODE_COUNT
+};
+
+// What the rest of the loop is doing, sampled once per pass
+struct DisplayActivity {
+    bool menuOpen;
+    bool keepBright;        // Timer armed/running or diagnostics open - never dim
+    bool timerRunning;
+    uint32_t remainingMs;
+    bool fastLevel;         // Bubble level shown - main screen at full rate
+};
+
+/**
+ * DisplayGovernor - frame rate and backlight level from what the user does
+ *
+ * Picks a display mode each loop pass: slow refresh on the idle main
+ * screen and in the menu, full rate while the countdown runs and in its
+ * last seconds, and while the bubble level is shown. After a period
+ * without encoder or IMU activity the backlight ramps down to a fraction
+ * of the configured level; any activity restores it on the next pass.
+ *
+ * Also integrates time per mode and backlight level over time, so the
+ * duty cycle can be compared against bench current measurements.
+ *
+ * Pure state machine with no Arduino dependencies, driven by millisecond
+ * timestamps like InactivityPolicy.
+ */
+class DisplayGovernor {
+public:
+    DisplayGovernor();
+
+    /**
+     * @param dimAfterMs    inactivity before the backlight ramps down (0 = never)
+     * @param finalBelowMs  remaining time that counts as the last seconds
+     */
+    void configure(uint32_t dimAfterMs, uint32_t finalBelowMs);
+
+    /**
+     * Encoder, button or IMU motion
+     */
+    void notifyActivity(uint32_t nowMs);
+
+    /**
+     * Advance the mode and accounting
+     * @param targetBrightness  configured backlight level (0-255)
+     */
+    void update(uint32_t nowMs, const DisplayActivity& activity, uint8_t targetBrightness);
+
+    /**
+     * Drop the time since the last update from the accounting
+     * (light sleep is accounted by PowerManager)
+     */
+    void skipElapsed(uint32_t nowMs);
+
+    /**
+     * True when the next main-screen frame is due at the current mode's rate
+     */
+    bool frameDue(uint32_t nowMs);
+
+    /**
+     * Time until frameDue() turns true (0 if a frame is already due)
+     */
+    uint32_t msUntilFrame(uint32_t nowMs) const;
+
+    DisplayMode getMode() const { return mode; }
+    uint32_t getFrameIntervalMs() const;
+    uint8_t getBacklight() const { return backlight; }
+
+    // Accounting since the last resetStats()
+    uint32_t getModeMs(DisplayMode m) const { return modeMs[m]; }
+    uint32_t getTotalMs() const;
+    uint32_t getFrames() const { return frames; }
+    float getBacklightDuty() const;    // 0..1, average backlight / full scale
+    void resetStats();
+
+    static const char* modeName(DisplayMode m);
+
+    // Frame interval per mode (ms), indexed by DisplayMode
+    static constexpr uint32_t FRAME_INTERVAL_MS[DISPLAY_MODE_COUNT] = {250, 100, 100, 33, 33, 17};
+
+    // Main screen rate while the bubble level is shown (not when dimmed)
+    static constexpr uint32_t FAST_LEVEL_INTERVAL_MS = 17;
+
+    // Activity keeps the main screen at ACTIVE rate this long
+    static constexpr uint32_t ACTIVE_HOLD_MS = 2000;
+
+    // Backlight ramp once the dim timeout has passed
+    static constexpr uint32_t DIM_RAMP_MS = 2000;
+    static constexpr uint8_t DIM_PERCENT = 20;
+
+private:
+    DisplayMode mode;
+    uint8_t backlight;
+    uint32_t lastActivityMs;
+    uint32_t lastUpdateMs;
+    uint32_t lastFrameMs;
+    uint32_t dimAfterMs;
+    uint32_t finalBelowMs;
+    bool fastLevel;
+
+    uint32_t modeMs[DISPLAY_MODE_COUNT];
+    uint64_t backlightIntegral;     // sum of level * ms
+    uint32_t frames;
+};
+
+#endif
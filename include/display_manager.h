@@ -3,6 +3,14 @@
 
 #include <LovyanGFX.hpp>
 #include "pin_config.h"
+#include "tile_canvas.h"
+#include "glyph_cache.h"
+#include "widgets.h"
+#include "level_predictor.h"
+#include "shot_log.h"
+#ifdef HEADLESS_DISPLAY
+#include "bus_capture.h"
+#endif
 
 // Color definitions
 #define COLOR_RED    0xF800
@@ -13,15 +21,41 @@
 #define COLOR_WHITE  0xFFFF
 #define COLOR_ORANGE 0xFD20
 
-// LovyanGFX for ST7789 display
+// LovyanGFX for ST7789 display. With HEADLESS_DISPLAY the panel driver
+// talks to an in-memory controller model instead of SPI (no backlight).
 class LGFX : public lgfx::LGFX_Device
 {
     lgfx::Panel_ST7789 _panel_instance;
+#ifdef HEADLESS_DISPLAY
+    Bus_Capture _bus_instance;
+#else
     lgfx::Bus_SPI _bus_instance;
     lgfx::Light_PWM _light_instance;
+#endif
 
 public:
     LGFX(void);
+
+#ifdef HEADLESS_DISPLAY
+    St7789Capture& capture() { return _bus_instance.capture(); }
+#endif
+};
+
+// Screen regions (portrait 170x320)
+#define LEVEL_REGION_HEIGHT 107
+#define TIMER_REGION_Y      LEVEL_REGION_HEIGHT
+#define TIMER_REGION_HEIGHT (320 - LEVEL_REGION_HEIGHT)
+
+// SPI traffic counters for the off-screen renderer
+struct DisplayStats {
+    uint32_t frames;
+    uint32_t totalBytes;
+    uint32_t lastFrameBytes;
+    uint32_t peakFrameBytes;
+    uint32_t maxBlockUs;      // Longest time loop() spent in display code
+    uint32_t widgetsPainted;  // Widget repaints (invalidated widgets only)
+    uint32_t maxFrameUs;      // Longest present() (paint + diff + push/queue)
+    uint32_t overBudgetFrames;// Frames where present() exceeded FRAME_BUDGET_US
 };
 
 class DisplayManager {
@@ -30,38 +64,114 @@ public:
     
     void begin();
     void setBrightness(int brightness);
+    void sleep();   // Panel sleep-in (deep sleep)
+    void wakeup();  // Panel sleep-out
+    
+    // Repaint invalidated widgets and push changed tiles (call once per frame)
+    void present();
+    
+    // Forget what is on the panel - next present() repaints both regions.
+    // Call after anything draws directly to the TFT (menu, full screens).
+    void invalidate();
+    
+    // Async presentation: present() queues tiles for DMA and service()
+    // feeds them to the bus without blocking (call every loop pass,
+    // returns true when nothing is left to send)
+    bool setAsyncPresent(bool enable);
+    bool isAsyncPresent() const { return asyncPresent; }
+    bool service();
+    
+    // Time loop() spent in display code this pass (for maxBlockUs)
+    void recordBlockTime(uint32_t us);
+    
+    const DisplayStats& getStats() const { return stats; }
+    void resetStats();
+    
+    // Level display (top 1/3) - retained, repainted on present() if changed.
+    // Rate and sample time let the bubble mode extrapolate to display time.
+    void setLevel(float angle, uint16_t color, float rateDps, uint32_t sampleUs);
     
-    // Level display (top 1/3)
-    void drawLevelIndicator(float angle, uint16_t color, const char* status);
-    void updateLevelAngle(float angle, uint16_t color);
+    // Bubble latency compensation and its sensor-to-photon measurement
+    LevelPredictor& getLevelPredictor() { return levelPredictor; }
     
-    // Timer display (bottom 2/3)
-    void drawTimerDisplay(int remainingSeconds, float percentage, uint16_t timerColor, const char* stateText);
+    // Timer display (bottom 2/3) - retained, repainted on present() if changed.
+    // While running, the last FINE_TIME_BELOW_MS show tenths/hundredths.
+    void setTimer(uint32_t remainingMs, bool running, float percentage, uint16_t timerColor, const char* stateText);
     
-    // Full screen displays
-    void drawShooterReady();
+    // Split timer: shot count bar and first/fastest split (nullptr = hidden)
+    void setShots(const ShotLog* log);
     
-    // Microphone diagnostic display
-    void drawMicDiagnostics(float magnitude, float threshold, float noiseFloor, 
-                           float peakMag, float avgMag, int detections);
+    // Performance overlay: replaces the par/version/shot lines of the timer region
+    void showPerfOverlay(bool show);
+    void setPerfLine(int line, const char* text);
+    static constexpr int PERF_LINES = 4;
     
-    // Helper functions
-    void drawProgressBar(int x, int y, int width, int height, float percentage, uint16_t color);
+    // Full screen displays (drawn once; next present() restores the regions)
+    void showShooterReady();
     
-    // Arrow display functions
-    void drawDirectionalArrow(float angle);
-    void drawCurvedArrow(int cx, int cy, bool pointLeft);
-    void drawCheckmark(int cx, int cy);
+    // Low-power standby: ST7789 partial mode keeps only the top STANDBY_ROWS
+    // lit (level strip + timer face) and idle mode drops to 8 colours. The
+    // level strip stays live, the timer face is frozen until standby ends.
+    void setStandby(bool on);
+    bool isStandby() const { return standby; }
+    static constexpr int STANDBY_ROWS = TIMER_REGION_Y + 100;
+    
+    // Font vs glyph-cache render time per readout, printed to serial
+    void runRenderBenchmark();
+    
+    // Off-screen region depth: 16 (RGB565), 8 or 4 bpp palette indexed.
+    // Reallocates both canvases and repaints everything.
+    bool setCanvasDepth(int bpp);
+    int getCanvasDepth() const { return levelCanvas.getColorDepth(); }
+    
+    // Canvas RAM, palette use and the time to push both regions in full
+    void printCanvasReport();
     
     LGFX* getTFT() { return &tft; }
     
+    // Canvas depth at boot - 16 bpp keeps the glyph cache on plain row copies
+    static constexpr int CANVAS_BPP = 16;
+    
+    // Render budget per frame for present(), checked on every frame
+    static constexpr uint32_t FRAME_BUDGET_US = 4000;
+    
+    // Angle at either end of the bubble vial
+    static constexpr float BUBBLE_RANGE_DEG = 5.0f;
+    
+    // Sub-second readout below this (when enabled in the Timer menu)
+    static constexpr uint32_t FINE_TIME_BELOW_MS = 10000;
+    
 private:
     LGFX tft;
-    bool firstDraw;
-    int lastDrawnSeconds;
-    float lastDisplayedAngle;
-    uint16_t lastStatusColor;
-    int lastArrowDirection; // track arrow state
+    TileCanvas levelCanvas;
+    TileCanvas timerCanvas;
+    GlyphCache levelGlyphs;
+    GlyphCache timerGlyphs;
+    DisplayStats stats;
+    bool asyncPresent;
+    bool fullScreenShown;
+    bool standby;
+    bool perfOverlay;
+    LevelPredictor levelPredictor;
+    bool bubbleInFlight;    // bubble frame queued, DMA not finished
+    
+    // Level region widget tree
+    PanelWidget levelBanner;
+    ReadoutWidget angleReadout;
+    BitmapWidget levelArrow;
+    BubbleWidget levelBubble;
+    LabelWidget levelLabel;
+    
+    // Timer region widget tree
+    PanelWidget timerPanel;
+    LabelWidget stateLabel;
+    ReadoutWidget timeReadout;
+    ProgressBarWidget progressBar;
+    LabelWidget parLabel;
+    ProgressBarWidget shotBar;
+    LabelWidget shotLabel;
+    LabelWidget versionLabel;
+    LabelWidget perfLines[PERF_LINES];
 };
 
 extern DisplayManager display;
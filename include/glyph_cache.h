@@ -0,0 +1,67 @@
+#ifndef GLYPH_CACHE_H
+#define GLYPH_CACHE_H
+
+#include <LovyanGFX.hpp>
+
+/**
+ * GlyphCache - pre-rasterized large digits for the timer and angle readouts
+ *
+ * Holds "0-9 : - ." rendered once from the built-in font at text size 5
+ * (30x40 px cells) in RGB565 for one foreground/background pair. Drawing
+ * a readout is then a row copy per glyph into the off-screen canvas
+ * instead of ~100 scaled fillRects per character. The set is rebuilt only
+ * when the colour pair changes (warning thresholds, level state).
+ *
+ * Buffer (~31KB) goes to PSRAM when the board has it, internal RAM otherwise.
+ */
+class GlyphCache {
+public:
+    GlyphCache();
+
+    /**
+     * Allocate the glyph buffer
+     * @return false if no memory - callers fall back to font rendering
+     */
+    bool begin();
+    bool isReady() const { return glyphs != nullptr; }
+
+    /**
+     * Select colours, re-rasterizing the set if they changed
+     */
+    void setColors(uint16_t fg, uint16_t bg);
+
+    /**
+     * Copy glyphs for text into a 16-bit sprite at (x, y)
+     * @return width drawn in pixels
+     */
+    int drawString(LGFX_Sprite& dst, int x, int y, const char* text) const;
+
+    /**
+     * Same for an 8 or 4 bpp palette sprite: foreground pixels of the
+     * cached glyphs become fgIndex, the rest bgIndex
+     */
+    int drawStringIndexed(LGFX_Sprite& dst, int x, int y, const char* text,
+                          uint8_t fgIndex, uint8_t bgIndex) const;
+
+    static int textWidth(int length) { return length * GLYPH_W; }
+
+    static constexpr int TEXT_SIZE = 5;
+    static constexpr int GLYPH_W = 6 * TEXT_SIZE;
+    static constexpr int GLYPH_H = 8 * TEXT_SIZE;
+    static constexpr int GLYPH_COUNT = 13;  // 0-9 : - .
+
+    // Rebuilds since boot (should stay small)
+    uint32_t getRasterizeCount() const { return rasterizeCount; }
+
+private:
+    uint16_t* glyphs;
+    uint16_t fgColor;
+    uint16_t bgColor;
+    bool rasterized;
+    uint32_t rasterizeCount;
+
+    static int glyphIndex(char c);
+    void rasterize();
+};
+
+#endif
@@ -0,0 +1,73 @@
+#ifndef INACTIVITY_POLICY_H
+#define INACTIVITY_POLICY_H
+
+#include <stdint.h>
+
+// Power states driven by the inactivity policy
+enum PowerState {
+    POWER_ACTIVE,
+    POWER_LIGHT_SLEEP,
+    POWER_DEEP_SLEEP
+};
+
+// What the caller should do after an update()
+enum PowerAction {
+    POWER_ACTION_NONE,
+    POWER_ACTION_LIGHT_SLEEP,
+    POWER_ACTION_DEEP_SLEEP
+};
+
+/**
+ * InactivityPolicy - decides when the timer may sleep
+ *
+ * Pure state machine with no Arduino dependencies. All times are passed
+ * in as millisecond timestamps so it can be driven by millis() on the
+ * board or by a simulated clock on the host. Timestamp math is done with
+ * unsigned subtraction, so millis() wraparound is handled.
+ */
+class InactivityPolicy {
+public:
+    InactivityPolicy();
+
+    /**
+     * Set timeouts measured from the last activity
+     * A timeout of 0 disables that sleep level
+     */
+    void configure(uint32_t lightSleepAfterMs, uint32_t deepSleepAfterMs);
+
+    /**
+     * Encoder, button or IMU motion - returns to POWER_ACTIVE
+     */
+    void notifyActivity(uint32_t nowMs);
+
+    /**
+     * While inhibited (timer running, menu open...) the policy never sleeps.
+     * Leaving the inhibited state restarts the idle countdown.
+     */
+    void setInhibited(bool inhibit, uint32_t nowMs);
+
+    /**
+     * Advance the state machine
+     * @return action the caller should perform now
+     */
+    PowerAction update(uint32_t nowMs);
+
+    PowerState getState() const { return state; }
+    bool isInhibited() const { return inhibited; }
+    uint32_t getIdleMs(uint32_t nowMs) const { return nowMs - lastActivityMs; }
+
+    /**
+     * Milliseconds until the next sleep transition is due
+     * Returns UINT32_MAX when nothing is pending
+     */
+    uint32_t msUntilNextTransition(uint32_t nowMs) const;
+
+private:
+    PowerState state;
+    bool inhibited;
+    uint32_t lastActivityMs;
+    uint32_t lightSleepAfterMs;
+    uint32_t deepSleepAfterMs;
+};
+
+#endif
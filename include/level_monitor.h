@@ -15,16 +15,22 @@ public:
     LevelMonitor();
     
     void begin(SensorQMI8658* qmiPtr, CRGB* ledsPtr);
+    void configureSensors();  // Accel + gyro at full rate (boot and wake from sleep)
     void update();
     void calibrate();
     
     float getRawAngle() const { return rawAngle; }
     float getFilteredAngle() const { return filteredAngle; }
+    float getAngleRate() const { return gyro.z; }          // deg/s, same sign as the angle
+    uint32_t getSampleUs() const { return sampleUs; }      // micros() when the IMU was read
     LevelState getState() const { return currentState; }
     uint16_t getStatusColor() const;
     CRGB getLEDColor() const;
     const char* getStatusText() const;
     
+    // Recoil (accel spike) since the last call - shot source for the split timer
+    bool takeRecoil(int64_t& atUs);
+    
     bool needsRedraw() const { return stateChanged; }
     void clearRedrawFlag() { stateChanged = false; }
     
@@ -48,6 +54,13 @@ private:
     
     // Timing for sensor fusion
     unsigned long lastUpdateTime;
+    uint32_t sampleUs;
+    
+    // Recoil detection: deviation from 1 g and dead time after a spike
+    int64_t lastRecoilUs;
+    bool recoilPending;
+    static constexpr float RECOIL_G = 1.5f;
+    static constexpr int64_t RECOIL_REFRACTORY_US = 150000;
     
     // Sensor fusion weight (98% gyro, 2% accel), inceased to 88/12 for faster response
     static constexpr float GYRO_WEIGHT = 0.95;
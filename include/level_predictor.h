@@ -0,0 +1,106 @@
+#ifndef LEVEL_PREDICTOR_H
+#define LEVEL_PREDICTOR_H
+
+#include <stdint.h>
+
+/**
+ * LevelPredictor - latency compensation and measurement for the bubble
+ *
+ * An IMU sample takes a while to reach the glass: it ages until the next
+ * frame is rendered, the changed tiles queue behind the SPI DMA, and the
+ * panel only shows new GRAM contents when its scan passes that row.
+ * predict() extrapolates the angle along the gyro rate over that whole
+ * delay, so the bubble sits where the rifle is rather than where it was.
+ *
+ * The delay is measured on every frame that moves the bubble: render
+ * time to last tile sent, plus an average scan-out wait. The frame is
+ * then checked against the first IMU sample taken after it became
+ * visible; the error of the predicted and of the plain angle are
+ * accumulated side by side, so the compensation can be judged on the
+ * device (`level` command).
+ *
+ * Pure logic with no Arduino dependencies, driven by microsecond
+ * timestamps like DisplayGovernor.
+ */
+class LevelPredictor {
+public:
+    LevelPredictor();
+
+    // Off = show the plain angle (still measured, for comparison)
+    void setEnabled(bool on) { enabled = on; }
+    bool isEnabled() const { return enabled; }
+
+    /**
+     * Angle to draw for a frame rendered now
+     * @param rateDps   angular rate of the sample (deg/s)
+     * @param sampleUs  when the sample was read
+     */
+    float predict(float angle, float rateDps, uint32_t sampleUs, uint32_t nowUs);
+
+    /**
+     * The last predicted frame changed pixels and was pushed or queued
+     */
+    void frameQueued();
+
+    /**
+     * Every tile of the queued frame has gone out on the bus
+     */
+    void frameSent(uint32_t nowUs);
+
+    /**
+     * New IMU sample - scores the frame on glass once the sample is newer
+     */
+    void sample(float angle, uint32_t sampleUs);
+
+    // Render-to-glass delay currently used for extrapolation
+    uint32_t getPipelineUs() const { return pipelineUs; }
+
+    // Accounting since the last resetStats()
+    uint32_t getFrames() const { return framesSent; }
+    uint32_t getAvgLatencyUs() const;   // sample read to visible
+    uint32_t getMaxLatencyUs() const { return maxLatencyUs; }
+    uint32_t getScored() const { return scored; }
+    float getRmsErrorPredicted() const;
+    float getRmsErrorRaw() const;
+    void resetStats();
+
+    // Average wait for the ST7789 scan (60 Hz refresh) to reach new pixels
+    static constexpr uint32_t PANEL_SCAN_US = 8300;
+
+    // Starting estimate for render-to-glass, before the first measurement
+    static constexpr uint32_t PIPELINE_INIT_US = 12000;
+
+    // Never extrapolate further than this (stale sample, stalled loop)
+    static constexpr uint32_t MAX_HORIZON_US = 60000;
+
+private:
+    enum FrameState {
+        FRAME_NONE,
+        FRAME_RENDERED,     // predicted, not yet known to change the panel
+        FRAME_QUEUED,       // tiles pushed or waiting for DMA
+        FRAME_VISIBLE       // waiting for a newer IMU sample to score it
+    };
+
+    struct Frame {
+        FrameState state;
+        uint32_t sampleUs;
+        uint32_t renderUs;
+        uint32_t visibleUs;
+        float rawAngle;
+        float shownAngle;
+    };
+
+    bool enabled;
+    uint32_t pipelineUs;
+    Frame candidate;        // last predict()
+    Frame frame;            // frame on its way to the glass
+
+    uint32_t framesSent;
+    uint64_t latencySumUs;
+    uint32_t maxLatencyUs;
+    uint32_t scored;
+    float sumSqPredicted;
+    float sumSqRaw;
+};
+
+#endif
@@ -2,64 +2,109 @@
 #define MENU_SYSTEM_H
 
 #include "display_manager.h"
+#include "render_queue.h"
 #include <LovyanGFX.hpp>
 #include <RotaryEncoder.h>
 
 enum MenuState {
     MAIN_DISPLAY,
-    MENU_TOP_LEVEL,
-    MENU_LEVEL_SUBMENU,
-    MENU_DISPLAY_SUBMENU,
-    MENU_TIMER_SUBMENU,
-    MENU_MIC_SUBMENU,           // NEW: Microphone submenu
+    MENU_PAGE,                  // Browsing a page (top level or submenu)
     MIC_DIAGNOSTIC_MODE,        // NEW: Real-time mic monitor
     ADJUSTING_VALUE
 };
 
+struct MenuValue;
+struct MenuPage;
+
+/**
+ * MenuSystem - settings menu driven by constexpr page tables
+ *
+ * Each page is a table of rows (label, action, value descriptor, hook);
+ * each adjustable value a descriptor with its target field, bounds, step
+ * and apply hook. handleButton()/handleRotation() only update the state
+ * and mark what changed: the old and new selected rows, or the value box
+ * on the adjust screen. render() queues just those onto the render
+ * queue, once the previous repaint has reached the panel, so fast turns
+ * collapse into one repaint of the latest state.
+ */
 class MenuSystem {
 public:
     MenuSystem();
     
-    void begin(LGFX* tftPtr, RotaryEncoder* encoderPtr);
+    void begin(RenderQueue* queue, RotaryEncoder* encoderPtr);
     void handleButton();
     void handleRotation(int delta);
+
+    /**
+     * Queue the repaint of whatever changed - call every loop pass,
+     * before the render queue is serviced
+     */
+    void render();
     
     MenuState getState() const { return currentMenu; }
     bool isInMenu() const { return currentMenu != MAIN_DISPLAY; }
     bool isInMicDiagnostic() const { return currentMenu == MIC_DIAGNOSTIC_MODE; }
+
+    /**
+     * Repaint the whole page on every detent (the old behaviour, for
+     * comparing latency)
+     */
+    void setFullRedraw(bool full) { fullRedraw = full; }
+    bool isFullRedraw() const { return fullRedraw; }
+
+    /**
+     * Encoder-to-pixel latency: detent seen in loop() until its repaint
+     * has left the render queue
+     */
+    void printReport();
+    void resetStats();
+
+    // Row hooks (referenced from the page tables)
+    void runCalibrate(uint8_t arg);
+    void runCycleDisplayMode(uint8_t arg);
+    void runCycleFineDigits(uint8_t arg);
+    void runTogglePerfOverlay(uint8_t arg);
+    void runMicMonitor(uint8_t arg);
+    void runSelectProfile(uint8_t arg);
     
 private:
-    LGFX* tft;
+    RenderQueue* screen;        // pages are queued, drawn a slice per loop pass
     RotaryEncoder* encoder;
     
     MenuState currentMenu;
-    int selectedTopItem;
-    int selectedLevelItem;
-    int selectedTimerItem;
-    int selectedDisplayItem;
-    int selectedMicItem;        // NEW: Track microphone menu selection
-    
-    // Value adjustment
-    float* adjustingFloatValue;
-    int* adjustingIntValue;
+    const MenuPage* page;
+    int selected;
+    const MenuValue* adjusting; // value on the adjust screen
+
+    // Repaint bookkeeping
+    bool pageDirty;             // whole page / adjust screen
+    uint32_t dirtyRows;         // bit per row of the current page
+    bool valueDirty;            // value box on the adjust screen
+    bool fullRedraw;
+
+    // Latency measurement
+    bool detentPending;         // turned since the last repaint was queued
+    uint32_t detentUs;          // first such detent
+    bool awaitingPixels;        // repaint queued, waiting for the queue to drain
+    uint32_t paintingSinceUs;   // detent that repaint is for
+    uint32_t latencyCount;
+    uint32_t latencySumUs;
+    uint32_t latencyMaxUs;
+    uint32_t repaints;          // detent repaints queued
+    uint32_t detents;
+    uint32_t fillBytes;         // pixel bytes of the fills queued (estimate)
     
-    // Menu drawing
-    void drawTopMenu();
-    void drawLevelSubmenu();
-    void drawTimerSubmenu();
-    void drawDisplaySubmenu();
-    void drawMicSubmenu();      // NEW: Draw microphone menu
-    void drawValueAdjustment(const char* label, float value, const char* unit);
-    void drawValueAdjustment(const char* label, int value, const char* unit);
+    void openPage(const MenuPage* target, int row);
+    void markRotation();
     
-    // Menu execution
-    void executeTopMenuItem(int item);
-    void executeLevelMenuItem(int item);
-    void executeTimerMenuItem(int item);
-    void executeDisplayMenuItem(int item);
-    void executeMicMenuItem(int item);  // NEW: Execute mic menu items
+    // Drawing
+    void drawPage();
+    void drawRow(int row, bool clear);
+    void drawAdjustScreen();
+    void drawValueBox(bool clear);
+    void drawFooter(const char* turnHint, const char* pressHint, int y);
 };
 
 extern MenuSystem menu;
 
-#endif
\ No newline at end of file
+#endif
@@ -3,6 +3,7 @@
 
 #include <Arduino.h>
 #include <driver/i2s.h>
+#include "tone_blanker.h"
 
 /**
  * Statistics structure for diagnostic display
@@ -17,6 +18,16 @@ struct MicStats {
     float snrThreshold;
 };
 
+/**
+ * I2S DMA health for the performance overlay
+ */
+struct MicAudioStats {
+    uint32_t blocksRead;      // Blocks handed to the Goertzel filters
+    uint32_t overruns;        // DMA ring full - samples were dropped
+    uint8_t fillPercent;      // DMA ring fill at the last read
+    uint8_t peakFillPercent;  // Highest fill since clearAudioPeak()
+};
+
 /**
  * MicDetector - I2S Microphone interface for detecting beeps
  *
@@ -51,6 +62,21 @@ public:
      */
     bool update();
 
+    /**
+     * Shot listening (split timer): any loud broadband impulse counts as
+     * a shot, timestamped at its first loud sample
+     */
+    void startShotListening();
+    void stopShotListening();
+    bool isShotListening() const { return shotListening; }
+    
+    /**
+     * Process pending audio while shot listening - call every loop pass
+     * @param shotUs  esp_timer time of the shot's onset
+     * @return true if a shot was detected
+     */
+    bool updateShots(int64_t& shotUs);
+    
     /**
      * Check if currently listening for beep
      */
@@ -118,9 +144,39 @@ public:
      * Adjust SNR threshold
      */
     void adjustSNRThreshold(float newSNR);
+    
+    /**
+     * DMA ring fill / overrun counters (headroom of the audio path)
+     */
+    MicAudioStats getAudioStats() const { return audioStats; }
+    
+    /**
+     * Per-bin Goertzel magnitudes of the last block (spectrogram view)
+     */
+    int getBinCount() const { return numFrequencies; }
+    const float* getBinMagnitudes() const { return binMagnitudes; }
+    float getBinFrequency(int bin) const { return targetFrequencies[bin]; }
+    uint32_t getBlockCount() const { return audioStats.blocksRead; }
+    void clearAudioPeak() { audioStats.peakFillPercent = audioStats.fillPercent; }
+    
+    /**
+     * Our own buzzer is about to play a tone (called by Buzzer from any
+     * task). Beep detection leaves the bins on that tone and its harmonics
+     * out for the tone plus the ring-down; shot detection notches it out.
+     */
+    void noteOwnTone(int64_t startUs, int64_t endUs, uint16_t frequency);
+    
+    void setRingDownMs(uint32_t ms);
+    uint32_t getRingDownMs() const { return ownTones.getRingDownUs() / 1000; }
+    
+    // Blocks processed with bins blanked / tones notched since last call
+    uint32_t getBlankedBlocks() const { return blankedBlocks; }
+    void resetBlankedBlocks() { blankedBlocks = 0; }
 
 private:
     bool listening;
+    bool shotListening;
+    int64_t lastShotUs;
     bool diagnosticMode;  // For BOOT button diagnostic mode
     float lastMagnitude;
     float detectionThreshold;
@@ -140,6 +196,31 @@ private:
     static constexpr i2s_port_t I2S_PORT = I2S_NUM_0;
     static constexpr int SAMPLE_RATE = 16000;  // 16kHz sample rate
     static constexpr int BLOCK_SIZE = 512;     // Samples per block
+    static constexpr int DMA_BUF_COUNT = 4;
+    static constexpr int DMA_BUF_LEN = 1024;   // Samples per DMA buffer
+    static constexpr int DMA_RING_BYTES = DMA_BUF_COUNT * DMA_BUF_LEN * sizeof(int32_t);
+    
+    // Driver events (RX_DONE per DMA buffer, RX_Q_OVF on overrun)
+    QueueHandle_t i2sEvents;
+    uint32_t pendingBytes;    // Filled by DMA, not yet read
+    MicAudioStats audioStats;
+    
+    // Own buzzer tones and the scratch block they are notched out of
+    ToneBlanker ownTones;
+    portMUX_TYPE ownTonesLock;
+    uint32_t blankedBlocks;
+    float notchBuffer[BLOCK_SIZE];
+    
+    // Block timestamps come from DMA buffer counts; a partly filled buffer
+    // is not counted, so a block can be up to one buffer older than computed
+    static constexpr int64_t BLOCK_TIME_SLACK_US = (int64_t)DMA_BUF_LEN * 1000000 / SAMPLE_RATE;
+    static constexpr uint32_t DEFAULT_RING_DOWN_MS = 30;
+    static constexpr float BLANK_HALF_WIDTH_HZ = 150.0;  // tone bin and its neighbours
+    
+    // Shot impulse: onset sample level (full scale = 1) and dead time for
+    // echoes and the tail of the report
+    static constexpr float SHOT_LEVEL = 0.5;
+    static constexpr int64_t SHOT_REFRACTORY_US = 150000;
     
     // Frequency detection range
     static constexpr float MIN_FREQ = 1400.0;  // Minimum frequency to detect
@@ -150,6 +231,7 @@ private:
     // Goertzel algorithm state for multiple frequencies
     float coefficients[MAX_FREQ_BINS];
     float targetFrequencies[MAX_FREQ_BINS];
+    float binMagnitudes[MAX_FREQ_BINS];
     int numFrequencies;
     int32_t audioBuffer[BLOCK_SIZE];
 
@@ -166,14 +248,32 @@ private:
     
     /**
      * Process block with all frequency filters
-     * Returns the peak magnitude and sets detectedFrequency
+     * Returns the peak magnitude over the bins not in blankMask and sets
+     * detectedFrequency (binMagnitudes keeps every bin)
      */
-    float processMultiFrequency(int32_t* samples, int numSamples);
+    float processMultiFrequency(int32_t* samples, int numSamples, uint32_t blankMask = 0);
+    
+    /**
+     * Time span [fromUs, toUs] the block just read was recorded in
+     */
+    void blockWindow(int samplesRead, int64_t readUs, int64_t& fromUs, int64_t& toUs) const;
 
     /**
      * Estimate noise floor from ambient audio
      */
     void estimateNoiseFloor();
+    
+    /**
+     * i2s_read into audioBuffer with DMA fill/overrun accounting
+     * @return bytes read (0 if no data)
+     */
+    size_t readBlock(TickType_t timeout);
+    
+    /**
+     * Drop driver events queued while nobody was reading - the ring
+     * overflows by design when idle and that is not an overrun
+     */
+    void discardAudioEvents();
 };
 
 // Global instance
@@ -0,0 +1,97 @@
+#ifndef PERF_MONITOR_H
+#define PERF_MONITOR_H
+
+#include <Arduino.h>
+
+// Timed sections of loop()
+enum PerfSection {
+    PERF_LEVEL,     // levelMonitor.update()
+    PERF_MIC,       // micDetector.update()
+    PERF_DISPLAY,   // one display frame (widgets + present + LED)
+    PERF_SECTION_COUNT
+};
+
+/**
+ * PerfMonitor - loop/section timing from the CPU cycle counter
+ *
+ * Sampling is a cycle counter read at the start and end of each section
+ * (a few cycles each), accumulated into per-window sums plus a ring of
+ * recent frame times for percentiles. Every REPORT_INTERVAL_MS the window
+ * is summarised; only then is anything formatted or drawn, so the overlay
+ * costs one small label repaint twice a second.
+ */
+class PerfMonitor {
+public:
+    PerfMonitor();
+
+    void begin();
+
+    static uint32_t stamp() { return ESP.getCycleCount(); }
+
+    /**
+     * Top of loop() - counts passes and the longest pass
+     */
+    void markLoop();
+
+    /**
+     * End of a section started at stamp()
+     */
+    void record(PerfSection section, uint32_t startCycles);
+
+    /**
+     * Call every loop pass - closes the window and feeds the overlay
+     */
+    void update();
+
+    /**
+     * On-screen overlay in the timer region (Display menu)
+     */
+    void setOverlay(bool on);
+    bool isOverlayOn() const { return overlayOn; }
+
+    /**
+     * Last window plus per-section averages to serial
+     */
+    void printReport() const;
+
+    static constexpr uint32_t REPORT_INTERVAL_MS = 500;
+    static constexpr int FRAME_SAMPLES = 128;  // ~2 s of frames at 58 fps
+
+private:
+    uint32_t cyclesPerUs;
+
+    // Current window
+    unsigned long windowStartMs;
+    uint32_t loopCount;
+    uint32_t lastLoopStamp;
+    uint32_t loopMaxCycles;
+    uint32_t sectionCycles[PERF_SECTION_COUNT];
+    uint32_t sectionCount[PERF_SECTION_COUNT];
+    uint32_t lastDisplayBytes;
+
+    // Recent display frame times (cycles)
+    uint32_t frameCycles[FRAME_SAMPLES];
+    int frameHead;
+    int frameCount;
+
+    // Summary of the last closed window
+    struct Summary {
+        uint32_t loopHz;
+        uint32_t loopMaxUs;
+        uint32_t frameP50Us;
+        uint32_t frameP99Us;
+        uint32_t displayBytesPerSec;
+        uint32_t sectionAvgUs[PERF_SECTION_COUNT];
+        uint32_t selfUs;     // cost of summarising + formatting the last window
+    } summary;
+
+    bool overlayOn;
+
+    void closeWindow(unsigned long nowMs);
+    uint32_t framePercentileUs(int percent) const;
+    void pushOverlay();
+};
+
+extern PerfMonitor perfMonitor;
+
+#endif
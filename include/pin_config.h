@@ -8,6 +8,8 @@
 #define LCD_CS        12   // LCD_CS - Chip Select
 #define LCD_RST       9    // LCD_RST - Reset
 #define LCD_BL        2   // LCD_BL - Backlight (14 did not work)
+#define LCD_BL_PWM_CHANNEL 0     // LEDC channel (timer 0) for the backlight
+#define LCD_BL_PWM_HZ      44100
 
 // ===== IMU PINS (QMI8658C) =====
 #define IIC_SDA       47
@@ -0,0 +1,174 @@
+#ifndef POWER_MANAGER_H
+#define POWER_MANAGER_H
+
+#include <Arduino.h>
+#include <SensorQMI8658.hpp>
+#include "inactivity_policy.h"
+#include "display_governor.h"
+#include "pin_config.h"
+
+// QMI8658 interrupt pin used for wake-on-motion (INT1 -> GPIO 8, RTC capable)
+#define IMU_WAKE_PIN  IMU_INT1
+
+/**
+ * PowerManager - inactivity sleep for the bench/idle case
+ *
+ * Wraps InactivityPolicy with the ESP32-S3 specifics: arms the QMI8658
+ * wake-on-motion engine, configures the encoder button and IMU interrupt
+ * as wake sources, and enters light or deep sleep. Light sleep keeps the
+ * panel contents (backlight off); deep sleep reboots through setup().
+ *
+ * While awake, the DisplayGovernor sets the main-screen frame rate and
+ * dims the backlight ahead of sleep; the same activity events feed both.
+ *
+ * Between frames the idle main screen naps: nap() light-sleeps until the
+ * next deadline (frame, wheel job, IMU sample, sleep policy) with the
+ * encoder, buttons and IMU interrupt as early wake sources. The backlight
+ * PWM runs from RC_FAST during naps, so the panel does not flicker.
+ */
+class PowerManager {
+public:
+    PowerManager();
+
+    void begin(SensorQMI8658* qmiPtr);
+
+    /**
+     * Call every loop pass. May block inside light sleep until a wake event.
+     */
+    void update();
+
+    /**
+     * Encoder, button or BOOT activity
+     */
+    void notifyActivity();
+
+    /**
+     * Inhibit sleep while the timer is armed/running or diagnostics are open
+     */
+    void setInhibited(bool inhibit);
+
+    /**
+     * Menu/timer state for the display governor - call before update()
+     */
+    void setDisplayActivity(const DisplayActivity& activity);
+
+    /**
+     * True when the main screen should render a frame this pass
+     */
+    bool frameDue() { return governor.frameDue(millis()); }
+
+    const DisplayGovernor& getGovernor() const { return governor; }
+
+    /**
+     * Idle path at the end of a loop pass: light sleep until the next
+     * deadline, or return at once when it is too close
+     * @param allowed  caller's check that nothing else needs the CPU
+     *                 (mic, buzzer, render queue, display DMA)
+     * @return true if it slept
+     */
+    bool nap(bool allowed);
+
+    void setNapEnabled(bool enable);
+    bool isNapEnabled() const { return napEnabled; }
+
+    /**
+     * Encoder edge handler - detached during a nap, run once on wake to
+     * pick up the edge that woke us
+     */
+    void setEncoderIsr(void (*isr)()) { encoderIsr = isr; }
+
+    /**
+     * Print nap count, time napped, wake latency and the estimated
+     * current saving, then restart the accounting
+     */
+    void printNapReport();
+
+    /**
+     * Print display mode, backlight duty cycle and time per mode, then
+     * restart the accounting
+     */
+    void printDisplayReport();
+
+    /**
+     * True if this boot is a wake from deep sleep (skip splash delays)
+     */
+    bool wokeFromDeepSleep() const;
+
+    /**
+     * Print wake-to-ready time and sleep statistics - call at end of setup()
+     */
+    void reportWake();
+
+    PowerState getState() const { return policy.getState(); }
+
+    // Inactivity timeouts
+    static constexpr uint32_t LIGHT_SLEEP_AFTER_MS = 2UL * 60UL * 1000UL;
+    static constexpr uint32_t DEEP_SLEEP_AFTER_MS = 10UL * 60UL * 1000UL;
+
+    // Backlight starts ramping down this long before light sleep is due
+    static constexpr uint32_t DIM_AFTER_MS = 30UL * 1000UL;
+
+    // Tilt change that counts as the user handling the rifle
+    static constexpr float MOTION_ACTIVITY_DEG = 1.0;
+
+    // Wake-on-motion threshold in mg (QMI8658 WoM register, 1 mg/LSB)
+    static constexpr uint8_t WOM_THRESHOLD_MG = 100;
+
+    // Estimated board current per state (mA) for the sleep report.
+    // Replace with bench measurements of the actual board when available.
+    static constexpr float EST_ACTIVE_MA = 95.0;
+    static constexpr float EST_LIGHT_SLEEP_MA = 3.5;
+    static constexpr float EST_DEEP_SLEEP_MA = 0.25;
+
+    // Backlight share of EST_ACTIVE_MA at full brightness
+    static constexpr float EST_BACKLIGHT_MA = 30.0;
+
+    // Shorter gaps are not worth the light sleep entry/exit
+    static constexpr uint32_t MIN_NAP_MS = 3;
+
+    // Level filter sample period while napping (its dt is capped at 100 ms)
+    static constexpr uint32_t IMU_SAMPLE_MS = 20;
+
+    // Wake latency budget: the first encoder edge must be picked up well
+    // before the next one (~5 ms apart at a fast spin). Naps switch off
+    // if a wake is ever slower.
+    static constexpr uint32_t MAX_WAKE_LATENCY_US = 1000;
+
+private:
+    InactivityPolicy policy;
+    DisplayGovernor governor;
+    DisplayActivity displayActivity;
+    int appliedBacklight;       // -1 = unknown, reapply on next update
+    SensorQMI8658* qmi;
+    float motionReferenceAngle;
+
+    // Time accounting for the current-draw estimate
+    unsigned long activeSinceMs;
+    uint64_t activeMs;
+    uint64_t lightSleepMs;
+
+    // Nap accounting since the last printNapReport()
+    bool napEnabled;
+    void (*encoderIsr)();
+    bool backlightOnRcFast;     // backlight LEDC timer keeps running in light sleep
+    uint32_t napCount;
+    uint32_t napGpioWakes;
+    uint64_t napUs;
+    uint64_t napLatencySumUs;
+    uint32_t napTimerWakes;
+    uint32_t napMaxLatencyUs;
+    unsigned long napStatsSinceMs;
+
+    bool armWakeOnMotion();
+    void armNapWake(int pin);
+    void keepBacklightInSleep();
+    void resetNapStats();
+    void restoreAfterSleep();
+    void enterLightSleep();
+    void enterDeepSleep();
+    void printCurrentEstimate(uint64_t deepSleepMs);
+};
+
+extern PowerManager powerManager;
+
+#endif
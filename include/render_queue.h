@@ -0,0 +1,110 @@
+#ifndef RENDER_QUEUE_H
+#define RENDER_QUEUE_H
+
+#include <LovyanGFX.hpp>
+
+/**
+ * RenderQueue - full-screen drawing spread over several loop passes
+ *
+ * Screens drawn straight to the panel (menu pages, SHOOTER READY) record
+ * their primitives here instead of calling the TFT. service() replays
+ * them against the panel until the per-pass time budget is used up and
+ * resumes on the next pass. Large fills are cut into row bands, so no
+ * single step costs more than ~0.6 ms of SPI time, and loop() keeps
+ * servicing the encoder, timer and mic while a screen builds up.
+ *
+ * Same call names as LovyanGFX for the subset the screens use. Text is
+ * formatted when queued. fillScreen() drops whatever is still pending,
+ * since it would be covered anyway.
+ */
+class RenderQueue {
+public:
+    RenderQueue();
+
+    void begin(lgfx::LovyanGFX* target);
+
+    // Drawing (recorded, replayed by service())
+    void fillScreen(uint16_t color);
+    void fillRect(int x, int y, int w, int h, uint16_t color);
+    void drawRect(int x, int y, int w, int h, uint16_t color);
+    void setCursor(int x, int y);
+    void setTextSize(int size);
+    void setTextColor(uint16_t color);
+    void print(const char* text);
+    void print(int value);
+    void print(float value, int decimals);
+    void println(const char* text);
+    void printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+
+    /**
+     * Replay queued steps until the budget is spent. Call every loop pass.
+     * @return true when nothing is pending
+     */
+    bool service();
+
+    /**
+     * Replay everything now (before a blocking delay that must show it)
+     */
+    void flush();
+
+    /**
+     * Drop pending steps - call when something else takes over the panel
+     */
+    void clear();
+
+    bool isIdle() const { return head == count; }
+
+    void setBudgetUs(uint32_t us) { budgetUs = us; }
+    uint32_t getBudgetUs() const { return budgetUs; }
+
+    // Longest service() call, steps replayed and overflow flushes
+    uint32_t getMaxSliceUs() const { return maxSliceUs; }
+    uint32_t getSteps() const { return steps; }
+    uint32_t getOverflows() const { return overflows; }
+    void resetStats();
+
+    static constexpr uint32_t DEFAULT_BUDGET_US = 2000;
+
+    // Rows per fill step: 170 x 16 px = 5.4 KB, ~0.55 ms at 80 MHz
+    static constexpr int FILL_BAND_ROWS = 16;
+
+    static constexpr int MAX_OPS = 96;
+    static constexpr int TEXT_POOL = 1024;
+
+private:
+    enum OpType : uint8_t {
+        OP_FILL_RECT,
+        OP_DRAW_RECT,
+        OP_CURSOR,
+        OP_TEXT_SIZE,
+        OP_TEXT_COLOR,
+        OP_PRINT,
+        OP_PRINTLN
+    };
+
+    struct Op {
+        OpType type;
+        int16_t x, y, w, h;
+        uint16_t value;         // colour, text size or text pool offset
+    };
+
+    lgfx::LovyanGFX* tft;
+    Op ops[MAX_OPS];
+    int head;                   // next op to replay
+    int count;                  // ops queued
+    char text[TEXT_POOL];
+    int textUsed;
+
+    uint32_t budgetUs;
+    uint32_t maxSliceUs;
+    uint32_t steps;
+    uint32_t overflows;
+
+    Op* push(OpType type);
+    void pushText(OpType type, const char* str);
+    bool runStep(Op& op);
+};
+
+extern RenderQueue renderQueue;
+
+#endif
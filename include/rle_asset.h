@@ -0,0 +1,35 @@
+#ifndef RLE_ASSET_H
+#define RLE_ASSET_H
+
+#include <LovyanGFX.hpp>
+
+/**
+ * RleAsset - palette run-length encoded image, generated at build time
+ *
+ * tools/build_assets.py converts the sources in assets/ into constexpr
+ * RleAssets in assets.h. Each token is one run of a palette colour
+ * (high nibble index, low nibble length, see the script for details),
+ * in row-major order across the whole image.
+ */
+struct RleAsset {
+    const char* name;
+    uint16_t width;
+    uint16_t height;
+    uint8_t paletteSize;
+    const uint16_t* palette;    // RGB565; 1-bit assets: {background, foreground}
+    const uint8_t* data;
+    uint32_t dataSize;
+};
+
+/**
+ * Stream an asset into one address window on a sprite or the panel.
+ * Each run becomes a single writeColor(), so nothing is expanded in RAM.
+ * The asset must lie fully inside the target (no clipping).
+ *
+ * @param palette  colours to use instead of the asset's own (e.g. the
+ *                 {bg, fg} pair for a 1-bit icon), or nullptr
+ */
+void drawRleAsset(lgfx::LovyanGFX& dst, int x, int y, const RleAsset& asset,
+                  const uint16_t* palette = nullptr);
+
+#endif
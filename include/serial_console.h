@@ -0,0 +1,55 @@
+#ifndef SERIAL_CONSOLE_H
+#define SERIAL_CONSOLE_H
+
+#include <Arduino.h>
+
+/**
+ * SerialConsole - line-based commands over USB serial
+ *
+ * Non-blocking: update() only consumes bytes already received and
+ * dispatches a command when a full line has arrived. Type "help" for
+ * the command list.
+ */
+class SerialConsole {
+public:
+    SerialConsole();
+
+    /**
+     * Call every loop pass
+     */
+    void update();
+
+    /**
+     * Take the next input as one JSON document instead of command lines:
+     * bytes are collected as they arrive until the outer braces close,
+     * then the handler gets the NUL-terminated text (it may modify it).
+     * Gives up after CAPTURE_TIMEOUT_MS without input.
+     */
+    void captureDocument(void (*handler)(char* text, size_t length));
+    bool isCapturing() const { return captureHandler != nullptr; }
+
+    static constexpr size_t MAX_DOCUMENT = 2048;
+    static constexpr unsigned long CAPTURE_TIMEOUT_MS = 10000;
+
+private:
+    static constexpr int MAX_LINE = 128;
+    char lineBuffer[MAX_LINE];
+    int lineLength;
+
+    // Document capture (JSON import)
+    void (*captureHandler)(char* text, size_t length);
+    char documentBuffer[MAX_DOCUMENT];
+    size_t documentLength;
+    int documentDepth;          // open braces/brackets
+    bool inString;
+    bool escaped;
+    unsigned long lastByteMs;
+
+    void dispatch(char* line);
+    void feedDocument(char c);
+    void endCapture();
+};
+
+extern SerialConsole console;
+
+#endif
@@ -2,32 +2,126 @@
 #define SETTINGS_H
 
 #include <Preferences.h>
+#include <stdint.h>
 
 // Level display modes
 enum LevelDisplayMode {
     LEVEL_DISPLAY_DEGREES,
-    LEVEL_DISPLAY_ARROW
+    LEVEL_DISPLAY_ARROW,
+    LEVEL_DISPLAY_BUBBLE,       // Analog vial at full frame rate
+    LEVEL_DISPLAY_MODE_COUNT
 };
 
-class Settings {
-public:
+const char* levelDisplayModeName(LevelDisplayMode mode);
+
+// Warnings sit at least this far under the value above them (par, yellow)
+#define WARNING_GAP_SECONDS 5
+#define YELLOW_WARNING_MIN  5
+#define RED_WARNING_MIN     1
+
+/**
+ * Upper bound for a warning: WARNING_GAP_SECONDS under the value above it,
+ * but never below the warning's own minimum (a short par would otherwise
+ * invert the range). Used by both the menu and the JSON import.
+ */
+int warningUpperBound(int aboveSeconds, int minSeconds);
+
+#define PROFILE_COUNT    4
+#define PROFILE_NAME_LEN 12     // including the terminator
+
+/**
+ * Flash images of the settings: one NVS blob for the device settings and
+ * one per profile slot, instead of a key per value. Fields are sized to
+ * their menu ranges; bump the version when a layout changes (older blobs
+ * are then ignored, unless load() knows how to migrate them).
+ */
+#define SETTINGS_BLOB_MAGIC   0x5354    // "ST"
+#define SETTINGS_BLOB_VERSION 2
+#define PROFILE_BLOB_MAGIC    0x5250    // "PR"
+#define PROFILE_BLOB_VERSION  1
+
+struct __attribute__((packed)) BlobHeader {
+    uint16_t magic;
+    uint8_t version;
+    uint8_t size;               // sizeof the whole blob
+};
+
+struct __attribute__((packed)) SettingsBlob {
+    BlobHeader header;
+
+    uint8_t levelDisplayMode;
+    uint8_t displayBrightness;
+    uint8_t ledBrightness;
+    uint8_t buzzerVolume;
+    uint8_t timerFineDigits;
+    uint8_t activeProfile;
+
+    uint32_t crc;               // CRC-32 of everything above
+};
+
+// First blob layout (one profile, no name) - read once to migrate
+#define SETTINGS_BLOB_V1 1
+
+struct __attribute__((packed)) SettingsBlobV1 {
+    BlobHeader header;
+
+    float tolerance;
+    uint8_t levelDisplayMode;
+    uint8_t displayBrightness;
+    uint8_t ledBrightness;
+    uint8_t buzzerVolume;
+    uint16_t parTimeSeconds;
+    uint16_t yellowWarningSeconds;
+    uint16_t redWarningSeconds;
+    uint8_t timerFineDigits;
+    uint8_t stageShots;
+    float micThreshold;
+
+    float gravityX;
+    float gravityY;
+    float gravityZ;
+    float gravityMagnitude;
+    uint8_t isCalibrated;
+
+    uint32_t crc;
+};
+
+struct __attribute__((packed)) ProfileBlob {
+    BlobHeader header;
+
+    char name[PROFILE_NAME_LEN];
+    float gravityX;
+    float gravityY;
+    float gravityZ;
+    float gravityMagnitude;
+    uint8_t isCalibrated;
+    float tolerance;
+    uint16_t parTimeSeconds;
+    uint16_t yellowWarningSeconds;
+    uint16_t redWarningSeconds;
+    uint8_t stageShots;
+    float micThreshold;
+
+    uint32_t crc;
+};
+
+/**
+ * One rifle / range / beeper setup. Everything that changes with the
+ * gun or the match lives here; device preferences stay in Settings.
+ */
+struct SettingsProfile {
+    char name[PROFILE_NAME_LEN];
+
     // Level settings
     float tolerance;
     // Note: Hysteresis is calculated in level_monitor as 10% of tolerance
-    LevelDisplayMode levelDisplayMode;  // NEW: Display mode (degrees or arrow)
-    
-    // Display settings
-    int displayBrightness;
-    int ledBrightness;
-    
+
     // Timer settings
     int parTimeSeconds;
     int yellowWarningSeconds;
     int redWarningSeconds;
-    
-    // Buzzer settings
-    int buzzerVolume;
-    
+    int stageShots;            // Split timer: shots per stage, 0 = off (countdown only)
+
     // Microphone settings
     float micThreshold;
 
@@ -39,17 +133,102 @@ public:
         float magnitude;
         bool isCalibrated;
     } gravity;
+};
+
+class Settings {
+public:
+    LevelDisplayMode levelDisplayMode;  // NEW: Display mode (degrees or arrow)
+    
+    // Display settings
+    int displayBrightness;
+    int ledBrightness;
+    int timerFineDigits;       // Sub-second digits in the last seconds: 0 off, 1 tenths, 2 hundredths
+    
+    // Buzzer settings
+    int buzzerVolume;
+
+    // Active profile (calibration, tolerance, timer, mic threshold)
+    SettingsProfile* profile;
     
     Settings();
+
+    /**
+     * Read the stored blobs (one NVS read each); falls back to defaults
+     * when one is missing or fails its check, and migrates the old
+     * key-per-value layout or a v1 blob once
+     */
     void load();
+
+    /**
+     * Note a change - blobs are written SAVE_DELAY_MS after the last
+     * call, and only those with a field that differs from flash
+     */
     void save();
-    void saveCalibration();
-    
+
+    /**
+     * Write now if anything changed (menu exit, before deep sleep)
+     */
+    void flush();
+
+    void saveCalibration();     // Calibration is written at once
+
+    /**
+     * Make a slot the active profile - a pointer swap; the choice is
+     * written with the next debounced save
+     * @return false for a slot out of range
+     */
+    bool selectProfile(int slot);
+    int getProfileIndex() const { return (int)(profile - profiles); }
+    SettingsProfile& getProfile(int slot) { return profiles[slot]; }
+
+    /**
+     * Fields of the device blob that differ from flash (bit per field)
+     */
+    uint32_t dirtyFields() const;
+
+    /**
+     * Profile slots that differ from flash (bit per slot)
+     */
+    uint32_t dirtyProfiles() const;
+
+    /**
+     * Blob sizes, NVS operations and load/write times
+     */
+    void printReport();
+
+    static constexpr uint32_t SAVE_DELAY_MS = 2000;
+
 private:
     Preferences preferences;
+    SettingsProfile profiles[PROFILE_COUNT];
+
+    // Exactly what flash holds (valid after load)
+    SettingsBlob stored;
+    ProfileBlob storedProfiles[PROFILE_COUNT];
+
+    // Measurements
+    uint32_t loadUs;
+    uint32_t loadOps;           // NVS operations at boot
+    uint32_t legacyReads;       // of those, per-key reads of a migration (0 = none)
+    uint32_t lastWriteUs;
+    uint32_t writes;            // Blob writes
+    uint32_t saveRequests;      // save() calls - each used to rewrite every key
+    uint32_t unchangedSaves;    // save() calls that changed nothing
+    uint32_t lastWriteFields;   // Device fields in the last flush (bit per field)
+    uint32_t lastWriteProfiles; // Profile slots in the last flush (bit per slot)
+
+    void pack(SettingsBlob& blob) const;
+    void unpack(const SettingsBlob& blob);
+    static void packProfile(const SettingsProfile& p, ProfileBlob& blob);
+    static void unpackProfile(const ProfileBlob& blob, SettingsProfile& p);
+    bool loadLegacy();
+    void unpackV1(const SettingsBlobV1& blob);
+    int legacyInt(const char* key, int fallback);
+    float legacyFloat(const char* key, float fallback);
+    bool legacyBool(const char* key, bool fallback);
 };
 
 // Global settings instance
 extern Settings settings;
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,25 @@
+#ifndef SETTINGS_JSON_H
+#define SETTINGS_JSON_H
+
+#include <Arduino.h>
+
+// Settings as JSON for cloning a tuned unit: device preferences, the
+// active slot and every profile with its calibration. Both directions go
+// through one static ArduinoJson document - no heap, and nothing large
+// on the loop stack.
+
+#define SETTINGS_JSON_VERSION 1
+
+// Serialize straight into the stream (no intermediate string)
+void exportSettingsJson(Print& out);
+
+/**
+ * Apply a document in place (zero-copy parse; the text is modified).
+ * Keys that are missing keep their current value and numbers are held
+ * to the menu ranges. Nothing is applied if the text does not parse.
+ * @param keepCalibration  leave this unit's gravity calibrations alone
+ * @return false with the reason on Serial
+ */
+bool importSettingsJson(char* json, size_t length, bool keepCalibration);
+
+#endif
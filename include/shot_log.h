@@ -0,0 +1,122 @@
+#ifndef SHOT_LOG_H
+#define SHOT_LOG_H
+
+#include <stdint.h>
+
+// What detected a shot
+enum ShotSource : uint8_t {
+    SHOT_MIC,       // Report picked up by the microphone
+    SHOT_IMU        // Recoil seen by the accelerometer
+};
+
+struct ShotRecord {
+    uint32_t atUs;          // Since the start of the stage
+    ShotSource source;
+};
+
+// Result of one finished stage
+struct StageSummary {
+    uint16_t stage;         // Running stage number since boot
+    uint16_t shots;
+    uint16_t expected;      // Shots planned for the stage
+    uint32_t firstShotUs;   // Draw/first shot time (0 = no shots)
+    uint32_t fastestSplitUs;// 0 = fewer than two shots
+    uint32_t averageSplitUs;
+    uint32_t lastShotUs;
+};
+
+/**
+ * ShotLog - splits of the current stage and summaries of the last stages
+ *
+ * Shots go into a fixed ring (no allocation); when a stage has more shots
+ * than MAX_SHOTS the oldest splits are dropped, but the counters keep
+ * covering every shot. First shot, fastest and average split and shots
+ * remaining are updated per shot, so the display reads them without
+ * rescanning the ring.
+ *
+ * Mic and IMU usually both report the same shot; a second report within
+ * MERGE_US of the previous shot is dropped.
+ *
+ * Pure logic with no Arduino dependencies. The serial dump (`shots`)
+ * walks the ring with get() and the summaries with getSummary().
+ *
+ * Binary dump layout (little endian):
+ *   "SPL" version(1) stage(u16) expected(u16) shots(u16) stored(u16)
+ *   then per stored shot: atUs(u32) source(u8)
+ */
+class ShotLog {
+public:
+    ShotLog();
+
+    /**
+     * Start a stage (drops the previous splits)
+     * @param expectedShots  planned shots, for shots remaining (0 = open)
+     */
+    void beginStage(uint16_t expectedShots);
+
+    /**
+     * Close the stage and keep its summary (no-op if no stage is open)
+     */
+    void endStage();
+
+    bool isOpen() const { return open; }
+
+    /**
+     * @return false if merged into the previous shot or no stage is open
+     */
+    bool record(uint32_t atUs, ShotSource source);
+
+    // Current (or last closed) stage
+    uint16_t getStage() const { return stage; }
+    uint16_t getShots() const { return shots; }
+    uint16_t getExpected() const { return expected; }
+    int getShotsRemaining() const { return shots >= expected ? 0 : expected - shots; }
+    uint32_t getFirstShotUs() const { return firstShotUs; }
+    uint32_t getFastestSplitUs() const { return fastestSplitUs; }
+    uint32_t getAverageSplitUs() const;
+    uint32_t getLastShotUs() const { return lastShotUs; }
+
+    // Splits still in the ring, oldest first
+    int getStored() const { return stored; }
+    const ShotRecord& get(int index) const;
+
+    // Finished stages, most recent first
+    int getSummaryCount() const { return summaryCount; }
+    const StageSummary& getSummary(int index) const;
+
+    /**
+     * Header of the binary dump
+     * @return bytes written (BINARY_HEADER_BYTES)
+     */
+    int writeBinaryHeader(uint8_t* out) const;
+    static void packRecord(const ShotRecord& r, uint8_t* out);
+
+    static constexpr int MAX_SHOTS = 64;
+    static constexpr int MAX_SUMMARIES = 8;
+    static constexpr uint32_t MERGE_US = 100000;
+
+    static constexpr int BINARY_HEADER_BYTES = 12;
+    static constexpr int BINARY_RECORD_BYTES = 5;
+    static constexpr uint8_t BINARY_VERSION = 1;
+
+private:
+    ShotRecord ring[MAX_SHOTS];
+    int head;               // next slot to write
+    int stored;
+
+    bool open;
+    uint16_t stage;
+    uint16_t shots;
+    uint16_t expected;
+    uint32_t firstShotUs;
+    uint32_t fastestSplitUs;
+    uint32_t lastShotUs;
+
+    StageSummary summaries[MAX_SUMMARIES];
+    int summaryHead;
+    int summaryCount;
+};
+
+extern ShotLog shotLog;
+
+#endif
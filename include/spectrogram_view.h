@@ -0,0 +1,68 @@
+#ifndef SPECTROGRAM_VIEW_H
+#define SPECTROGRAM_VIEW_H
+
+#include "display_manager.h"
+
+/**
+ * SpectrogramView - scrolling waterfall of the mic Goertzel bins
+ *
+ * Mic diagnostic screen. Every audio block (512 samples, ~31/s) becomes
+ * one 170 px row: one column band per bin, coloured by magnitude relative
+ * to the detection threshold. Rows go into the ST7789 vertical scroll
+ * area and the scroll start register is advanced by one line, so a new
+ * block costs a single pixel row (340 bytes) instead of a redraw.
+ *
+ * The header (title, frequency axis) and footer (peak/threshold text) are
+ * fixed areas that do not scroll. Assumes the portrait rotation 0 panel
+ * setup from DisplayManager (scrolling runs along the 320 px axis).
+ */
+class SpectrogramView {
+public:
+    SpectrogramView();
+
+    void begin(LGFX* tftPtr);
+
+    /**
+     * Take over the panel: draw the fixed areas and enable scrolling
+     */
+    void start();
+
+    /**
+     * Restore the normal (unscrolled) panel mapping
+     */
+    void stop();
+
+    /**
+     * Call every loop pass while active - pushes one row per new block
+     */
+    void update();
+
+    bool isActive() const { return active; }
+
+    // Panel split (rows): fixed header, scrolling waterfall, fixed footer
+    static constexpr int HEADER_ROWS = 40;
+    static constexpr int SCROLL_ROWS = 240;
+    static constexpr int FOOTER_ROWS = 320 - HEADER_ROWS - SCROLL_ROWS;
+
+private:
+    LGFX* tft;
+    bool active;
+    int scrollLine;               // next row to write, 0..SCROLL_ROWS-1
+    uint32_t lastBlock;
+    unsigned long lastFooterUpdate;
+
+    static constexpr int PALETTE_SIZE = 64;
+    uint16_t palette[PALETTE_SIZE];   // RGB565, panel byte order
+    uint16_t row[170];
+
+    void buildPalette();
+    void drawHeader();
+    void drawFooter();
+    void pushRow();
+    void setScrollArea(uint16_t top, uint16_t height, uint16_t bottom);
+    void setScrollStart(uint16_t line);
+};
+
+extern SpectrogramView spectrogram;
+
+#endif
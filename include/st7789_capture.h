@@ -0,0 +1,110 @@
+#ifndef ST7789_CAPTURE_H
+#define ST7789_CAPTURE_H
+
+#include <stdint.h>
+
+// Bytes the panel driver would have clocked out over SPI
+struct CaptureStats {
+    uint32_t commands;      // command bytes (D/C low)
+    uint32_t paramBytes;    // command parameters (CASET, RASET, ...)
+    uint32_t pixelBytes;    // RAMWR payload
+    uint32_t pixels;        // pixels written to controller RAM
+    uint32_t windows;       // RAMWR commands (one per draw call / push)
+};
+
+/**
+ * St7789Capture - ST7789 controller model fed with the raw command stream
+ *
+ * Decodes what the panel driver sends (CASET/RASET/RAMWR, vertical scroll,
+ * partial and idle mode, sleep and display on/off) into a 240x320 RGB565 copy of controller RAM,
+ * and counts every byte. Bus_Capture feeds it in the headless LGFX build
+ * (native_display env), so the real Panel_ST7789 driver and the
+ * DisplayManager/MenuSystem drawing run unchanged on the PC while the
+ * result lands in memory.
+ *
+ * Plain C++ - no Arduino or LovyanGFX dependency. Assumes MADCTL for
+ * rotation 0 and 16-bit COLMOD, which is what DisplayManager sets up.
+ */
+class St7789Capture {
+public:
+    // Controller RAM
+    static constexpr int RAM_W = 240;
+    static constexpr int RAM_H = 320;
+
+    /**
+     * @param viewX  first RAM column visible on the glass (panel offset_x)
+     * @param viewW  visible width
+     */
+    St7789Capture(int viewX = 35, int viewW = 170);
+    ~St7789Capture();
+
+    /**
+     * Power-on state: RAM black, no scroll, display on
+     */
+    void reset();
+
+    // Bus input
+    void command(uint8_t cmd);
+    void data(const uint8_t* bytes, uint32_t length);
+    void dataRepeat(const uint8_t* pattern, uint8_t patternBytes, uint32_t count);
+
+    /**
+     * Pixel as seen on the glass (view coordinates, scroll applied),
+     * RGB565 in host byte order. Black while asleep or display off and
+     * outside the partial area; reduced to 8 colours in idle mode.
+     */
+    uint16_t viewPixel(int x, int y) const;
+
+    /**
+     * FNV-1a over a view rectangle - compact value to compare screens by
+     */
+    uint32_t viewHash(int x, int y, int w, int h) const;
+
+    const CaptureStats& getStats() const { return stats; }
+    void resetStats();
+    uint32_t totalBytes() const { return stats.commands + stats.paramBytes + stats.pixelBytes; }
+
+    bool isSleeping() const { return sleeping; }
+    bool isDisplayOn() const { return displayOn; }
+    bool isPartialMode() const { return partialMode; }
+    bool isIdleMode() const { return idleMode; }
+
+    int viewWidth() const { return viewW; }
+    int viewHeight() const { return RAM_H; }
+
+private:
+    uint16_t* ram;
+    int viewX;
+    int viewW;
+
+    uint8_t currentCommand;
+    uint8_t params[8];
+    int paramCount;
+
+    // Address window and write pointer
+    uint16_t colStart, colEnd, rowStart, rowEnd;
+    uint16_t curCol, curRow;
+    bool pixelWrite;
+    bool haveHighByte;
+    uint8_t highByte;
+
+    // Vertical scrolling (VSCRDEF / VSCSAD)
+    uint16_t topFixed, scrollArea, bottomFixed;
+    uint16_t scrollStart;
+
+    // Partial display (PTLAR / PTLON / NORON) and 8-colour idle mode
+    uint16_t partialStart, partialEnd;
+    bool partialMode;
+    bool idleMode;
+
+    bool sleeping;
+    bool displayOn;
+
+    CaptureStats stats;
+
+    void parameter(uint8_t value);
+    void pixelByte(uint8_t value);
+    int ramRowForView(int y) const;
+};
+
+#endif
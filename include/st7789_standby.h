@@ -0,0 +1,44 @@
+#ifndef ST7789_STANDBY_H
+#define ST7789_STANDBY_H
+
+#include <stdint.h>
+
+// ST7789 partial and idle modes (standby)
+#define ST7789_PTLON   0x12  // Partial display mode on
+#define ST7789_NORON   0x13  // Normal display mode on (partial off)
+#define ST7789_PTLAR   0x30  // Partial area: start row, end row
+#define ST7789_IDMOFF  0x38  // Idle mode off (full colour)
+#define ST7789_IDMON   0x39  // Idle mode on (8 colours)
+
+/**
+ * Standby command streams for DisplayManager::setStandby. Panel is
+ * anything with byte writeCommand()/writeData() - LGFX between
+ * startWrite()/endWrite().
+ */
+
+/**
+ * Keep only the top 'rows' lines lit (partial mode) and drop to 8 colours
+ * (idle mode). Controller RAM keeps everything below.
+ */
+template <typename Panel>
+void writeStandbyOn(Panel& panel, uint16_t rows) {
+    uint16_t endRow = rows - 1;
+    panel.writeCommand(ST7789_PTLAR);
+    panel.writeData(0);
+    panel.writeData(0);
+    panel.writeData(endRow >> 8);
+    panel.writeData(endRow & 0xFF);
+    panel.writeCommand(ST7789_PTLON);
+    panel.writeCommand(ST7789_IDMON);
+}
+
+/**
+ * Full colour, whole panel - shows controller RAM as it was
+ */
+template <typename Panel>
+void writeStandbyOff(Panel& panel) {
+    panel.writeCommand(ST7789_IDMOFF);
+    panel.writeCommand(ST7789_NORON);
+}
+
+#endif
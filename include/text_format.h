@@ -0,0 +1,24 @@
+#ifndef TEXT_FORMAT_H
+#define TEXT_FORMAT_H
+
+#include <stdint.h>
+
+// Allocation-free formatters for the large readouts. No printf, no float
+// formatting - these run every frame. Both write a NUL-terminated string
+// and return its length.
+
+// Plain integer ("-12", "30")
+int formatInt(char* out, int value);
+
+// "M:SS" from whole seconds (negative clamps to 0:00)
+int formatTime(char* out, int totalSeconds);
+
+// Last seconds of a stage: "9.4" (digits = 1) or "9.43" (digits = 2).
+// Truncates, so the readout never shows more time than is left.
+int formatFineTime(char* out, uint32_t remainingMs, int digits);
+
+// Level angle: one decimal below 10 degrees ("4.5", "-0.3"), whole degrees
+// from 10 up ("12", "-134"). Buffer needs at least 8 chars.
+int formatAngle(char* out, float angle);
+
+#endif
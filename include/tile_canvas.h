@@ -0,0 +1,182 @@
+#ifndef TILE_CANVAS_H
+#define TILE_CANVAS_H
+
+#include <LovyanGFX.hpp>
+
+/**
+ * TileCanvas - off-screen sprite for one screen region with tile diffing
+ *
+ * Drawing goes into an off-screen sprite instead of the panel. present()
+ * hashes the sprite tile by tile, compares against the hashes of the
+ * previous frame and pushes only the tiles that changed. Nothing is
+ * erased on the panel, so there is no flicker, and an unchanged frame
+ * costs zero SPI traffic.
+ *
+ * In async mode present() only marks the changed tiles. service() then
+ * feeds them to the SPI DMA as runs of adjacent tiles, one run per call
+ * and only when the DMA is idle, so the caller never waits on the bus.
+ *
+ * Whoever draws into canvas() reports the touched area with addDamage()
+ * (widgets do this when they paint). present() then only hashes tiles
+ * under a damage rect and pushes just the damaged columns of a changed
+ * tile, so a progress bar moving by one pixel costs a 1 px wide push.
+ *
+ * The sprite can also be palette indexed (8 or 4 bpp) to cut its RAM to
+ * a half or a quarter. Drawing code then passes color(rgb565), which
+ * hands out palette slots on first use, and rows are expanded back to
+ * RGB565 through a lookup table as they are pushed.
+ */
+class TileCanvas {
+public:
+    TileCanvas(int x, int y, int width, int height);
+
+    /**
+     * Allocate the sprite
+     * @param bpp  16 (RGB565), 8 or 4 (palette indexed)
+     * @return true if the buffer could be allocated
+     */
+    bool begin(lgfx::LGFX_Device* tftPtr, int bpp = 16);
+
+    /**
+     * Reallocate the sprite at another depth. Contents are lost (black)
+     * and the next present() pushes every tile.
+     * @return false if the new sprite could not be allocated (the old
+     *         depth is restored)
+     */
+    bool setColorDepth(int bpp);
+    int getColorDepth() const { return depth; }
+    bool isIndexed() const { return depth < 16; }
+
+    /**
+     * Drawing surface in region-local coordinates
+     */
+    LGFX_Sprite& canvas() { return sprite; }
+
+    /**
+     * Colour value to draw with: the RGB565 value itself on a 16 bpp
+     * canvas, its palette index otherwise. A full palette maps to the
+     * nearest existing entry.
+     */
+    uint16_t color(uint16_t rgb565);
+
+    int paletteUsed() const { return paletteCount; }
+    uint32_t spriteBytes() const { return (uint32_t)rowBytes() * regionHeight; }
+
+    /**
+     * Forget the previous frame - next present() pushes every tile.
+     * Call when something else has drawn over this region of the panel.
+     */
+    void invalidate() { forceFull = true; }
+
+    /**
+     * Report a drawn rectangle (region-local). Pixels changed outside all
+     * damage rects are not picked up until the next invalidate().
+     */
+    void addDamage(int x, int y, int w, int h);
+
+    /**
+     * Push changed tiles to the panel (sync) or queue them (async)
+     * @return bytes sent or queued (pixel data + address window commands)
+     */
+    uint32_t present();
+
+    /**
+     * Async mode: start the next DMA run if the bus is idle. Never blocks.
+     * @return true when nothing is left to send
+     */
+    bool service();
+
+    /**
+     * Drop queued tiles and wait for in-flight DMA - call before drawing
+     * directly over this region
+     */
+    void discardPending();
+
+    /**
+     * Switch between blocking pushImage and queued pushImageDMA.
+     * Async needs two DMA-capable staging strips (~5KB each).
+     */
+    bool setAsync(bool enable);
+    bool isAsync() const { return asyncMode; }
+
+    int getX() const { return originX; }
+    int getY() const { return originY; }
+    int width() const { return regionWidth; }
+    int height() const { return regionHeight; }
+
+    // 170 px panel width splits into 10 tiles of 17 px
+    static constexpr int TILE_W = 17;
+    static constexpr int TILE_H = 16;
+
+    // CASET + RASET + RAMWR for every tile pushed
+    static constexpr int ADDR_WINDOW_BYTES = 11;
+
+    // Damage rects kept per frame before collapsing to their bounding box
+    static constexpr int MAX_DAMAGE = 8;
+
+private:
+    LGFX_Sprite sprite;
+    lgfx::LGFX_Device* tft;
+    int depth;
+
+    // Indexed depths: RGB565 per slot (lookup) and in panel byte order (push)
+    static constexpr int MAX_PALETTE = 256;
+    uint16_t* paletteColors;
+    uint16_t* paletteSwapped;
+    int paletteCount;
+
+    int originX;
+    int originY;
+    int regionWidth;
+    int regionHeight;
+    int tilesX;
+    int tilesY;
+
+    uint32_t* tileHashes;
+    bool forceFull;
+
+    struct Rect {
+        int x, y, w, h;
+    };
+    Rect damage[MAX_DAMAGE];
+    int damageCount;
+
+    // Damaged column span per queued tile, tile-local [start, end)
+    uint8_t* spanStart;
+    uint8_t* spanEnd;
+
+    // Staging copy of one tile (sprite rows are not contiguous per tile)
+    uint16_t tileBuffer[TILE_W * TILE_H];
+
+    // Async path: dirty tiles waiting for DMA, double-buffered staging
+    enum StagingState {
+        STAGING_FREE,       // may be written
+        STAGING_READY,      // holds a run, not yet handed to DMA
+        STAGING_IN_FLIGHT   // owned by DMA - must not be touched
+    };
+
+    struct Staging {
+        uint16_t* pixels;
+        StagingState state;
+        int x, y, w, h;
+    };
+
+    bool asyncMode;
+    bool* tileDirty;
+    int pendingTiles;
+    int cursorRow;
+    Staging staging[2];
+    int nextStaging;
+
+    int rowBytes() const { return (regionWidth * depth + 7) / 8; }
+    bool allocateSprite(int bpp);
+    void resetPalette();
+    void copyRow(uint16_t* dst, int x, int y, int w) const;
+    uint32_t hashTile(int tx, int ty, int w, int h) const;
+    bool damagedSpan(int tx, int ty, int w, int h, int& x0, int& x1) const;
+    void pushTile(int tx, int ty, int w, int h);
+    void retireStaging();
+    bool prepareNextRun(Staging& s);
+};
+
+#endif
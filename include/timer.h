@@ -2,6 +2,9 @@
 #define TIMER_H
 
 #include <Arduino.h>
+#include <esp_timer.h>
+#include "countdown_schedule.h"
+#include "shot_log.h"
 
 enum TimerState {
     TIMER_IDLE,
@@ -10,29 +13,72 @@ enum TimerState {
     TIMER_FINISHED
 };
 
+/**
+ * CountdownTimer - countdown driven by a one-shot esp_timer
+ *
+ * start() turns the par time and warnings into deadlines (CountdownSchedule)
+ * and arms an esp_timer for the earliest one. The timer callback runs in
+ * the high-priority esp_timer task, fires the warning beeps or the finish
+ * alarm and switches to TIMER_FINISHED at the deadline, however busy
+ * loop() is. The display and the rest of the loop only read the state.
+ *
+ * With Shots set in the Timer menu the run is also a split timer stage:
+ * shots reported by the mic or IMU go into shotLog relative to the start.
+ */
 class CountdownTimer {
 public:
     CountdownTimer();
-    
+
+    void begin();   // Create the deadline timer
+
     void setReady();
     void start();
     void reset();
-    void update();
-    
+    void update();  // Loop side: logs fired events, flags redraws
+
     TimerState getState() const { return state; }
     int getRemainingSeconds() const;
-    float getPercentRemaining() const;
+    uint32_t getRemainingMs() const;     // Millisecond resolution for sub-second display
+    float getPercentRemaining() const;   // Continuous (ms based) for a smooth bar
     uint16_t getTimerColor() const;
-    
+
+    // Split timer: true when this run logs shots
+    bool isSplitMode() const { return splitMode; }
+
+    /**
+     * Log a detected shot of the running stage
+     * @param atUs  esp_timer time of the shot
+     * @return false if not running, before the start or merged
+     */
+    bool recordShot(int64_t atUs, ShotSource source);
+
     bool needsRedraw() const { return redrawNeeded; }
     void clearRedrawFlag() { redrawNeeded = false; }
-    
+
+    // Latest a deadline event fired after its deadline (since last call)
+    uint32_t getMaxLatenessUs() const { return maxLatenessUs; }
+    void resetStats() { maxLatenessUs = 0; }
+
 private:
-    TimerState state;
-    unsigned long startMillis;
+    volatile TimerState state;
     bool redrawNeeded;
+    bool splitMode;
+    int64_t startUs;
+
+    CountdownSchedule schedule;
+    esp_timer_handle_t deadlineTimer;
+    mutable portMUX_TYPE lock;
+
+    // Fired in the timer task, logged by update()
+    volatile uint8_t unloggedEvents;
+    volatile uint32_t maxLatenessUs;
+
+    static void onDeadline(void* arg);
+    void fireDue();
+    void armNextDeadline();
+    void endStage();
 };
 
 extern CountdownTimer timer;
 
-#endif
\ No newline at end of file
+#endif
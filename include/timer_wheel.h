@@ -0,0 +1,119 @@
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <stdint.h>
+
+/**
+ * WheelJob - one periodic or one-shot job on a TimerWheel
+ *
+ * Owned by the caller (usually a static), the wheel only links it into
+ * its slot lists, so scheduling never allocates.
+ */
+class WheelJob {
+public:
+    typedef void (*Callback)(void* arg);
+
+    WheelJob(Callback callback, void* arg = nullptr);
+
+    bool isPending() const { return pending; }
+    uint32_t getExpiresMs() const { return expiresMs; }
+
+private:
+    friend class TimerWheel;
+
+    Callback callback;
+    void* arg;
+    uint32_t expiresMs;
+    uint32_t periodMs;      // 0 = one-shot
+
+    // Intrusive slot list
+    WheelJob* next;
+    WheelJob* prev;
+    uint8_t level;
+    uint8_t slot;
+    bool pending;
+};
+
+/**
+ * TimerWheel - hierarchical timer wheel for the loop's periodic and
+ * one-shot jobs (1 ms ticks)
+ *
+ * Four levels of 64 slots cover 64 ms, 4 s, 4.4 min and 4.6 h. A job is
+ * linked into the slot of the level that matches its distance, so
+ * schedule() and cancel() are O(1); when the lowest level wraps, the next
+ * slot of the level above is cascaded down. Each level keeps a bitmap of
+ * occupied slots, so advance() skips empty stretches and nextDeadline()
+ * needs no list walk.
+ *
+ * Periodic jobs stay on their original grid: a job that fires late is
+ * rescheduled from its deadline, not from the time it ran, and periods
+ * missed entirely are dropped rather than run back to back.
+ *
+ * Pure logic with no Arduino dependencies. Times are millis() style
+ * millisecond timestamps (wraparound safe), so it can be driven by a
+ * virtual clock. Callbacks run inside advance() and may schedule or
+ * cancel any job, including their own.
+ */
+class TimerWheel {
+public:
+    TimerWheel();
+
+    /**
+     * Start the wheel at the current time (drops every job; dropped jobs
+     * are no longer pending and can be scheduled again)
+     */
+    void begin(uint32_t nowMs);
+
+    /**
+     * Run the job delayMs after the last advance() (reschedules if pending)
+     * @param periodMs  repeat interval (0 = one-shot)
+     */
+    void schedule(WheelJob& job, uint32_t delayMs, uint32_t periodMs = 0);
+    void cancel(WheelJob& job);
+
+    /**
+     * Fire every job due at or before nowMs, in deadline order
+     * @return number of jobs run
+     */
+    int advance(uint32_t nowMs);
+
+    /**
+     * Time from nowMs until the wheel next has work
+     * Exact for jobs under 64 ms away, otherwise the start of the slot
+     * that holds the job (never later than the job)
+     * @return false when no job is pending
+     */
+    bool nextDeadline(uint32_t nowMs, uint32_t& delayMs) const;
+
+    int getPending() const { return pendingCount; }
+
+    // Worst lateness of a job (advance time - deadline) since last call
+    uint32_t getMaxLatenessMs() const { return maxLatenessMs; }
+    uint32_t getMissedPeriods() const { return missedPeriods; }
+    void resetStats();
+
+    static constexpr int LEVEL_BITS = 6;
+    static constexpr int SLOTS = 1 << LEVEL_BITS;
+    static constexpr int LEVELS = 4;
+    static constexpr uint32_t MAX_DELAY_MS = (1UL << (LEVEL_BITS * LEVELS)) - 1;
+
+private:
+    WheelJob* slots[LEVELS][SLOTS];
+    uint64_t occupied[LEVELS];      // bit per non-empty slot
+    WheelJob* running;              // jobs of the tick being fired
+    uint32_t currentMs;             // next tick to process
+    int pendingCount;
+
+    uint32_t maxLatenessMs;
+    uint32_t missedPeriods;
+
+    void link(WheelJob& job);
+    void unlink(WheelJob& job);
+    void cascade(int level, int index);
+    static void detachAll(WheelJob*& head);
+    int runTick(uint32_t nowMs);
+};
+
+extern TimerWheel scheduler;
+
+#endif
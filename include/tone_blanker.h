@@ -0,0 +1,76 @@
+#ifndef TONE_BLANKER_H
+#define TONE_BLANKER_H
+
+#include <stdint.h>
+
+// One tone played by our own buzzer
+struct OwnTone {
+    int64_t startUs;
+    int64_t endUs;
+    uint16_t frequency;
+};
+
+/**
+ * ToneBlanker - keeps the mic from hearing our own buzzer
+ *
+ * The buzzer reports every tone step it plays (exact start, end and
+ * frequency). For an audio block the detector asks which of its
+ * Goertzel bins sit on one of those tones or their harmonics while the
+ * block was recorded, plus a ring-down after the tone, and leaves just
+ * those bins out. Broadband paths (shot onsets) notch the tones out of
+ * the samples instead, so a shot under a beep is still seen.
+ *
+ * Pure logic with no Arduino dependencies; times are esp_timer
+ * microseconds.
+ */
+class ToneBlanker {
+public:
+    ToneBlanker();
+
+    /**
+     * @param ringDownUs   after a tone ends it still counts this long
+     * @param halfWidthHz  bins this close to a tone (or harmonic) are blanked
+     */
+    void configure(uint32_t ringDownUs, float halfWidthHz);
+    uint32_t getRingDownUs() const { return ringDownUs; }
+
+    void addTone(int64_t startUs, int64_t endUs, uint16_t frequency);
+    void clear();
+
+    /**
+     * Bins to leave out for audio recorded in [fromUs, toUs]
+     * @return bit i set = bin i is blanked
+     */
+    uint32_t binMask(int64_t fromUs, int64_t toUs, const float* binHz, int bins) const;
+
+    /**
+     * Our tones sounding (or ringing down) in [fromUs, toUs]
+     * @return number of frequencies written
+     */
+    int activeTones(int64_t fromUs, int64_t toUs, uint16_t* frequencies, int maxTones) const;
+
+    /**
+     * Notch a tone and its harmonics below Nyquist out of a block in place
+     * (second-order IIR notches, run once per harmonic)
+     * @return leading samples still carrying the notch start-up transient
+     */
+    static int notch(float* samples, int count, float frequency, float sampleRate);
+
+    static constexpr int MAX_TONES = 8;
+    static constexpr int MAX_HARMONIC = 5;      // square-ish drive: up to the 5th
+
+    // Wide and fast: a shot is broadband, so losing an octave around the
+    // tone costs little, and the notch settles within a few samples
+    static constexpr float NOTCH_Q = 2.0f;
+
+private:
+    OwnTone tones[MAX_TONES];
+    int head;
+    int count;
+    uint32_t ringDownUs;
+    float halfWidthHz;
+
+    bool overlaps(const OwnTone& t, int64_t fromUs, int64_t toUs) const;
+};
+
+#endif
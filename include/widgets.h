@@ -0,0 +1,185 @@
+#ifndef WIDGETS_H
+#define WIDGETS_H
+
+#include <LovyanGFX.hpp>
+#include "glyph_cache.h"
+#include "tile_canvas.h"
+#include "rle_asset.h"
+
+/**
+ * Widget - retained screen element with its own bounds and dirty flag
+ *
+ * Widgets form a small tree per screen region. Setters compare against
+ * the retained value and only invalidate when what is shown would change,
+ * so paint() touches nothing on a frame where nothing changed. A widget
+ * repaints its full bounds (background included) and never relies on the
+ * previous contents of the canvas.
+ *
+ * When a parent repaints it covers its children, so they repaint with it.
+ * Coordinates are region-local (the TileCanvas the tree is painted into),
+ * and every paint reports its damage rect to that canvas.
+ */
+class Widget {
+public:
+    Widget(int x, int y, int width, int height);
+    virtual ~Widget() {}
+
+    void addChild(Widget* child);
+
+    void invalidate() { dirty = true; }
+    bool isDirty() const { return dirty; }
+
+    /**
+     * Hidden widgets are not painted. Changing visibility repaints the
+     * parent so the area is cleared (or the widget shows up).
+     */
+    void setVisible(bool show);
+    bool isVisible() const { return visible; }
+
+    /**
+     * Repaint this widget if dirty (or apply a partial update), then its children
+     * @return number of widgets painted
+     */
+    int paint(TileCanvas& target);
+
+protected:
+    int x;
+    int y;
+    int width;
+    int height;
+
+    // Full repaint of the bounds. Colours go through target.color() so
+    // the same code draws into RGB565 and palette-indexed canvases.
+    virtual void draw(TileCanvas& target) = 0;
+
+    // Incremental update when not dirty - draw and report damage, return
+    // true if anything was drawn. Default: nothing to do.
+    virtual bool drawChanges(TileCanvas& /*target*/) { return false; }
+
+private:
+    bool dirty;
+    bool visible;
+    Widget* parent;
+    Widget* firstChild;
+    Widget* nextSibling;
+};
+
+// Solid background - used as the root of each region
+class PanelWidget : public Widget {
+public:
+    PanelWidget(int x, int y, int width, int height, uint16_t color);
+
+    void setColor(uint16_t color);
+    uint16_t getColor() const { return bgColor; }
+
+protected:
+    void draw(TileCanvas& target) override;
+
+private:
+    uint16_t bgColor;
+};
+
+// Single line of built-in font text
+class LabelWidget : public Widget {
+public:
+    LabelWidget(int x, int y, int width, int height, int textSize);
+
+    void setText(const char* text);
+    void setColors(uint16_t fg, uint16_t bg);
+
+protected:
+    void draw(TileCanvas& target) override;
+
+private:
+    static constexpr int MAX_TEXT = 32;
+    char text[MAX_TEXT];
+    int textSize;
+    uint16_t fgColor;
+    uint16_t bgColor;
+};
+
+// Large digits centred horizontally, drawn from a GlyphCache
+class ReadoutWidget : public Widget {
+public:
+    ReadoutWidget(int x, int y, int width, GlyphCache* cache);
+
+    void setText(const char* text);
+    void setColors(uint16_t fg, uint16_t bg);
+
+protected:
+    void draw(TileCanvas& target) override;
+
+private:
+    static constexpr int MAX_TEXT = 10;
+    GlyphCache* glyphs;
+    char text[MAX_TEXT];
+    uint16_t fgColor;
+    uint16_t bgColor;
+};
+
+// Fill bar with grey frame. A fill change only redraws (and pushes) the
+// pixel columns between the old and new fill edge; a colour change repaints.
+class ProgressBarWidget : public Widget {
+public:
+    ProgressBarWidget(int x, int y, int width, int height);
+
+    void setValue(float percentage, uint16_t color);
+
+protected:
+    void draw(TileCanvas& target) override;
+    bool drawChanges(TileCanvas& target) override;
+
+private:
+    int fillWidth;
+    int drawnFillWidth;  // fill currently in the canvas
+    uint16_t fillColor;
+};
+
+// Spirit-level vial: a bubble that moves to the high side, with marks at
+// the tolerance. A bubble move only redraws (and pushes) the columns the
+// old and new bubble cover, so it can run at full frame rate.
+class BubbleWidget : public Widget {
+public:
+    BubbleWidget(int x, int y, int width, int height);
+
+    // Angle shown at either end of the vial and the tolerance marks
+    void setScale(float fullScaleDeg, float toleranceDeg);
+    void setAngle(float angle);
+
+    static constexpr int BUBBLE_W = 20;
+
+protected:
+    void draw(TileCanvas& target) override;
+    bool drawChanges(TileCanvas& target) override;
+
+private:
+    float fullScale;
+    int markOffset;     // tolerance marks, px from the centre
+    int bubbleX;        // bubble left edge, widget-local
+    int drawnBubbleX;   // bubble currently in the canvas
+
+    int positionFor(float angle) const;
+    void drawInterior(TileCanvas& target, int from, int to);
+};
+
+// Two-colour RLE asset (assets.h) centred in the bounds, drawn in the
+// widget colours: palette index 0 background, 1 foreground (nullptr =
+// background only)
+class BitmapWidget : public Widget {
+public:
+    BitmapWidget(int x, int y, int width, int height);
+
+    // Build-time asset (assets.h), centred in the bounds; nullptr = empty
+    void setBitmap(const RleAsset* asset);
+    void setColors(uint16_t fg, uint16_t bg);
+
+protected:
+    void draw(TileCanvas& target) override;
+
+private:
+    const RleAsset* bitmap;
+    uint16_t fgColor;
+    uint16_t bgColor;
+};
+
+#endif
@@ -0,0 +1,56 @@
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+/**
+ * Host stand-in for the few Arduino core calls the display and menu code
+ * uses. Time is a virtual clock the tests set and advance; delay() only
+ * moves it forward. Serial prints to stdout.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+
+using std::min;
+using std::max;
+
+#define IRAM_ATTR
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+
+// Virtual clock (host only)
+void hostSetMicros(uint64_t us);
+void hostAdvanceMicros(uint64_t us);
+
+class Print {
+public:
+    size_t print(const char* text);
+    size_t println(const char* text);
+    size_t println();
+    size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+
+    // Host only: drop output (tests that don't want the log)
+    void setQuiet(bool on) { quiet = on; }
+
+private:
+    bool quiet = false;
+};
+
+extern Print Serial;
+
+class EspClass {
+public:
+    // Cycle counter at 240 MHz from the virtual clock
+    uint32_t getCycleCount();
+};
+
+extern EspClass ESP;
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef HOST_FASTLED_H
+#define HOST_FASTLED_H
+
+#include <stdint.h>
+
+// Status LED colour only - nothing is driven on the host
+struct CRGB {
+    uint8_t r, g, b;
+
+    CRGB() : r(0), g(0), b(0) {}
+    CRGB(uint32_t rgb) : r(rgb >> 16), g(rgb >> 8), b(rgb) {}
+
+    enum HTMLColorCode : uint32_t {
+        Black = 0x000000,
+        Blue = 0x0000FF,
+        Cyan = 0x00FFFF,
+        Green = 0x008000,
+        Orange = 0xFFA500,
+        Purple = 0x800080,
+        Red = 0xFF0000,
+        White = 0xFFFFFF,
+        Yellow = 0xFFFF00
+    };
+};
+
+class CFastLED {
+public:
+    void setBrightness(uint8_t scale) { brightness = scale; }
+    uint8_t getBrightness() const { return brightness; }
+    void show() {}
+
+private:
+    uint8_t brightness = 255;
+};
+
+extern CFastLED FastLED;
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef HOST_PREFERENCES_H
+#define HOST_PREFERENCES_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * In-memory NVS: keys live for the life of the process, one namespace
+ * at a time (as Settings uses it)
+ */
+class Preferences {
+public:
+    bool begin(const char* name, bool readOnly = false);
+    void end();
+
+    bool clear();
+    bool remove(const char* key);
+    bool isKey(const char* key);
+
+    size_t putBytes(const char* key, const void* value, size_t length);
+    size_t getBytes(const char* key, void* buf, size_t maxLength);
+    size_t getBytesLength(const char* key);
+
+    size_t putInt(const char* key, int32_t value);
+    size_t putFloat(const char* key, float value);
+    size_t putBool(const char* key, bool value);
+    int32_t getInt(const char* key, int32_t defaultValue = 0);
+    float getFloat(const char* key, float defaultValue = 0);
+    bool getBool(const char* key, bool defaultValue = false);
+
+private:
+    bool readOnly = false;
+};
+
+#endif
@@ -0,0 +1,19 @@
+#ifndef HOST_ROTARY_ENCODER_H
+#define HOST_ROTARY_ENCODER_H
+
+// Position only; tests turn it with setPosition()
+class RotaryEncoder {
+public:
+    enum class LatchMode { FOUR3 = 1, FOUR0 = 2, TWO03 = 3 };
+
+    RotaryEncoder(int /*pin1*/, int /*pin2*/, LatchMode /*mode*/ = LatchMode::FOUR0) : position(0) {}
+
+    void tick() {}
+    long getPosition() { return position; }
+    void setPosition(long newPosition) { position = newPosition; }
+
+private:
+    long position;
+};
+
+#endif
@@ -0,0 +1,7 @@
+#ifndef HOST_SENSOR_QMI8658_HPP
+#define HOST_SENSOR_QMI8658_HPP
+
+// LevelMonitor only holds a pointer to the IMU driver
+class SensorQMI8658;
+
+#endif
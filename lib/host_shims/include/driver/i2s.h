@@ -0,0 +1,12 @@
+#ifndef HOST_DRIVER_I2S_H
+#define HOST_DRIVER_I2S_H
+
+#include <freertos/FreeRTOS.h>
+
+// Types only - MicDetector names its port and event queue
+typedef enum {
+    I2S_NUM_0 = 0,
+    I2S_NUM_1 = 1
+} i2s_port_t;
+
+#endif
@@ -0,0 +1,16 @@
+#ifndef HOST_ESP_HEAP_CAPS_H
+#define HOST_ESP_HEAP_CAPS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+// One heap on the host: every capability is plain malloc
+#define MALLOC_CAP_DMA    (1 << 3)
+#define MALLOC_CAP_8BIT   (1 << 2)
+#define MALLOC_CAP_SPIRAM (1 << 10)
+
+inline void* heap_caps_malloc(size_t size, uint32_t /*caps*/) { return malloc(size); }
+inline void heap_caps_free(void* ptr) { free(ptr); }
+
+#endif
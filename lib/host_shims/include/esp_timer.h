@@ -0,0 +1,11 @@
+#ifndef HOST_ESP_TIMER_H
+#define HOST_ESP_TIMER_H
+
+#include <stdint.h>
+
+// Types only - Buzzer holds a timer handle
+typedef struct esp_timer* esp_timer_handle_t;
+
+int64_t esp_timer_get_time();
+
+#endif
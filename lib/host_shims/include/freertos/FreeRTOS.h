@@ -0,0 +1,20 @@
+#ifndef HOST_FREERTOS_H
+#define HOST_FREERTOS_H
+
+#include <stdint.h>
+
+// Types only - held as members by the audio and buzzer modules
+typedef int BaseType_t;
+typedef uint32_t TickType_t;
+typedef void* QueueHandle_t;
+
+typedef struct {
+    volatile uint32_t owner;
+    uint32_t count;
+} portMUX_TYPE;
+
+#define portMUX_INITIALIZER_UNLOCKED {0, 0}
+#define pdTRUE  1
+#define pdFALSE 0
+
+#endif
@@ -0,0 +1,8 @@
+#ifndef HOST_FREERTOS_SEMPHR_H
+#define HOST_FREERTOS_SEMPHR_H
+
+#include "FreeRTOS.h"
+
+typedef QueueHandle_t SemaphoreHandle_t;
+
+#endif
@@ -0,0 +1,142 @@
+#include <Arduino.h>
+#include <Preferences.h>
+#include <FastLED.h>
+#include <esp_rom_crc.h>
+#include <esp_timer.h>
+#include <stdarg.h>
+#include <map>
+#include <string>
+#include <vector>
+
+Print Serial;
+EspClass ESP;
+CFastLED FastLED;
+
+// ---------------------------------------------------------------------------
+// Virtual clock
+// ---------------------------------------------------------------------------
+
+static uint64_t clockUs;
+
+unsigned long millis() { return (unsigned long)(uint32_t)(clockUs / 1000); }
+unsigned long micros() { return (unsigned long)(uint32_t)clockUs; }
+int64_t esp_timer_get_time() { return (int64_t)clockUs; }
+void delay(unsigned long ms) { clockUs += (uint64_t)ms * 1000; }
+
+void hostSetMicros(uint64_t us) { clockUs = us; }
+void hostAdvanceMicros(uint64_t us) { clockUs += us; }
+
+uint32_t EspClass::getCycleCount() { return (uint32_t)(clockUs * 240); }
+
+// ---------------------------------------------------------------------------
+// Serial
+// ---------------------------------------------------------------------------
+
+size_t Print::print(const char* text) {
+    if (quiet) return strlen(text);
+    return fputs(text, stdout) < 0 ? 0 : strlen(text);
+}
+
+size_t Print::println(const char* text) {
+    return print(text) + println();
+}
+
+size_t Print::println() {
+    return print("\n");
+}
+
+size_t Print::printf(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    int n = quiet ? vsnprintf(nullptr, 0, format, args) : vprintf(format, args);
+    va_end(args);
+    return n < 0 ? 0 : n;
+}
+
+// ---------------------------------------------------------------------------
+// Preferences - one store per namespace, kept for the whole run
+// ---------------------------------------------------------------------------
+
+typedef std::map<std::string, std::vector<uint8_t>> KeyStore;
+
+static std::map<std::string, KeyStore> stores;
+static KeyStore* openStore;
+
+bool Preferences::begin(const char* name, bool ro) {
+    openStore = &stores[name];
+    readOnly = ro;
+    return true;
+}
+
+void Preferences::end() {
+    openStore = nullptr;
+}
+
+bool Preferences::clear() {
+    if (!openStore || readOnly) return false;
+    openStore->clear();
+    return true;
+}
+
+bool Preferences::remove(const char* key) {
+    if (!openStore || readOnly) return false;
+    return openStore->erase(key) > 0;
+}
+
+bool Preferences::isKey(const char* key) {
+    return openStore && openStore->count(key) > 0;
+}
+
+size_t Preferences::putBytes(const char* key, const void* value, size_t length) {
+    if (!openStore || readOnly) return 0;
+    const uint8_t* bytes = static_cast<const uint8_t*>(value);
+    (*openStore)[key].assign(bytes, bytes + length);
+    return length;
+}
+
+size_t Preferences::getBytes(const char* key, void* buf, size_t maxLength) {
+    if (!isKey(key)) return 0;
+    const std::vector<uint8_t>& stored = (*openStore)[key];
+    // Like NVS: a buffer too small for the blob reads nothing
+    if (stored.size() > maxLength) return 0;
+    memcpy(buf, stored.data(), stored.size());
+    return stored.size();
+}
+
+size_t Preferences::getBytesLength(const char* key) {
+    return isKey(key) ? (*openStore)[key].size() : 0;
+}
+
+size_t Preferences::putInt(const char* key, int32_t value) { return putBytes(key, &value, sizeof(value)); }
+size_t Preferences::putFloat(const char* key, float value) { return putBytes(key, &value, sizeof(value)); }
+size_t Preferences::putBool(const char* key, bool value) { return putBytes(key, &value, sizeof(value)); }
+
+int32_t Preferences::getInt(const char* key, int32_t defaultValue) {
+    int32_t value = defaultValue;
+    return getBytesLength(key) == sizeof(value) && getBytes(key, &value, sizeof(value)) ? value : defaultValue;
+}
+
+float Preferences::getFloat(const char* key, float defaultValue) {
+    float value = defaultValue;
+    return getBytesLength(key) == sizeof(value) && getBytes(key, &value, sizeof(value)) ? value : defaultValue;
+}
+
+bool Preferences::getBool(const char* key, bool defaultValue) {
+    bool value = defaultValue;
+    return getBytesLength(key) == sizeof(value) && getBytes(key, &value, sizeof(value)) ? value : defaultValue;
+}
+
+// ---------------------------------------------------------------------------
+// ROM CRC
+// ---------------------------------------------------------------------------
+
+uint32_t esp_rom_crc32_le(uint32_t crc, uint8_t const* buf, uint32_t len) {
+    crc = ~crc;
+    for (uint32_t i = 0; i < len; i++) {
+        crc ^= buf[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320UL & (0 - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
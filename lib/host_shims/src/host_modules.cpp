@@ -0,0 +1,35 @@
+/**
+ * Stand-ins for the hardware modules MenuSystem calls into (buzzer, mic,
+ * IMU, perf monitor, status LED). Globals start zeroed, as on the device
+ * before begin(); the calls do the least that keeps the screens right.
+ */
+
+#include <Arduino.h>
+#include "buzzer.h"
+#include "mic_detector.h"
+#include "level_monitor.h"
+#include "perf_monitor.h"
+#include "display_manager.h"
+#include "pin_config.h"
+
+Buzzer buzzer;
+MicDetector micDetector;
+LevelMonitor levelMonitor;
+PerfMonitor perfMonitor;
+CRGB leds[NUM_LEDS];
+
+Buzzer::Buzzer() {}
+void Buzzer::beepStart() {}
+
+MicDetector::MicDetector() {}
+void MicDetector::resetStats() {}
+
+LevelMonitor::LevelMonitor() {}
+void LevelMonitor::calibrate() {}
+
+PerfMonitor::PerfMonitor() {}
+
+void PerfMonitor::setOverlay(bool on) {
+    overlayOn = on;
+    display.showPerfOverlay(on);
+}
@@ -0,0 +1,81 @@
+#ifdef HEADLESS_DISPLAY
+
+#include "bus_capture.h"
+#include <stdlib.h>
+
+Bus_Capture::Bus_Capture()
+    : clock(80000000)
+    , dmaBuffer(nullptr)
+    , dmaBufferSize(0)
+{
+}
+
+Bus_Capture::~Bus_Capture() {
+    free(dmaBuffer);
+}
+
+// LovyanGFX packs multi-byte writes least significant byte first
+static int unpack(uint32_t data, uint_fast8_t bitLength, uint8_t* out) {
+    int count = bitLength / 8;
+    for (int i = 0; i < count; i++) {
+        out[i] = (data >> (8 * i)) & 0xFF;
+    }
+    return count;
+}
+
+bool Bus_Capture::writeCommand(uint32_t data, uint_fast8_t bit_length) {
+    uint8_t bytes[4];
+    int count = unpack(data, bit_length, bytes);
+    for (int i = 0; i < count; i++) {
+        model.command(bytes[i]);
+    }
+    return true;
+}
+
+void Bus_Capture::writeData(uint32_t data, uint_fast8_t bit_length) {
+    uint8_t bytes[4];
+    int count = unpack(data, bit_length, bytes);
+    model.data(bytes, count);
+}
+
+void Bus_Capture::writeDataRepeat(uint32_t data, uint_fast8_t bit_length, uint32_t count) {
+    uint8_t bytes[4];
+    int patternBytes = unpack(data, bit_length, bytes);
+    model.dataRepeat(bytes, patternBytes, count);
+}
+
+void Bus_Capture::writePixels(lgfx::pixelcopy_t* param, uint32_t length) {
+    // Convert through the pixelcopy in chunks, exactly as Bus_SPI would
+    const uint32_t CHUNK = 256;
+    uint8_t bytesPerPixel = param->dst_bits >> 3;
+    uint8_t* buf = getDMABuffer(CHUNK * bytesPerPixel);
+
+    uint32_t done = 0;
+    while (done < length) {
+        uint32_t n = (length - done < CHUNK) ? length - done : CHUNK;
+        param->fp_copy(buf, 0, n, param);
+        model.data(buf, n * bytesPerPixel);
+        done += n;
+    }
+}
+
+void Bus_Capture::writeBytes(const uint8_t* data, uint32_t length, bool dc, bool use_dma) {
+    if (dc) {
+        model.data(data, length);
+    } else {
+        for (uint32_t i = 0; i < length; i++) {
+            model.command(data[i]);
+        }
+    }
+}
+
+uint8_t* Bus_Capture::getDMABuffer(uint32_t length) {
+    if (length > dmaBufferSize) {
+        free(dmaBuffer);
+        dmaBuffer = (uint8_t*)malloc(length);
+        dmaBufferSize = dmaBuffer ? length : 0;
+    }
+    return dmaBuffer;
+}
+
+#endif  // HEADLESS_DISPLAY
@@ -1,69 +1,208 @@
 #include "buzzer.h"
 #include "pin_config.h"
 #include "settings.h"
+#include "mic_detector.h"
 
 Buzzer buzzer;
 
+// LEDC channel 2 runs on timer 1 - channel 1 would share timer 0 with
+// the backlight and retune its PWM on every tone
+#define BUZZER_LEDC_CHANNEL 2
+
+// Cues (flash only)
+static constexpr ToneStep START_STEPS[] = {
+    {2000, 150}                                 // "GO!"
+};
+static constexpr ToneStep YELLOW_STEPS[] = {
+    {1500, 100}, {0, 100}, {1500, 100}          // "Warning!"
+};
+static constexpr ToneStep RED_STEPS[] = {
+    {1200, 80}, {0, 60}, {1200, 80}, {0, 60}, {1200, 80}   // "Hurry!"
+};
+static constexpr ToneStep FINISHED_STEPS[] = {
+    {800, 1000}                                 // "TIME!"
+};
+
+static constexpr BuzzerPattern START_CUE = makePattern(START_STEPS);
+static constexpr BuzzerPattern YELLOW_CUE = makePattern(YELLOW_STEPS);
+static constexpr BuzzerPattern RED_CUE = makePattern(RED_STEPS);
+static constexpr BuzzerPattern FINISHED_CUE = makePattern(FINISHED_STEPS);
+
 Buzzer::Buzzer() {
-    isPlaying = false;
-    toneEndTime = 0;
+    current.steps = nullptr;
+    current.count = 0;
+    stepIndex = 0;
+    stepEndUs = 0;
+    active = false;
+    queueHead = 0;
+    queueCount = 0;
+    stepTimer = nullptr;
+    lock = nullptr;
+    maxLatenessUs = 0;
 }
 
 void Buzzer::begin() {
     pinMode(BUZZER_PIN, OUTPUT);
     digitalWrite(BUZZER_PIN, LOW);
+    lock = xSemaphoreCreateMutex();
+
+    esp_timer_create_args_t args = {};
+    args.callback = &Buzzer::onStep;
+    args.arg = this;
+    args.dispatch_method = ESP_TIMER_TASK;
+    args.name = "buzzer";
+
+    if (esp_timer_create(&args, &stepTimer) != ESP_OK) {
+        // update() steps the cues instead (loop-rate accuracy)
+        stepTimer = nullptr;
+        Serial.println("Buzzer: esp_timer unavailable, polling");
+        return;
+    }
     Serial.println("Buzzer: OK!");
 }
 
-void Buzzer::tone(uint16_t frequency, unsigned long duration) {
+void Buzzer::output(uint16_t frequency) {
+    if (frequency == 0) {
+        ledcWrite(BUZZER_LEDC_CHANNEL, 0);
+        return;
+    }
+
     // Convert volume (0-100) to duty cycle (0-255)
-    // Using square root for more linear perceived volume
     int dutyCycle = map(settings.buzzerVolume, 0, 100, 0, 255);
-    
-    // Use ledc (LED PWM controller) for tone generation
-    ledcSetup(1, frequency, 8);  // Channel 1, frequency, 8-bit resolution
-    ledcAttachPin(BUZZER_PIN, 1);
-    ledcWrite(1, dutyCycle);  // <-- Use calculated duty cycle
-    
-    isPlaying = true;
-    toneEndTime = millis() + duration;
+
+    ledcSetup(BUZZER_LEDC_CHANNEL, frequency, 8);
+    ledcAttachPin(BUZZER_PIN, BUZZER_LEDC_CHANNEL);
+    ledcWrite(BUZZER_LEDC_CHANNEL, dutyCycle);
 }
 
-void Buzzer::noTone() {
-    ledcWrite(1, 0);
+void Buzzer::startStep() {
+    // Caller holds the lock
+    while (true) {
+        if (stepIndex < current.count) {
+            const ToneStep& step = current.steps[stepIndex];
+            output(step.frequency);
+
+            // Deadlines chain from the cue start, a late step does not delay the rest
+            int64_t stepStartUs = stepEndUs;
+            stepEndUs += (int64_t)step.durationMs * 1000;
+
+            // The mic must not take our own tone for a beep or a shot
+            if (step.frequency > 0) {
+                micDetector.noteOwnTone(stepStartUs, stepEndUs, step.frequency);
+            }
+            if (stepTimer) {
+                int64_t delayUs = stepEndUs - esp_timer_get_time();
+                esp_timer_stop(stepTimer);
+                esp_timer_start_once(stepTimer, delayUs > 0 ? delayUs : 0);
+            }
+            return;
+        }
+
+        if (queueCount == 0) break;
+
+        // Next cue straight after this one
+        current = queue[queueHead];
+        queueHead = (queueHead + 1) % QUEUE_SIZE;
+        queueCount--;
+        stepIndex = 0;
+    }
+
+    ledcWrite(BUZZER_LEDC_CHANNEL, 0);
     ledcDetachPin(BUZZER_PIN);
     digitalWrite(BUZZER_PIN, LOW);
-    isPlaying = false;
+    active = false;
+}
+
+void Buzzer::nextStep() {
+    // The step timer shares the esp_timer task with the countdown: never
+    // wait for loop() here, come back shortly instead
+    if (lock && xSemaphoreTake(lock, 0) != pdTRUE) {
+        if (stepTimer) {
+            esp_timer_stop(stepTimer);
+            esp_timer_start_once(stepTimer, LOCK_RETRY_US);
+        }
+        return;
+    }
+
+    int64_t now = esp_timer_get_time();
+    if (active && now >= stepEndUs) {
+        uint32_t lateUs = (uint32_t)(now - stepEndUs);
+        if (lateUs > maxLatenessUs) {
+            maxLatenessUs = lateUs;
+        }
+        stepIndex++;
+        startStep();
+    } else if (active && stepTimer) {
+        // Fired early (or a retry) - the step still has to end on time
+        esp_timer_stop(stepTimer);
+        esp_timer_start_once(stepTimer, stepEndUs - now);
+    }
+    if (lock) xSemaphoreGive(lock);
+}
+
+void Buzzer::onStep(void* arg) {
+    static_cast<Buzzer*>(arg)->nextStep();
+}
+
+void Buzzer::play(const BuzzerPattern& pattern, bool preempt) {
+    if (pattern.count == 0) return;
+
+    if (lock) xSemaphoreTake(lock, portMAX_DELAY);
+
+    if (preempt) {
+        queueCount = 0;
+        active = false;
+    }
+
+    if (!active) {
+        current = pattern;
+        stepIndex = 0;
+        stepEndUs = esp_timer_get_time();
+        active = true;
+        startStep();
+    } else if (queueCount < QUEUE_SIZE) {
+        queue[(queueHead + queueCount) % QUEUE_SIZE] = pattern;
+        queueCount++;
+    }
+
+    if (lock) xSemaphoreGive(lock);
+}
+
+void Buzzer::stop() {
+    if (lock) xSemaphoreTake(lock, portMAX_DELAY);
+    if (stepTimer) {
+        esp_timer_stop(stepTimer);
+    }
+    queueCount = 0;
+    stepIndex = current.count;
+    startStep();
+    if (lock) xSemaphoreGive(lock);
 }
 
 void Buzzer::update() {
-    if (isPlaying && millis() >= toneEndTime) {
-        noTone();
+    // The step timer does the work; this only covers a missing esp_timer
+    if (!stepTimer && active) {
+        nextStep();
     }
 }
 
 void Buzzer::beepStart() {
-    // Single high-pitched chirp - "GO!"
-    tone(2000, 150);
+    play(START_CUE, true);
     Serial.println("Buzzer: Start beep");
 }
 
+// Warnings and the alarm run in the countdown's timer task - no Serial
+// output here, CountdownTimer::update() logs them from loop()
+
 void Buzzer::beepYellowWarning() {
-    // Two medium beeps - "Warning!"
-    tone(1500, 100);
-    // Note: For multiple beeps, we'd need a more sophisticated system
-    // For now, this gives one beep. We'll enhance this below.
-    Serial.println("Buzzer: Yellow warning");
+    play(YELLOW_CUE);
 }
 
 void Buzzer::beepRedWarning() {
-    // Three urgent beeps - "Hurry!"
-    tone(1200, 80);
-    Serial.println("Buzzer: Red warning");
+    play(RED_CUE);
 }
 
 void Buzzer::beepFinished() {
-    // Long alarm - "TIME!"
-    tone(800, 1000);
-    Serial.println("Buzzer: Finished alarm");
-}
\ No newline at end of file
+    // The alarm cuts off anything still queued
+    play(FINISHED_CUE, true);
+}
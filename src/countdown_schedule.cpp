@@ -0,0 +1,80 @@
+#include "countdown_schedule.h"
+
+CountdownSchedule::CountdownSchedule() {
+    running = false;
+    startUs = 0;
+    durationUs = 0;
+    armed = 0;
+    fired = 0;
+    for (int i = 0; i < COUNTDOWN_EVENT_COUNT; i++) {
+        deadline[i] = 0;
+    }
+}
+
+void CountdownSchedule::start(uint64_t nowUs, uint32_t parMs, uint32_t yellowMs, uint32_t redMs) {
+    running = true;
+    startUs = nowUs;
+    durationUs = (uint64_t)parMs * 1000;
+    fired = 0;
+
+    deadline[COUNTDOWN_FINISHED] = startUs + durationUs;
+    armed = eventBit(COUNTDOWN_FINISHED);
+
+    // Warnings are due when that much time is left
+    if (yellowMs < parMs) {
+        deadline[COUNTDOWN_YELLOW] = startUs + (uint64_t)(parMs - yellowMs) * 1000;
+        armed |= eventBit(COUNTDOWN_YELLOW);
+    }
+    if (redMs < parMs) {
+        deadline[COUNTDOWN_RED] = startUs + (uint64_t)(parMs - redMs) * 1000;
+        armed |= eventBit(COUNTDOWN_RED);
+    }
+}
+
+void CountdownSchedule::stop() {
+    running = false;
+    armed = 0;
+    fired = 0;
+}
+
+bool CountdownSchedule::nextDeadline(uint64_t& deadlineUs) const {
+    if (!running) return false;
+
+    bool found = false;
+    for (int i = 0; i < COUNTDOWN_EVENT_COUNT; i++) {
+        uint8_t bit = eventBit((CountdownEvent)i);
+        if (!(armed & bit) || (fired & bit)) continue;
+        if (!found || deadline[i] < deadlineUs) {
+            deadlineUs = deadline[i];
+            found = true;
+        }
+    }
+    return found;
+}
+
+uint8_t CountdownSchedule::fireDue(uint64_t nowUs) {
+    if (!running) return 0;
+
+    uint8_t due = 0;
+    for (int i = 0; i < COUNTDOWN_EVENT_COUNT; i++) {
+        uint8_t bit = eventBit((CountdownEvent)i);
+        if ((armed & bit) && !(fired & bit) && nowUs >= deadline[i]) {
+            due |= bit;
+        }
+    }
+    fired |= due;
+
+    // Finished is the last deadline - the run is over
+    if (due & eventBit(COUNTDOWN_FINISHED)) {
+        running = false;
+    }
+    return due;
+}
+
+uint32_t CountdownSchedule::remainingMs(uint64_t nowUs) const {
+    if (!running) return 0;
+
+    uint64_t elapsedUs = nowUs - startUs;
+    if (elapsedUs >= durationUs) return 0;
+    return (durationUs - elapsedUs + 999) / 1000;
+}
@@ -0,0 +1,117 @@
+#include "display_governor.h"
+#include <string.h>
+
+constexpr uint32_t DisplayGovernor::FRAME_INTERVAL_MS[DISPLAY_MODE_COUNT];
+
+static const char* MODE_NAMES[DISPLAY_MODE_COUNT] = {
+    "dimmed", "idle", "menu", "active", "running", "final"
+};
+
+DisplayGovernor::DisplayGovernor() {
+    mode = DISPLAY_MODE_IDLE;
+    backlight = 255;
+    lastActivityMs = 0;
+    lastUpdateMs = 0;
+    lastFrameMs = 0;
+    dimAfterMs = 0;
+    finalBelowMs = 0;
+    fastLevel = false;
+    resetStats();
+}
+
+void DisplayGovernor::configure(uint32_t dimAfter, uint32_t finalBelow) {
+    dimAfterMs = dimAfter;
+    finalBelowMs = finalBelow;
+}
+
+void DisplayGovernor::notifyActivity(uint32_t nowMs) {
+    lastActivityMs = nowMs;
+}
+
+void DisplayGovernor::update(uint32_t nowMs, const DisplayActivity& activity, uint8_t targetBrightness) {
+    // Account the interval that just ended at the previous mode/level
+    uint32_t elapsed = nowMs - lastUpdateMs;
+    lastUpdateMs = nowMs;
+    modeMs[mode] += elapsed;
+    backlightIntegral += (uint64_t)backlight * elapsed;
+
+    uint32_t idleMs = nowMs - lastActivityMs;
+    fastLevel = activity.fastLevel;
+
+    if (activity.timerRunning) {
+        mode = (activity.remainingMs < finalBelowMs) ? DISPLAY_MODE_FINAL : DISPLAY_MODE_RUNNING;
+    } else if (!activity.keepBright && dimAfterMs > 0 && idleMs >= dimAfterMs) {
+        mode = DISPLAY_MODE_DIMMED;
+    } else if (activity.menuOpen) {
+        mode = DISPLAY_MODE_MENU;
+    } else if (idleMs < ACTIVE_HOLD_MS) {
+        mode = DISPLAY_MODE_ACTIVE;
+    } else {
+        mode = DISPLAY_MODE_IDLE;
+    }
+
+    if (mode != DISPLAY_MODE_DIMMED) {
+        backlight = targetBrightness;
+        return;
+    }
+
+    // Linear ramp from the configured level down to DIM_PERCENT of it
+    uint32_t dimLevel = (uint32_t)targetBrightness * DIM_PERCENT / 100;
+    uint32_t rampMs = idleMs - dimAfterMs;
+    if (rampMs >= DIM_RAMP_MS) {
+        backlight = dimLevel;
+    } else {
+        backlight = targetBrightness - (targetBrightness - dimLevel) * rampMs / DIM_RAMP_MS;
+    }
+}
+
+void DisplayGovernor::skipElapsed(uint32_t nowMs) {
+    lastUpdateMs = nowMs;
+}
+
+uint32_t DisplayGovernor::getFrameIntervalMs() const {
+    bool mainScreen = mode != DISPLAY_MODE_DIMMED && mode != DISPLAY_MODE_MENU;
+    if (fastLevel && mainScreen && FAST_LEVEL_INTERVAL_MS < FRAME_INTERVAL_MS[mode]) {
+        return FAST_LEVEL_INTERVAL_MS;
+    }
+    return FRAME_INTERVAL_MS[mode];
+}
+
+bool DisplayGovernor::frameDue(uint32_t nowMs) {
+    if (nowMs - lastFrameMs < getFrameIntervalMs()) {
+        return false;
+    }
+    lastFrameMs = nowMs;
+    frames++;
+    return true;
+}
+
+uint32_t DisplayGovernor::msUntilFrame(uint32_t nowMs) const {
+    uint32_t sinceMs = nowMs - lastFrameMs;
+    uint32_t intervalMs = getFrameIntervalMs();
+    return sinceMs >= intervalMs ? 0 : intervalMs - sinceMs;
+}
+
+uint32_t DisplayGovernor::getTotalMs() const {
+    uint32_t total = 0;
+    for (int i = 0; i < DISPLAY_MODE_COUNT; i++) {
+        total += modeMs[i];
+    }
+    return total;
+}
+
+float DisplayGovernor::getBacklightDuty() const {
+    uint32_t total = getTotalMs();
+    if (total == 0) return backlight / 255.0f;
+    return backlightIntegral / (255.0f * total);
+}
+
+void DisplayGovernor::resetStats() {
+    memset(modeMs, 0, sizeof(modeMs));
+    backlightIntegral = 0;
+    frames = 0;
+}
+
+const char* DisplayGovernor::modeName(DisplayMode m) {
+    return (m >= 0 && m < DISPLAY_MODE_COUNT) ? MODE_NAMES[m] : "?";
+}
@@ -1,79 +1,17 @@
 #include "display_manager.h"
-#include "settings.h" 
-
-    // Left arrow bitmap (50x50)
-    #define ARROW_LEFT_WIDTH 50
-    #define ARROW_LEFT_HEIGHT 50
-    static const unsigned char arrow_left_bits[] = {
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF8, 0x7F, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0xFF, 0xFF, 0x03, 0x00, 0x00, 0x00, 0xC0, 0xFF, 0xFF, 0x0F, 0x00, 
-    0x00, 0x00, 0xE0, 0xFF, 0xFF, 0x1F, 0x00, 0x00, 0x00, 0xF8, 0x3F, 0xF0, 
-    0x7F, 0x00, 0x00, 0x00, 0xFC, 0x07, 0x80, 0xFF, 0x00, 0x00, 0x00, 0xFE, 
-    0x01, 0x00, 0xFE, 0x01, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFC, 0x03, 0x00, 
-    0x00, 0x3F, 0x00, 0x00, 0xF0, 0x03, 0x00, 0x80, 0x1F, 0x00, 0x00, 0xE0, 
-    0x07, 0x00, 0xC0, 0x0F, 0x00, 0x00, 0xC0, 0x0F, 0x00, 0xC0, 0x0F, 0x00, 
-    0x00, 0xC0, 0x0F, 0x00, 0xE0, 0x07, 0x00, 0x00, 0x80, 0x1F, 0x00, 0xE0, 
-    0x03, 0x00, 0x00, 0x00, 0x1F, 0x00, 0xE0, 0x03, 0x00, 0x00, 0x00, 0x1E, 
-    0x00, 0xF0, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF0, 0x01, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0xFF, 0x1F, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x0F, 
-    0x00, 0x00, 0x00, 0x18, 0x00, 0xFE, 0x07, 0x00, 0x00, 0x00, 0x3C, 0x00, 
-    0xFC, 0x03, 0x00, 0x00, 0x00, 0x7E, 0x00, 0xF8, 0x01, 0x00, 0x00, 0x00, 
-    0xFF, 0x00, 0xF0, 0x00, 0x00, 0x00, 0x80, 0xFF, 0x01, 0x60, 0x00, 0x00, 
-    0x00, 0xC0, 0xFF, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3E, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x3E, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3E, 
-    0x00, 0xE0, 0x01, 0x00, 0x00, 0x00, 0x1F, 0x00, 0xE0, 0x03, 0x00, 0x00, 
-    0x00, 0x1F, 0x00, 0xE0, 0x07, 0x00, 0x00, 0x80, 0x1F, 0x00, 0xC0, 0x0F, 
-    0x00, 0x00, 0xC0, 0x0F, 0x00, 0xC0, 0x0F, 0x00, 0x00, 0xC0, 0x0F, 0x00, 
-    0x80, 0x1F, 0x00, 0x00, 0xE0, 0x07, 0x00, 0x00, 0x3F, 0x00, 0x00, 0xF0, 
-    0x03, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFC, 0x03, 0x00, 0x00, 0xFE, 0x01, 
-    0x00, 0xFE, 0x01, 0x00, 0x00, 0xFC, 0x07, 0x80, 0xFF, 0x00, 0x00, 0x00, 
-    0xF8, 0x3F, 0xF0, 0x7F, 0x00, 0x00, 0x00, 0xE0, 0xFF, 0xFF, 0x1F, 0x00, 
-    0x00, 0x00, 0xC0, 0xFF, 0xFF, 0x0F, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 
-    0x03, 0x00, 0x00, 0x00, 0x00, 0xF8, 0x7F, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, };
-
-    // Right arrow bitmap (50x50)
-    #define ARROW_RIGHT_WIDTH 50
-    #define ARROW_RIGHT_HEIGHT 50
-    static const unsigned char arrow_right_bits[] = {
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF8, 0x7F, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0xFF, 0xFF, 0x03, 0x00, 0x00, 0x00, 0xC0, 0xFF, 0xFF, 0x0F, 0x00, 
-    0x00, 0x00, 0xE0, 0xFF, 0xFF, 0x1F, 0x00, 0x00, 0x00, 0xF8, 0x3F, 0xF0, 
-    0x7F, 0x00, 0x00, 0x00, 0xFC, 0x07, 0x80, 0xFF, 0x00, 0x00, 0x00, 0xFE, 
-    0x01, 0x00, 0xFE, 0x01, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFC, 0x03, 0x00, 
-    0x00, 0x3F, 0x00, 0x00, 0xF0, 0x03, 0x00, 0x80, 0x1F, 0x00, 0x00, 0xE0, 
-    0x07, 0x00, 0xC0, 0x0F, 0x00, 0x00, 0xC0, 0x0F, 0x00, 0xC0, 0x0F, 0x00, 
-    0x00, 0xC0, 0x0F, 0x00, 0xE0, 0x07, 0x00, 0x00, 0x80, 0x1F, 0x00, 0xE0, 
-    0x03, 0x00, 0x00, 0x00, 0x1F, 0x00, 0xE0, 0x01, 0x00, 0x00, 0x00, 0x1F, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3E, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x3E, 0x00, 0x00, 0x00, 0x00, 0x00, 0xE0, 0xFF, 0x03, 0x60, 0x00, 
-    0x00, 0x00, 0xC0, 0xFF, 0x03, 0xF0, 0x00, 0x00, 0x00, 0x80, 0xFF, 0x01, 
-    0xF8, 0x01, 0x00, 0x00, 0x00, 0xFF, 0x00, 0xFC, 0x03, 0x00, 0x00, 0x00, 
-    0x7E, 0x00, 0xFE, 0x07, 0x00, 0x00, 0x00, 0x3C, 0x00, 0xFF, 0x0F, 0x00, 
-    0x00, 0x00, 0x18, 0x00, 0xF0, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF0, 
-    0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF0, 0x01, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0xE0, 0x03, 0x00, 0x00, 0x00, 0x1E, 0x00, 0xE0, 0x03, 0x00, 0x00, 
-    0x00, 0x1F, 0x00, 0xE0, 0x07, 0x00, 0x00, 0x80, 0x1F, 0x00, 0xC0, 0x0F, 
-    0x00, 0x00, 0xC0, 0x0F, 0x00, 0xC0, 0x0F, 0x00, 0x00, 0xC0, 0x0F, 0x00, 
-    0x80, 0x1F, 0x00, 0x00, 0xE0, 0x07, 0x00, 0x00, 0x3F, 0x00, 0x00, 0xF0, 
-    0x03, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFC, 0x03, 0x00, 0x00, 0xFE, 0x01, 
-    0x00, 0xFE, 0x01, 0x00, 0x00, 0xFC, 0x07, 0x80, 0xFF, 0x00, 0x00, 0x00, 
-    0xF8, 0x3F, 0xF0, 0x7F, 0x00, 0x00, 0x00, 0xE0, 0xFF, 0xFF, 0x1F, 0x00, 
-    0x00, 0x00, 0xC0, 0xFF, 0xFF, 0x0F, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 
-    0x03, 0x00, 0x00, 0x00, 0x00, 0xF8, 0x7F, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, };
+#include "settings.h"
+#include "version.h"
+#include "text_format.h"
+#include "assets.h"
+#include "render_queue.h"
+#include "st7789_standby.h"
 
 DisplayManager display;
 
 LGFX::LGFX(void) {
+#ifdef HEADLESS_DISPLAY
+    _panel_instance.setBus(&_bus_instance);
+#else
     {
         auto cfg = _bus_instance.config();
         cfg.spi_host = SPI2_HOST;
@@ -91,11 +29,17 @@ LGFX::LGFX(void) {
         _bus_instance.config(cfg);
         _panel_instance.setBus(&_bus_instance);
     }
+#endif
     
     {
         auto cfg = _panel_instance.config();
+#ifdef HEADLESS_DISPLAY
+        cfg.pin_cs = -1;
+        cfg.pin_rst = -1;
+#else
         cfg.pin_cs = LCD_CS;
         cfg.pin_rst = LCD_RST;
+#endif
         cfg.pin_busy = -1;
         cfg.panel_width = 170;
         cfg.panel_height = 320;
@@ -113,393 +57,529 @@ LGFX::LGFX(void) {
         _panel_instance.config(cfg);
     }
     
+#ifndef HEADLESS_DISPLAY
     {
         auto cfg = _light_instance.config();
         cfg.pin_bl = LCD_BL;
         cfg.invert = false;
-        cfg.freq = 44100;
-        cfg.pwm_channel = 0;
+        cfg.freq = LCD_BL_PWM_HZ;
+        cfg.pwm_channel = LCD_BL_PWM_CHANNEL;
         
         _light_instance.config(cfg);
         _panel_instance.setLight(&_light_instance);
     }
+#endif
     
     setPanel(&_panel_instance);
 }
 
-DisplayManager::DisplayManager() {
-    firstDraw = true;
-    lastDrawnSeconds = -1;
-    lastDisplayedAngle = 999;
-    lastStatusColor = 0xFFFF;
-    lastArrowDirection = 999;
+DisplayManager::DisplayManager()
+    : levelCanvas(0, 0, 170, LEVEL_REGION_HEIGHT)
+    , timerCanvas(0, TIMER_REGION_Y, 170, TIMER_REGION_HEIGHT)
+    // Level region (region-local coordinates)
+    , levelBanner(0, 0, 170, LEVEL_REGION_HEIGHT, TFT_BLACK)
+    , angleReadout(0, 15, 170, &levelGlyphs)
+    , levelArrow(60, 10, ASSET_ARROW_LEFT.width, ASSET_ARROW_LEFT.height)
+    , levelBubble(10, 22, 150, 40)
+    , levelLabel((170 - 5 * 12) / 2, 80, 5 * 12, 16, 2)  // "LEVEL" at size 2
+    // Timer region
+    , timerPanel(0, 0, 170, TIMER_REGION_HEIGHT, TFT_BLACK)
+    , stateLabel(10, 10, 150, 8, 1)
+    , timeReadout(0, 50, 170, &timerGlyphs)
+    , progressBar(10, 130, 150, 30)
+    , parLabel(10, 175, 150, 8, 1)
+    , shotBar(10, 160, 150, 10)
+    , shotLabel(10, 184, 150, 8, 1)
+    , versionLabel(10, 300 - TIMER_REGION_Y, 150, 8, 1)
+    , perfLines{{2, 165, 166, 8, 1}, {2, 177, 166, 8, 1},
+                {2, 189, 166, 8, 1}, {2, 201, 166, 8, 1}}
+{
+    asyncPresent = false;
+    fullScreenShown = false;
+    standby = false;
+    perfOverlay = false;
+    bubbleInFlight = false;
+    resetStats();
+    
+    levelBanner.addChild(&angleReadout);
+    levelBanner.addChild(&levelArrow);
+    levelBanner.addChild(&levelBubble);
+    levelBanner.addChild(&levelLabel);
+    levelLabel.setText("LEVEL");
+    
+    timerPanel.addChild(&stateLabel);
+    timerPanel.addChild(&timeReadout);
+    timerPanel.addChild(&progressBar);
+    timerPanel.addChild(&parLabel);
+    timerPanel.addChild(&shotBar);
+    timerPanel.addChild(&shotLabel);
+    timerPanel.addChild(&versionLabel);
+    stateLabel.setColors(TFT_DARKGREY, TFT_BLACK);
+    parLabel.setColors(TFT_DARKGREY, TFT_BLACK);
+    shotLabel.setColors(COLOR_CYAN, TFT_BLACK);
+    shotBar.setVisible(false);
+    shotLabel.setVisible(false);
+    versionLabel.setColors(TFT_DARKGREY, TFT_BLACK);
+    versionLabel.setText("Stage Timer v" VERSION_STRING);
+    
+    for (int i = 0; i < PERF_LINES; i++) {
+        timerPanel.addChild(&perfLines[i]);
+        perfLines[i].setColors(COLOR_CYAN, TFT_BLACK);
+        perfLines[i].setVisible(false);
+    }
 }
 
 void DisplayManager::begin() {
     tft.init();
     tft.setRotation(0);
     tft.fillScreen(TFT_BLACK);
+    renderQueue.begin(&tft);
+    
+    // Off-screen regions (~36KB + ~72KB at 16 bpp, a quarter at 4 bpp)
+    levelCanvas.begin(&tft, CANVAS_BPP);
+    timerCanvas.begin(&tft, CANVAS_BPP);
+    
+    // Pre-rasterized large digits (PSRAM if available)
+    levelGlyphs.begin();
+    timerGlyphs.begin();
+    
+    // Queue tile pushes on the SPI DMA so rendering never waits on the bus
+    setAsyncPresent(true);
 }
 
 void DisplayManager::setBrightness(int brightness) {
     tft.setBrightness(brightness);
 }
 
-void DisplayManager::drawLevelIndicator(float angle, uint16_t color, const char* status) {
-    // Clear and redraw full level area
-    tft.fillRect(0, 0, 170, 107, color);
+void DisplayManager::sleep() {
+    tft.sleep();
+}
+
+void DisplayManager::wakeup() {
+    tft.wakeup();
+}
+
+void DisplayManager::present() {
+    unsigned long t0 = micros();
+    
+    // A full screen covered both regions - their canvases are intact,
+    // the panel just needs every tile again
+    if (fullScreenShown) {
+        invalidate();
+        fullScreenShown = false;
+    }
     
-    // Choose display mode
-    if (settings.levelDisplayMode == LEVEL_DISPLAY_DEGREES) {
-        // DEGREES MODE - Smart formatting
-        tft.setTextSize(5);
-        if (color == COLOR_GREEN || color == COLOR_CYAN) {
-            tft.setTextColor(TFT_BLACK);
-        } else {
-            tft.setTextColor(TFT_WHITE);
-        }
-        
-        // Smart formatting: show tenths only when < 10 degrees
-        char buf[10];
-        if (fabs(angle) < 10.0) {
-            sprintf(buf, "%.1f", angle);  // Show tenths: 1.1, 5.3, 9.9
+    stats.widgetsPainted += levelBanner.paint(levelCanvas);
+    uint32_t bytes = levelCanvas.present();
+    
+    // Time the bubble's way to the glass (for the latency compensation)
+    if (bytes > 0 && levelBubble.isVisible()) {
+        levelPredictor.frameQueued();
+        if (asyncPresent) {
+            bubbleInFlight = true;
         } else {
-            sprintf(buf, "%.0f", angle);  // No decimal: 10, 59, 134
+            levelPredictor.frameSent(micros());
         }
-        
-        int textWidth = strlen(buf) * 30;
-        int x = (170 - textWidth) / 2;
-        
-        tft.setCursor(x, 15);
-        tft.print(buf);
-        
-    } else {
-        // ARROW MODE - Draw directional arrow
-        drawDirectionalArrow(angle);
     }
     
-    // Draw status text (only show "LEVEL" when centered, no CW/CCW)
-    if (color == COLOR_GREEN || color == COLOR_CYAN) {
-        tft.setTextSize(2);
-        tft.setTextColor(TFT_BLACK);
-        int statusWidth = 5 * 12;  // "LEVEL" is 5 chars
-        tft.setCursor((170 - statusWidth) / 2, 80);
-        tft.println("LEVEL");
+    // The timer face is frozen in standby; its widgets catch up afterwards
+    if (!standby) {
+        stats.widgetsPainted += timerPanel.paint(timerCanvas);
+        bytes += timerCanvas.present();
+    }
+    
+    stats.frames++;
+    stats.totalBytes += bytes;
+    stats.lastFrameBytes = bytes;
+    if (bytes > stats.peakFrameBytes) {
+        stats.peakFrameBytes = bytes;
     }
-    // No text when red/blue - arrow/color shows direction
     
-    lastStatusColor = color;
-    lastDisplayedAngle = angle;
+    uint32_t frameUs = micros() - t0;
+    if (frameUs > stats.maxFrameUs) {
+        stats.maxFrameUs = frameUs;
+    }
+    if (frameUs > FRAME_BUDGET_US) {
+        stats.overBudgetFrames++;
+    }
 }
 
-void DisplayManager::updateLevelAngle(float angle, uint16_t color) {
-    if (settings.levelDisplayMode == LEVEL_DISPLAY_DEGREES) {
-        // DEGREES MODE - update if angle changed enough
-        if (abs(angle - lastDisplayedAngle) > 0.05) {
-            tft.fillRect(0, 10, 170, 60, color);
-            
-            tft.setTextSize(5);
-            if (color == COLOR_GREEN || color == COLOR_CYAN) {
-                tft.setTextColor(TFT_BLACK);
-            } else {
-                tft.setTextColor(TFT_WHITE);
-            }
-            
-            char buf[10];
-            if (fabs(angle) < 10.0) {
-                sprintf(buf, "%.1f", angle);
-            } else {
-                sprintf(buf, "%.0f", angle);
-            }
-            
-            int textWidth = strlen(buf) * 30;
-            int x = (170 - textWidth) / 2;
-            
-            tft.setCursor(x, 15);
-            tft.print(buf);
-            
-            lastDisplayedAngle = angle;
+void DisplayManager::invalidate() {
+    // Also drops queued DMA runs so they can't land on top of a direct draw,
+    // and the rest of a half-drawn queued screen
+    levelCanvas.discardPending();
+    timerCanvas.discardPending();
+    renderQueue.clear();
+    bubbleInFlight = false;
+}
+
+bool DisplayManager::setAsyncPresent(bool enable) {
+    if (enable == asyncPresent) return true;
+    
+    if (enable) {
+        if (!levelCanvas.setAsync(true) || !timerCanvas.setAsync(true)) {
+            levelCanvas.setAsync(false);
+            timerCanvas.setAsync(false);
+            Serial.println("Display: DMA staging unavailable, using blocking pushes");
+            return false;
         }
+        // Keep the bus transaction open - endWrite() would wait for the DMA
+        tft.startWrite();
     } else {
-        // ARROW MODE - Only redraw when direction changes
-        
-        // Determine current arrow direction
-        int currentDirection;
-        if (fabs(angle) < 0.3) {
-            currentDirection = 0;  // Center (level)
-        } else if (angle > 0) {
-            currentDirection = -1; // Left arrow (CW tilt)
-        } else {
-            currentDirection = 1;  // Right arrow (CCW tilt)
-        }
-        
-        // Only redraw if direction changed (eliminates flicker!)
-        if (currentDirection != lastArrowDirection) {
-            tft.fillRect(0, 10, 170, 60, color);
-            drawDirectionalArrow(angle);
-            lastArrowDirection = currentDirection;
-            lastDisplayedAngle = angle;
-        }
+        levelCanvas.setAsync(false);
+        timerCanvas.setAsync(false);
+        tft.endWrite();
     }
+    
+    asyncPresent = enable;
+    Serial.printf("Display: %s presentation\n", enable ? "async DMA" : "blocking");
+    return true;
 }
 
-void DisplayManager::drawDirectionalArrow(float angle) {
-    // Arrow is always white regardless of background color
-    tft.setTextColor(TFT_WHITE);
-    
-    // Center position for arrow
-    int centerX = 85;  // 170 / 2
-    int centerY = 35;  // Middle of upper section
-    
-    // Determine arrow direction
-    // If angle is positive (CW), arrow points CCW (left)
-    // If angle is negative (CCW), arrow points CW (right)
-    // If near zero, show checkmark or no arrow
-    
-    if (fabs(angle) < 0.3) {
-        // Near level - draw checkmark or level symbol
-        drawCheckmark(centerX, centerY);
-    } else if (angle > 0) {
-        // Tilted CW - show arrow pointing CCW (left)
-        drawCurvedArrow(centerX, centerY, true);  // true = left
-    } else {
-        // Tilted CCW - show arrow pointing CW (right)
-        drawCurvedArrow(centerX, centerY, false);  // false = right
+bool DisplayManager::service() {
+    if (!asyncPresent) return true;
+    
+    // Level strip first - it is the most latency sensitive
+    if (levelCanvas.service()) {
+        if (bubbleInFlight) {
+            levelPredictor.frameSent(micros());
+            bubbleInFlight = false;
+        }
+        return timerCanvas.service();
     }
+    return false;
 }
 
-
-void DisplayManager::drawCurvedArrow(int cx, int cy, bool pointLeft) {
-    if (pointLeft) {
-        tft.drawXBitmap(
-            cx - ARROW_LEFT_WIDTH/2, 
-            cy - ARROW_LEFT_HEIGHT/2,
-            arrow_left_bits,
-            ARROW_LEFT_WIDTH,
-            ARROW_LEFT_HEIGHT,
-            TFT_WHITE
-        );
-    } else {
-        tft.drawXBitmap(
-            cx - ARROW_RIGHT_WIDTH/2,
-            cy - ARROW_RIGHT_HEIGHT/2,
-            arrow_right_bits,
-            ARROW_RIGHT_WIDTH,
-            ARROW_RIGHT_HEIGHT,
-            TFT_WHITE
-        );
+void DisplayManager::recordBlockTime(uint32_t us) {
+    if (us > stats.maxBlockUs) {
+        stats.maxBlockUs = us;
     }
 }
 
-void DisplayManager::drawCheckmark(int cx, int cy) {
-    // Do nothing, leave screen green when level
+void DisplayManager::resetStats() {
+    stats.frames = 0;
+    stats.totalBytes = 0;
+    stats.lastFrameBytes = 0;
+    stats.peakFrameBytes = 0;
+    stats.maxBlockUs = 0;
+    stats.widgetsPainted = 0;
+    stats.maxFrameUs = 0;
+    stats.overBudgetFrames = 0;
 }
 
-void DisplayManager::drawProgressBar(int x, int y, int width, int height, float percentage, uint16_t color) {
-    tft.drawRect(x, y, width, height, TFT_DARKGREY);
+void DisplayManager::setLevel(float angle, uint16_t color, float rateDps, uint32_t sampleUs) {
+    bool centered = (color == COLOR_GREEN || color == COLOR_CYAN);
+    uint16_t textColor = centered ? TFT_BLACK : TFT_WHITE;
     
-    int fillWidth = (int)((width - 4) * percentage);
-    if (fillWidth > 0) {
-        tft.fillRect(x + 2, y + 2, fillWidth, height - 4, color);
-    }
+    // Colour change repaints the whole banner (children follow)
+    levelBanner.setColor(color);
+    
+    // "LEVEL" only when centred - no text when red/blue, the colour shows direction
+    levelLabel.setColors(TFT_BLACK, color);
+    levelLabel.setVisible(centered);
     
-    int remainWidth = (width - 4) - fillWidth;
-    if (remainWidth > 0) {
-        tft.fillRect(x + 2 + fillWidth, y + 2, remainWidth, height - 4, TFT_BLACK);
+    if (settings.levelDisplayMode == LEVEL_DISPLAY_DEGREES) {
+        // DEGREES MODE - tenths below 10 degrees (1.1, 5.3 / 10, 59, 134).
+        // Repaints only when the displayed text changes.
+        char buf[10];
+        formatAngle(buf, angle);
+        angleReadout.setText(buf);
+        angleReadout.setColors(textColor, color);
+        angleReadout.setVisible(true);
+        levelArrow.setVisible(false);
+        levelBubble.setVisible(false);
+    } else if (settings.levelDisplayMode == LEVEL_DISPLAY_BUBBLE) {
+        // BUBBLE MODE - redrawn every frame the bubble moves a pixel, at the
+        // angle expected by the time the frame is on the glass
+        levelBubble.setScale(BUBBLE_RANGE_DEG, settings.profile->tolerance);
+        levelBubble.setAngle(levelPredictor.predict(angle, rateDps, sampleUs, micros()));
+        levelBubble.setVisible(true);
+        angleReadout.setVisible(false);
+        levelArrow.setVisible(false);
+    } else {
+        // ARROW MODE - repaints only when the direction changes.
+        // Tilted CW -> arrow points CCW (left), tilted CCW -> points CW (right),
+        // near level -> nothing, the green banner says it all.
+        if (fabs(angle) < 0.3) {
+            levelArrow.setBitmap(nullptr);
+        } else if (angle > 0) {
+            levelArrow.setBitmap(&ASSET_ARROW_LEFT);
+        } else {
+            levelArrow.setBitmap(&ASSET_ARROW_RIGHT);
+        }
+        // Arrow is always white regardless of background color
+        levelArrow.setColors(TFT_WHITE, color);
+        levelArrow.setVisible(true);
+        angleReadout.setVisible(false);
+        levelBubble.setVisible(false);
     }
 }
 
-void DisplayManager::drawTimerDisplay(int remainingSeconds, float percentage, uint16_t timerColor, const char* stateText) {
-    int timerY = 107;
+void DisplayManager::setTimer(uint32_t remainingMs, bool running, float percentage, uint16_t timerColor, const char* stateText) {
+    char buf[24];
+    
+    stateLabel.setText(stateText);
     
-    // Clear if seconds changed
-    if (remainingSeconds != lastDrawnSeconds) {
-        tft.fillRect(0, timerY, 170, 213, TFT_BLACK);
-        lastDrawnSeconds = remainingSeconds;
+    if (running && settings.timerFineDigits > 0 && remainingMs < FINE_TIME_BELOW_MS) {
+        formatFineTime(buf, remainingMs, settings.timerFineDigits);
+    } else {
+        // Whole seconds round up: 0:01 until the very end
+        formatTime(buf, (remainingMs + 999) / 1000);
     }
+    timeReadout.setText(buf);
+    timeReadout.setColors(timerColor, TFT_BLACK);
+    
+    progressBar.setValue(percentage, timerColor);
     
-    // Draw state text
-    tft.setTextSize(1);
-    tft.setTextColor(TFT_DARKGREY);
-    tft.setCursor(10, timerY + 10);
-    tft.println(stateText);
-    
-    // Draw large time
-    tft.setTextSize(5);
-    tft.setTextColor(timerColor);
-    
-    int minutes = remainingSeconds / 60;
-    int seconds = remainingSeconds % 60;
-    
-    char timeStr[10];
-    sprintf(timeStr, "%d:%02d", minutes, seconds);
-    
-    int textWidth = strlen(timeStr) * 30;
-    int x = (170 - textWidth) / 2;
-    tft.setCursor(x, timerY + 50);
-    tft.print(timeStr);
-    
-    // Draw progress bar
-    drawProgressBar(10, timerY + 130, 150, 30, percentage, timerColor);
-    
-    // Draw par time reference
-    tft.setTextSize(1);
-    tft.setTextColor(TFT_DARKGREY);
-    tft.setCursor(10, timerY + 175);
-    tft.print("Par: ");
-    tft.print(settings.parTimeSeconds);
-    tft.print("s");
-    
-    // Draw version at bottom
-    if (firstDraw) {
-        tft.setTextSize(1);
-        tft.setTextColor(TFT_DARKGREY);
-        tft.setCursor(10, 300);
-        tft.println("Stage Timer v3.3");
-        firstDraw = false;
+    // Par time can change in the menu
+    strcpy(buf, "Par: ");
+    int len = 5 + formatInt(buf + 5, settings.profile->parTimeSeconds);
+    strcpy(buf + len, "s");
+    parLabel.setText(buf);
+}
+
+void DisplayManager::setShots(const ShotLog* log) {
+    bool show = log != nullptr && !perfOverlay;
+    shotBar.setVisible(show);
+    shotLabel.setVisible(show);
+    if (!show) return;
+    
+    // Counters are kept up to date by the log - nothing to rescan
+    int expected = log->getExpected();
+    float filled = expected > 0 ? (float)log->getShots() / expected : 0;
+    shotBar.setValue(min(filled, 1.0f), log->getShotsRemaining() == 0 ? COLOR_GREEN : COLOR_CYAN);
+    
+    // "3/10 1st 1.82 best 0.95"
+    char buf[48];
+    int len = formatInt(buf, log->getShots());
+    buf[len++] = '/';
+    len += formatInt(buf + len, expected);
+    if (log->getShots() > 0) {
+        strcpy(buf + len, " 1st ");
+        len += 5;
+        len += formatFineTime(buf + len, log->getFirstShotUs() / 1000, 2);
+    }
+    if (log->getShots() > 1) {
+        strcpy(buf + len, " best ");
+        len += 6;
+        len += formatFineTime(buf + len, log->getFastestSplitUs() / 1000, 2);
     }
+    shotLabel.setText(buf);
+}
+
+void DisplayManager::showPerfOverlay(bool show) {
+    perfOverlay = show;
+    if (show) {
+        shotBar.setVisible(false);
+        shotLabel.setVisible(false);
+    }
+    parLabel.setVisible(!show);
+    versionLabel.setVisible(!show);
+    for (int i = 0; i < PERF_LINES; i++) {
+        perfLines[i].setVisible(show);
+    }
+}
+
+void DisplayManager::setPerfLine(int line, const char* text) {
+    if (line < 0 || line >= PERF_LINES) return;
+    perfLines[line].setText(text);
 }
 
-void DisplayManager::drawShooterReady() {
+void DisplayManager::showShooterReady() {
+    if (fullScreenShown) return;
+    
+    // Straight to the panel - queued tiles must not land on top. The
+    // render queue spreads the full-screen fill over several passes.
+    invalidate();
+    fullScreenShown = true;
+    
     // Full screen yellow with black text
-    tft.fillScreen(COLOR_YELLOW);
+    renderQueue.fillScreen(COLOR_YELLOW);
     
     // Large "SHOOTER READY" text
-    tft.setTextSize(3);
-    tft.setTextColor(TFT_BLACK);
+    renderQueue.setTextSize(3);
+    renderQueue.setTextColor(TFT_BLACK);
     
     // Center "SHOOTER" on line 1
-    tft.setCursor(10, 100);
-    tft.println("SHOOTER");
+    renderQueue.setCursor(10, 100);
+    renderQueue.println("SHOOTER");
     
     // Center "READY" on line 2
-    tft.setCursor(30, 140);
-    tft.println("READY");
+    renderQueue.setCursor(30, 140);
+    renderQueue.println("READY");
     
     // Instructions at bottom
-    tft.setTextSize(2);
-    tft.setCursor(15, 240);
-    tft.println("Press to");
-    tft.setCursor(30, 265);
-    tft.println("START");
-    
-    // Force redraw flag reset so next state redraws completely
-    firstDraw = true;
-    lastDrawnSeconds = -1;
-    lastDisplayedAngle = 999;
-    lastStatusColor = 0xFFFF;
+    renderQueue.setTextSize(2);
+    renderQueue.setCursor(15, 240);
+    renderQueue.println("Press to");
+    renderQueue.setCursor(30, 265);
+    renderQueue.println("START");
 }
 
-void DisplayManager::drawMicDiagnostics(float magnitude, float threshold, float noiseFloor, 
-                                        float peakMag, float avgMag, int detections) {
-    // Clear screen
-    tft.fillScreen(TFT_BLACK);
+void DisplayManager::setStandby(bool on) {
+    if (on == standby) return;
+    standby = on;
+    
+    if (on) {
+        // Last timer face before freezing it. Dark grey has no colour MSBs
+        // and would vanish in 8-colour idle mode.
+        stateLabel.setText("Standby");
+        stateLabel.setColors(TFT_WHITE, TFT_BLACK);
+        stats.widgetsPainted += timerPanel.paint(timerCanvas);
+        stats.totalBytes += timerCanvas.present();
+        
+        tft.startWrite();
+        writeStandbyOn(tft, STANDBY_ROWS);
+        tft.endWrite();
+    } else {
+        // Controller RAM kept everything outside the partial area, so the
+        // full panel comes back as it was; present() repaints what changed
+        tft.startWrite();
+        writeStandbyOff(tft);
+        tft.endWrite();
+        
+        stateLabel.setColors(TFT_DARKGREY, TFT_BLACK);
+    }
+    
+    Serial.printf("Display: standby %s\n", on ? "on" : "off");
+}
+
+bool DisplayManager::setCanvasDepth(int bpp) {
+    if (bpp != 16 && bpp != 8 && bpp != 4) return false;
+    
+    bool ok = levelCanvas.setColorDepth(bpp) && timerCanvas.setColorDepth(bpp);
+    if (!ok) {
+        // Keep both regions at the same depth
+        levelCanvas.setColorDepth(timerCanvas.getColorDepth());
+    }
+    
+    // Fresh canvases are black - every widget paints again
+    levelBanner.invalidate();
+    timerPanel.invalidate();
     
-    // Title
-    tft.setTextSize(2);
-    tft.setTextColor(COLOR_CYAN);
-    tft.setCursor(10, 10);
-    tft.println("MIC DIAGNOSTIC");
-    
-    // Current magnitude - large display
-    tft.setTextSize(1);
-    tft.setTextColor(TFT_WHITE);
-    tft.setCursor(10, 40);
-    tft.print("Magnitude:");
-    
-    tft.setTextSize(3);
-    tft.setTextColor(COLOR_CYAN);
-    tft.setCursor(10, 55);
-    tft.printf("%.0f", magnitude);
-    
-    // Bar graph for magnitude (0-5000 scale)
-    int barY = 95;
-    int barHeight = 25;
-    int barMaxWidth = 150;
-    
-    // Background bar
-    tft.fillRect(10, barY, barMaxWidth, barHeight, TFT_DARKGREY);
-    
-    // Magnitude bar (green if below threshold, red if above)
-    float normalizedMag = constrain(magnitude / 5000.0, 0.0, 1.0);
-    int magBarWidth = (int)(barMaxWidth * normalizedMag);
-    uint16_t barColor = (magnitude > threshold) ? COLOR_RED : COLOR_GREEN;
-    
-    if (magBarWidth > 0) {
-        tft.fillRect(10, barY, magBarWidth, barHeight, barColor);
+    Serial.printf("Display: canvases at %d bpp%s\n", levelCanvas.getColorDepth(),
+                  ok ? "" : " (allocation failed)");
+    return ok;
+}
+
+void DisplayManager::printCanvasReport() {
+    TileCanvas* canvases[] = {&levelCanvas, &timerCanvas};
+    const char* names[] = {"level", "timer"};
+    uint32_t totalBytes = 0;
+    
+    for (int i = 0; i < 2; i++) {
+        TileCanvas& c = *canvases[i];
+        totalBytes += c.spriteBytes();
+        Serial.printf("Canvas %s %dx%d: %d bpp, %lu B", names[i], c.width(), c.height(),
+                      c.getColorDepth(), (unsigned long)c.spriteBytes());
+        if (c.isIndexed()) {
+            Serial.printf(", %d/%d palette slots", c.paletteUsed(), 1 << c.getColorDepth());
+        }
+        Serial.println();
     }
     
-    // Threshold line
-    float normalizedThresh = constrain(threshold / 5000.0, 0.0, 1.0);
-    int threshX = 10 + (int)(barMaxWidth * normalizedThresh);
-    tft.drawFastVLine(threshX, barY - 5, barHeight + 10, COLOR_YELLOW);
-    tft.drawFastVLine(threshX + 1, barY - 5, barHeight + 10, COLOR_YELLOW);
-    
-    // Detection flash
-    if (magnitude > threshold) {
-        tft.setTextSize(2);
-        tft.setTextColor(COLOR_RED);
-        tft.setCursor(15, 130);
-        tft.println("DETECTED!");
+    // Full push of both regions: hashing, expansion to RGB565 and the bus
+    unsigned long t0 = micros();
+    levelCanvas.invalidate();
+    timerCanvas.invalidate();
+    uint32_t bytes = levelCanvas.present() + timerCanvas.present();
+    while (!(levelCanvas.service() && timerCanvas.service())) {
+    }
+    tft.waitDMA();
+    unsigned long pushUs = micros() - t0;
+    
+    Serial.printf("Canvas: %lu B RAM total, full push %lu us (%lu B)\n",
+                  (unsigned long)totalBytes, (unsigned long)pushUs, (unsigned long)bytes);
+}
+
+void DisplayManager::runRenderBenchmark() {
+    const int ITERATIONS = 200;
+    
+    // Scratch sprite the size of a readout band - the live canvases stay untouched
+    LGFX_Sprite scratch;
+    scratch.setColorDepth(16);
+    if (scratch.createSprite(170, GlyphCache::GLYPH_H) == nullptr) {
+        Serial.println("Bench: scratch sprite allocation failed");
+        return;
     }
     
-    // Statistics section
-    int statsY = 160;
-    tft.setTextSize(1);
-    tft.setTextColor(TFT_LIGHTGREY);
-    
-    tft.setCursor(10, statsY);
-    tft.print("Threshold:");
-    tft.setTextColor(COLOR_YELLOW);
-    tft.printf(" %.0f", threshold);
-    
-    tft.setTextColor(TFT_LIGHTGREY);
-    tft.setCursor(10, statsY + 15);
-    tft.print("Noise Floor:");
-    tft.setTextColor(TFT_WHITE);
-    tft.printf(" %.0f", noiseFloor);
-    
-    tft.setTextColor(TFT_LIGHTGREY);
-    tft.setCursor(10, statsY + 30);
-    tft.print("Peak:");
-    tft.setTextColor(TFT_WHITE);
-    tft.printf(" %.0f", peakMag);
-    
-    tft.setTextColor(TFT_LIGHTGREY);
-    tft.setCursor(10, statsY + 45);
-    tft.print("Average:");
-    tft.setTextColor(TFT_WHITE);
-    tft.printf(" %.0f", avgMag);
-    
-    tft.setTextColor(TFT_LIGHTGREY);
-    tft.setCursor(10, statsY + 60);
-    tft.print("Detections:");
-    tft.setTextColor(TFT_WHITE);
-    tft.printf(" %d", detections);
-    
-    // Signal to Noise Ratio
-    if (noiseFloor > 0) {
-        float snr = peakMag / noiseFloor;
-        tft.setTextColor(TFT_LIGHTGREY);
-        tft.setCursor(10, statsY + 75);
-        tft.print("SNR:");
+    GlyphCache glyphs;
+    if (!glyphs.begin()) {
+        scratch.deleteSprite();
+        return;
+    }
+    
+    struct Readout {
+        const char* name;
+        uint16_t fg;
+        uint16_t bg;
+    };
+    const Readout readouts[] = {
+        {"timer", COLOR_WHITE, TFT_BLACK},
+        {"angle", TFT_WHITE, COLOR_RED},
+    };
+    
+    for (const Readout& r : readouts) {
+        bool isTimer = (r.name[0] == 't');
+        char buf[10];
         
-        // Color code SNR: green > 10, yellow > 5, red < 5
-        if (snr > 10) {
-            tft.setTextColor(COLOR_GREEN);
-        } else if (snr > 5) {
-            tft.setTextColor(COLOR_YELLOW);
-        } else {
-            tft.setTextColor(COLOR_RED);
+        // Old path: sprintf + scaled font rasterization
+        unsigned long t0 = micros();
+        for (int i = 0; i < ITERATIONS; i++) {
+            if (isTimer) {
+                int secs = 599 - (i % 600);
+                sprintf(buf, "%d:%02d", secs / 60, secs % 60);
+            } else {
+                float a = -9.0f + (i % 180) * 0.1f;
+                sprintf(buf, "%.1f", a);
+            }
+            scratch.fillScreen(r.bg);
+            scratch.setTextSize(5);
+            scratch.setTextColor(r.fg);
+            scratch.setCursor(0, 0);
+            scratch.print(buf);
         }
-        tft.printf(" %.1f:1", snr);
+        unsigned long fontUs = micros() - t0;
+        
+        // New path: integer formatter + glyph row copies
+        glyphs.setColors(r.fg, r.bg);
+        t0 = micros();
+        for (int i = 0; i < ITERATIONS; i++) {
+            if (isTimer) {
+                formatTime(buf, 599 - (i % 600));
+            } else {
+                formatAngle(buf, -9.0f + (i % 180) * 0.1f);
+            }
+            scratch.fillScreen(r.bg);
+            glyphs.drawString(scratch, 0, 0, buf);
+        }
+        unsigned long glyphUs = micros() - t0;
+        
+        Serial.printf("Bench %s readout: font %.1f us, glyph cache %.1f us per frame\n",
+                      r.name, fontUs / (float)ITERATIONS, glyphUs / (float)ITERATIONS);
     }
     
-    // Instructions at bottom
-    tft.setTextSize(1);
-    tft.setTextColor(TFT_DARKGREY);
-    tft.setCursor(10, 285);
-    tft.println("Turn: Adj Threshold");
-    tft.setCursor(10, 300);
-    tft.println("Press: Exit");
-}
\ No newline at end of file
+    scratch.deleteSprite();
+    
+    // Build-time assets: flash footprint and RLE blit time into a sprite
+    for (int a = 0; a < ASSET_COUNT; a++) {
+        const RleAsset& asset = *ASSET_LIST[a];
+        uint32_t flashBytes = asset.dataSize + asset.paletteSize * sizeof(uint16_t);
+        uint32_t rawBytes = (uint32_t)asset.width * asset.height * 2;
+        
+        if (scratch.createSprite(asset.width, asset.height) == nullptr) {
+            Serial.println("Bench: scratch sprite allocation failed");
+            return;
+        }
+        unsigned long t0 = micros();
+        for (int i = 0; i < ITERATIONS; i++) {
+            drawRleAsset(scratch, 0, 0, asset);
+        }
+        unsigned long rleUs = micros() - t0;
+        scratch.deleteSprite();
+        
+        Serial.printf("Bench asset %s %dx%d: %lu B flash (RGB565 %lu B), blit %.1f us\n",
+                      asset.name, asset.width, asset.height,
+                      (unsigned long)flashBytes, (unsigned long)rawBytes, rleUs / (float)ITERATIONS);
+    }
+}
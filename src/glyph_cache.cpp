@@ -0,0 +1,142 @@
+#include "glyph_cache.h"
+#include <esp_heap_caps.h>
+
+static const char GLYPH_CHARS[GlyphCache::GLYPH_COUNT + 1] = "0123456789:-.";
+
+GlyphCache::GlyphCache() {
+    glyphs = nullptr;
+    fgColor = 0;
+    bgColor = 0;
+    rasterized = false;
+    rasterizeCount = 0;
+}
+
+bool GlyphCache::begin() {
+    size_t bytes = GLYPH_COUNT * GLYPH_W * GLYPH_H * sizeof(uint16_t);
+
+    glyphs = (uint16_t*)heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (!glyphs) {
+        glyphs = (uint16_t*)heap_caps_malloc(bytes, MALLOC_CAP_8BIT);
+    }
+    if (!glyphs) {
+        Serial.println("WARNING: Glyph cache allocation failed, using font rendering");
+        return false;
+    }
+    return true;
+}
+
+int GlyphCache::glyphIndex(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c == ':') return 10;
+    if (c == '-') return 11;
+    if (c == '.') return 12;
+    return -1;
+}
+
+void GlyphCache::setColors(uint16_t fg, uint16_t bg) {
+    if (!glyphs) return;
+    if (rasterized && fg == fgColor && bg == bgColor) return;
+
+    fgColor = fg;
+    bgColor = bg;
+    rasterize();
+}
+
+void GlyphCache::rasterize() {
+    // Render each glyph once with the normal font path into a scratch
+    // sprite; sprite memory is already panel byte order, same as the canvas
+    LGFX_Sprite cell;
+    cell.setColorDepth(16);
+    if (cell.createSprite(GLYPH_W, GLYPH_H) == nullptr) return;
+
+    cell.setTextSize(TEXT_SIZE);
+    cell.setTextColor(fgColor, bgColor);
+
+    for (int i = 0; i < GLYPH_COUNT; i++) {
+        cell.fillScreen(bgColor);
+        cell.setCursor(0, 0);
+        cell.print(GLYPH_CHARS[i]);
+        memcpy(&glyphs[i * GLYPH_W * GLYPH_H], cell.getBuffer(),
+               GLYPH_W * GLYPH_H * sizeof(uint16_t));
+    }
+
+    cell.deleteSprite();
+    rasterized = true;
+    rasterizeCount++;
+}
+
+int GlyphCache::drawString(LGFX_Sprite& dst, int x, int y, const char* text) const {
+    if (!glyphs || !rasterized) return 0;
+
+    uint16_t* buf = (uint16_t*)dst.getBuffer();
+    int dstW = dst.width();
+    int dstH = dst.height();
+    int startX = x;
+
+    for (const char* p = text; *p; p++, x += GLYPH_W) {
+        int index = glyphIndex(*p);
+        if (index < 0) continue;
+
+        // Clip to the sprite
+        int x0 = max(x, 0);
+        int x1 = min(x + GLYPH_W, dstW);
+        if (x0 >= x1) continue;
+
+        const uint16_t* glyph = &glyphs[index * GLYPH_W * GLYPH_H];
+        for (int row = 0; row < GLYPH_H; row++) {
+            int dy = y + row;
+            if (dy < 0 || dy >= dstH) continue;
+            memcpy(&buf[dy * dstW + x0], &glyph[row * GLYPH_W + (x0 - x)],
+                   (x1 - x0) * sizeof(uint16_t));
+        }
+    }
+
+    return x - startX;
+}
+
+int GlyphCache::drawStringIndexed(LGFX_Sprite& dst, int x, int y, const char* text,
+                                  uint8_t fgIndex, uint8_t bgIndex) const {
+    if (!glyphs || !rasterized) return 0;
+
+    int bits = dst.getColorDepth() & 0xFF;
+    if (bits != 8 && bits != 4) return 0;
+
+    uint8_t* buf = (uint8_t*)dst.getBuffer();
+    int dstW = dst.width();
+    int dstH = dst.height();
+    int stride = (dstW * bits + 7) / 8;
+    int startX = x;
+
+    // Glyph pixels are stored in panel byte order
+    uint16_t fgRaw = (fgColor >> 8) | (fgColor << 8);
+
+    for (const char* p = text; *p; p++, x += GLYPH_W) {
+        int index = glyphIndex(*p);
+        if (index < 0) continue;
+
+        int x0 = max(x, 0);
+        int x1 = min(x + GLYPH_W, dstW);
+        if (x0 >= x1) continue;
+
+        const uint16_t* glyph = &glyphs[index * GLYPH_W * GLYPH_H];
+        for (int row = 0; row < GLYPH_H; row++) {
+            int dy = y + row;
+            if (dy < 0 || dy >= dstH) continue;
+
+            uint8_t* line = buf + dy * stride;
+            const uint16_t* src = &glyph[row * GLYPH_W];
+            for (int px = x0; px < x1; px++) {
+                uint8_t v = (src[px - x] == fgRaw) ? fgIndex : bgIndex;
+                if (bits == 8) {
+                    line[px] = v;
+                } else if (px & 1) {
+                    line[px >> 1] = (line[px >> 1] & 0xF0) | v;
+                } else {
+                    line[px >> 1] = (line[px >> 1] & 0x0F) | (v << 4);
+                }
+            }
+        }
+    }
+
+    return x - startX;
+}
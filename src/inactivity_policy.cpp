@@ -0,0 +1,64 @@
+#include "inactivity_policy.h"
+
+InactivityPolicy::InactivityPolicy() {
+    state = POWER_ACTIVE;
+    inhibited = false;
+    lastActivityMs = 0;
+    lightSleepAfterMs = 0;
+    deepSleepAfterMs = 0;
+}
+
+void InactivityPolicy::configure(uint32_t lightAfterMs, uint32_t deepAfterMs) {
+    lightSleepAfterMs = lightAfterMs;
+    deepSleepAfterMs = deepAfterMs;
+}
+
+void InactivityPolicy::notifyActivity(uint32_t nowMs) {
+    lastActivityMs = nowMs;
+    state = POWER_ACTIVE;
+}
+
+void InactivityPolicy::setInhibited(bool inhibit, uint32_t nowMs) {
+    if (inhibit == inhibited) return;
+    inhibited = inhibit;
+
+    // Both edges count as activity: entering means the user is busy,
+    // leaving means the idle countdown starts from here
+    notifyActivity(nowMs);
+}
+
+PowerAction InactivityPolicy::update(uint32_t nowMs) {
+    if (inhibited) return POWER_ACTION_NONE;
+
+    uint32_t idle = getIdleMs(nowMs);
+
+    // Deep sleep can be reached straight from ACTIVE if light sleep is disabled
+    if (deepSleepAfterMs > 0 && idle >= deepSleepAfterMs && state != POWER_DEEP_SLEEP) {
+        state = POWER_DEEP_SLEEP;
+        return POWER_ACTION_DEEP_SLEEP;
+    }
+
+    if (lightSleepAfterMs > 0 && idle >= lightSleepAfterMs && state == POWER_ACTIVE) {
+        state = POWER_LIGHT_SLEEP;
+        return POWER_ACTION_LIGHT_SLEEP;
+    }
+
+    return POWER_ACTION_NONE;
+}
+
+uint32_t InactivityPolicy::msUntilNextTransition(uint32_t nowMs) const {
+    if (inhibited || state == POWER_DEEP_SLEEP) return UINT32_MAX;
+
+    uint32_t idle = getIdleMs(nowMs);
+    uint32_t target;
+
+    if (state == POWER_ACTIVE && lightSleepAfterMs > 0) {
+        target = lightSleepAfterMs;
+    } else if (deepSleepAfterMs > 0) {
+        target = deepSleepAfterMs;
+    } else {
+        return UINT32_MAX;
+    }
+
+    return (idle >= target) ? 0 : (target - idle);
+}
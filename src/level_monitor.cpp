@@ -17,6 +17,9 @@ LevelMonitor::LevelMonitor() {
     qmi = nullptr;
     leds = nullptr;
     lastUpdateTime = 0;
+    sampleUs = 0;
+    lastRecoilUs = 0;
+    recoilPending = false;
     
     acc.x = 0;
     acc.y = 0;
@@ -33,6 +36,30 @@ void LevelMonitor::begin(SensorQMI8658* qmiPtr, CRGB* ledsPtr) {
     lastUpdateTime = millis();
 }
 
+void LevelMonitor::configureSensors() {
+    if (!qmi) return;
+
+    qmi->configAccelerometer(
+        SensorQMI8658::ACC_RANGE_4G,
+        SensorQMI8658::ACC_ODR_1000Hz,
+        SensorQMI8658::LPF_MODE_3,
+        true
+    );
+    qmi->enableAccelerometer();
+    
+    // Gyroscope for sensor fusion
+    qmi->configGyroscope(
+        SensorQMI8658::GYR_RANGE_512DPS,   // ±512 deg/sec (good for rifle movement)
+        SensorQMI8658::GYR_ODR_896_8Hz,     // Match accelerometer rate
+        SensorQMI8658::LPF_MODE_3,         // Low-pass filter
+        true
+    );
+    qmi->enableGyroscope();
+    
+    // Avoid a large dt on the first update after a reconfigure
+    lastUpdateTime = millis();
+}
+
 void LevelMonitor::calibrate() {
     Serial.println("\n*** CALIBRATION ***");
     Serial.println("Hold board LEVEL (horizontal)");
@@ -49,24 +76,26 @@ void LevelMonitor::calibrate() {
         delay(10);
     }
     
-    settings.gravity.x = xSum / 100.0;
-    settings.gravity.y = ySum / 100.0;
-    settings.gravity.z = zSum / 100.0;
-    settings.gravity.magnitude = sqrt(settings.gravity.x * settings.gravity.x + 
-                                     settings.gravity.y * settings.gravity.y + 
-                                     settings.gravity.z * settings.gravity.z);
-    settings.gravity.isCalibrated = true;
+    // Calibration belongs to the active profile (one per rifle)
+    SettingsProfile& p = *settings.profile;
+    p.gravity.x = xSum / 100.0;
+    p.gravity.y = ySum / 100.0;
+    p.gravity.z = zSum / 100.0;
+    p.gravity.magnitude = sqrt(p.gravity.x * p.gravity.x + 
+                               p.gravity.y * p.gravity.y + 
+                               p.gravity.z * p.gravity.z);
+    p.gravity.isCalibrated = true;
     settings.saveCalibration();
     
     Serial.println("Calibration complete!");
-    Serial.print("Gravity: X:"); Serial.print(settings.gravity.x, 3);
-    Serial.print(" Y:"); Serial.print(settings.gravity.y, 3);
-    Serial.print(" Z:"); Serial.println(settings.gravity.z, 3);
+    Serial.print("Gravity: X:"); Serial.print(p.gravity.x, 3);
+    Serial.print(" Y:"); Serial.print(p.gravity.y, 3);
+    Serial.print(" Z:"); Serial.println(p.gravity.z, 3);
 }
 
 float LevelMonitor::calculateTiltAngle() {
     // Accelerometer-based tilt (subject to linear acceleration)
-    float xCal = acc.x - settings.gravity.x;
+    float xCal = acc.x - settings.profile->gravity.x;
     float angle = atan2(xCal, -acc.y) * 180.0 / PI;
     return angle;
 }
@@ -94,6 +123,16 @@ void LevelMonitor::update() {
     // Read both sensors
     qmi->getAccelerometer(acc.x, acc.y, acc.z);
     qmi->getGyroscope(gyro.x, gyro.y, gyro.z);
+    sampleUs = micros();
+    
+    // Recoil: the rifle is never accelerated this hard by hand
+    float accMag = sqrt(acc.x * acc.x + acc.y * acc.y + acc.z * acc.z);
+    int64_t nowUs = esp_timer_get_time();
+    if (fabs(accMag - settings.profile->gravity.magnitude) > RECOIL_G &&
+        nowUs - lastRecoilUs > RECOIL_REFRACTORY_US) {
+        lastRecoilUs = nowUs;
+        recoilPending = true;
+    }
     
     
     // Calculate angles from both sources
@@ -111,31 +150,32 @@ void LevelMonitor::update() {
     
     // Calculate hysteresis as 10% of tolerance
     // This belongs here in level_monitor, not in settings
-    float hysteresis = settings.tolerance * 0.1f;
+    float tolerance = settings.profile->tolerance;
+    float hysteresis = tolerance * 0.1f;
     
     // Determine state with hysteresis
     LevelState newState;
     
     if (currentState == LEVEL_CENTER) {
-        if (filteredAngle > (settings.tolerance + hysteresis)) {
+        if (filteredAngle > (tolerance + hysteresis)) {
             newState = LEVEL_CW;
-        } else if (filteredAngle < -(settings.tolerance + hysteresis)) {
+        } else if (filteredAngle < -(tolerance + hysteresis)) {
             newState = LEVEL_CCW;
         } else {
             newState = LEVEL_CENTER;
         }
     } else if (currentState == LEVEL_CW) {
-        if (filteredAngle < (settings.tolerance - hysteresis)) {
+        if (filteredAngle < (tolerance - hysteresis)) {
             newState = LEVEL_CENTER;
-        } else if (filteredAngle < -(settings.tolerance + hysteresis)) {
+        } else if (filteredAngle < -(tolerance + hysteresis)) {
             newState = LEVEL_CCW;
         } else {
             newState = LEVEL_CW;
         }
     } else { // LEVEL_CCW
-        if (filteredAngle > -(settings.tolerance - hysteresis)) {
+        if (filteredAngle > -(tolerance - hysteresis)) {
             newState = LEVEL_CENTER;
-        } else if (filteredAngle > (settings.tolerance + hysteresis)) {
+        } else if (filteredAngle > (tolerance + hysteresis)) {
             newState = LEVEL_CW;
         } else {
             newState = LEVEL_CCW;
@@ -148,6 +188,13 @@ void LevelMonitor::update() {
     }
 }
 
+bool LevelMonitor::takeRecoil(int64_t& atUs) {
+    if (!recoilPending) return false;
+    recoilPending = false;
+    atUs = lastRecoilUs;
+    return true;
+}
+
 uint16_t LevelMonitor::getStatusColor() const {
     switch(currentState) {
         case LEVEL_CENTER: return COLOR_GREEN;
@@ -0,0 +1,90 @@
+#include "level_predictor.h"
+#include <math.h>
+
+LevelPredictor::LevelPredictor() {
+    enabled = true;
+    pipelineUs = PIPELINE_INIT_US;
+    candidate.state = FRAME_NONE;
+    frame.state = FRAME_NONE;
+    resetStats();
+}
+
+float LevelPredictor::predict(float angle, float rateDps, uint32_t sampleUs, uint32_t nowUs) {
+    uint32_t horizonUs = (nowUs - sampleUs) + pipelineUs;
+    if (horizonUs > MAX_HORIZON_US) {
+        horizonUs = MAX_HORIZON_US;
+    }
+
+    float shown = angle;
+    if (enabled) {
+        shown += rateDps * (horizonUs / 1000000.0f);
+    }
+
+    candidate.state = FRAME_RENDERED;
+    candidate.sampleUs = sampleUs;
+    candidate.renderUs = nowUs;
+    candidate.rawAngle = angle;
+    candidate.shownAngle = shown;
+    return shown;
+}
+
+void LevelPredictor::frameQueued() {
+    if (candidate.state != FRAME_RENDERED) return;
+
+    // A newer frame supersedes one still in flight; it is measured instead
+    frame = candidate;
+    frame.state = FRAME_QUEUED;
+    candidate.state = FRAME_NONE;
+}
+
+void LevelPredictor::frameSent(uint32_t nowUs) {
+    if (frame.state != FRAME_QUEUED) return;
+
+    frame.visibleUs = nowUs + PANEL_SCAN_US;
+    frame.state = FRAME_VISIBLE;
+
+    // Smoothed render-to-glass delay for the next extrapolations
+    uint32_t measured = frame.visibleUs - frame.renderUs;
+    pipelineUs = (pipelineUs * 7 + measured) / 8;
+
+    uint32_t latency = frame.visibleUs - frame.sampleUs;
+    framesSent++;
+    latencySumUs += latency;
+    if (latency > maxLatencyUs) {
+        maxLatencyUs = latency;
+    }
+}
+
+void LevelPredictor::sample(float angle, uint32_t sampleUs) {
+    if (frame.state != FRAME_VISIBLE) return;
+    if ((int32_t)(sampleUs - frame.visibleUs) < 0) return;
+
+    // What the glass showed vs where the rifle actually was by then
+    float errPredicted = angle - frame.shownAngle;
+    float errRaw = angle - frame.rawAngle;
+    sumSqPredicted += errPredicted * errPredicted;
+    sumSqRaw += errRaw * errRaw;
+    scored++;
+    frame.state = FRAME_NONE;
+}
+
+uint32_t LevelPredictor::getAvgLatencyUs() const {
+    return framesSent ? (uint32_t)(latencySumUs / framesSent) : 0;
+}
+
+float LevelPredictor::getRmsErrorPredicted() const {
+    return scored ? sqrtf(sumSqPredicted / scored) : 0;
+}
+
+float LevelPredictor::getRmsErrorRaw() const {
+    return scored ? sqrtf(sumSqRaw / scored) : 0;
+}
+
+void LevelPredictor::resetStats() {
+    framesSent = 0;
+    latencySumUs = 0;
+    maxLatencyUs = 0;
+    scored = 0;
+    sumSqPredicted = 0;
+    sumSqRaw = 0;
+}
@@ -10,8 +10,14 @@
 #include "timer.h"
 #include "menu_system.h"
 #include "display_manager.h"
+#include "render_queue.h"
 #include "buzzer.h"
 #include "mic_detector.h"
+#include "power_manager.h"
+#include "serial_console.h"
+#include "perf_monitor.h"
+#include "spectrogram_view.h"
+#include "timer_wheel.h"
 #include <SensorQMI8658.hpp>
 
 #define USBSerial Serial
@@ -24,14 +30,96 @@ RotaryEncoder encoder(ENCODER_CLK, ENCODER_DT, RotaryEncoder::LatchMode::FOUR3);
 // Diagnostic mode flag
 bool micDiagnosticMode = false;
 
+// Set when something drew directly to the TFT behind the off-screen regions
+bool panelOverwritten = false;
+
+// Encoder button state shared with its wheel jobs
+bool buttonDebounced = false;
+bool longPressDetected = false;
+
 // Encoder interrupt
 void IRAM_ATTR checkEncoder() {
     encoder.tick();
 }
 
+void toggleMicDiagnostic(void* arg);
+void updateDiagnosticLed(void* arg);
+void onLongPress(void* arg);
+void onButtonDebounced(void* arg);
+
+// Loop jobs on the timer wheel (see loop())
+WheelJob bootHoldJob(toggleMicDiagnostic);
+WheelJob diagLedJob(updateDiagnosticLed);
+WheelJob longPressJob(onLongPress);
+WheelJob debounceJob(onButtonDebounced);
+
+// BOOT held for 2 s: enter/leave mic diagnostic mode
+void toggleMicDiagnostic(void* arg) {
+    if (menu.isInMenu()) return;
+    
+    if (!micDiagnosticMode) {
+        // Enter diagnostic mode
+        micDiagnosticMode = true;
+        micDetector.startDiagnostic();
+        
+        // Scrolling spectrogram of all mic bins
+        spectrogram.start();
+        scheduler.schedule(diagLedJob, 100, 100);
+        
+        leds[0] = CRGB::Cyan;
+        FastLED.show();
+    } else {
+        // Exit diagnostic mode
+        micDiagnosticMode = false;
+        micDetector.stopDiagnostic();
+        spectrogram.stop();
+        scheduler.cancel(diagLedJob);
+        
+        display.getTFT()->fillScreen(TFT_BLACK);
+        panelOverwritten = true;
+        leds[0] = CRGB::Green;
+        FastLED.show();
+    }
+}
+
+// Diagnostic mode: LED shows how close the signal is to triggering
+void updateDiagnosticLed(void* arg) {
+    MicStats stats = micDetector.getStats();
+    
+    if (stats.snr > stats.snrThreshold) {
+        leds[0] = CRGB::Red;  // Would trigger
+    } else if (stats.snr > 1.5) {
+        leds[0] = CRGB::Yellow;  // Getting close
+    } else {
+        leds[0] = CRGB::Cyan;  // Baseline
+    }
+    FastLED.show();
+}
+
+// Encoder button held for 1 s - only in main display for timer
+void onLongPress(void* arg) {
+    if (menu.isInMenu() || micDiagnosticMode) return;
+    
+    longPressDetected = true;
+    timer.setReady();
+    micDetector.startListening();  // Start listening for beep
+    leds[0] = CRGB::Yellow;
+    FastLED.show();
+}
+
+// Encoder button held past the bounce time - a release counts as a press
+void onButtonDebounced(void* arg) {
+    buttonDebounced = true;
+}
+
 void setup() {
     USBSerial.begin(115200);
-    delay(2000);
+    
+    // Waking from deep sleep should be fast - skip the USB/splash delays
+    bool fastWake = powerManager.wokeFromDeepSleep();
+    if (!fastWake) {
+        delay(2000);
+    }
     
     USBSerial.println("\n================================");
     USBSerial.println("=== Stage Timer v3.2 ===");
@@ -52,17 +140,22 @@ void setup() {
     // Initialize Buzzer
     buzzer.begin();
 
+    // Countdown deadlines on an esp_timer (warnings/alarm fire on time)
+    timer.begin();
+
     // Initialize Microphone
     USBSerial.println("Initializing microphone...");
     if (!micDetector.begin()) {
         USBSerial.println("WARNING: Microphone initialization failed!");
         USBSerial.println("Manual timer start will still work.");
     }
+    micDetector.setThreshold(settings.profile->micThreshold);
 
     // Initialize Display
     USBSerial.println("Initializing display...");
     display.begin();
     display.setBrightness(settings.displayBrightness);
+    spectrogram.begin(display.getTFT());
     USBSerial.println("Display: OK!");
 
     // Initialize IMU
@@ -79,26 +172,10 @@ void setup() {
         while(1) delay(1000);
     }
     
-    qmi.configAccelerometer(
-        SensorQMI8658::ACC_RANGE_4G,
-        SensorQMI8658::ACC_ODR_1000Hz,
-        SensorQMI8658::LPF_MODE_3,
-        true
-    );
-    qmi.enableAccelerometer();
-    
-    // *** NEW: Configure and enable gyroscope for sensor fusion ***
-    qmi.configGyroscope(
-        SensorQMI8658::GYR_RANGE_512DPS,   // ±512 deg/sec (good for rifle movement)
-        SensorQMI8658::GYR_ODR_896_8Hz,     // Match accelerometer rate
-        SensorQMI8658::LPF_MODE_3,         // Low-pass filter
-        true
-    );
-    qmi.enableGyroscope();
-    USBSerial.println("IMU: Accel + Gyro OK!");
-
-    // Initialize Level Monitor
+    // Initialize Level Monitor (configures accel + gyro for sensor fusion)
     levelMonitor.begin(&qmi, leds);
+    levelMonitor.configureSensors();
+    USBSerial.println("IMU: Accel + Gyro OK!");
 
     // Initialize Rotary Encoder
     USBSerial.println("Initializing encoder...");
@@ -110,12 +187,12 @@ void setup() {
     USBSerial.println("Encoder: OK!");
 
     // Initialize Menu System
-    menu.begin(display.getTFT(), &encoder);
+    menu.begin(&renderQueue, &encoder);
 
     pinMode(BOOT_BUTTON, INPUT_PULLUP);
 
     // Calibration check
-    if (!settings.gravity.isCalibrated) {
+    if (!settings.profile->gravity.isCalibrated) {
         display.getTFT()->fillScreen(COLOR_CYAN);
         display.getTFT()->setTextColor(TFT_BLACK);
         display.getTFT()->setTextSize(1);
@@ -144,143 +221,78 @@ void setup() {
     
     leds[0] = CRGB::Green;
     FastLED.show();
-    delay(1500);
+    if (!fastWake) {
+        delay(1500);
+    }
+    
+    // Inactivity sleep (wake on encoder button or IMU motion)
+    powerManager.begin(&qmi);
+    powerManager.setEncoderIsr(checkEncoder);
+    
+    perfMonitor.begin();
+    scheduler.begin(millis());
     
     USBSerial.println("\n=== READY! ===\n");
     USBSerial.println("TIP: Hold BOOT button for 2s to enter mic diagnostic mode");
+    USBSerial.println("TIP: Type 'help' for serial commands");
+    powerManager.reportWake();
 }
 
 void loop() {
-    // Check BOOT button for diagnostic mode
-    static unsigned long bootButtonPressStart = 0;
-    static bool bootButtonPressed = false;
+    perfMonitor.markLoop();
+    
+    // Check BOOT button for diagnostic mode (2 s hold)
     static bool lastBootState = HIGH;
     bool bootState = digitalRead(BOOT_BUTTON);
     
     if (bootState == LOW && lastBootState == HIGH) {
-        bootButtonPressStart = millis();
-        bootButtonPressed = true;
-    }
-    
-    // 2-second hold for diagnostic mode
-    if (bootButtonPressed && bootState == LOW && 
-        millis() - bootButtonPressStart > 2000 && !menu.isInMenu()) {
-        
-        bootButtonPressed = false;
-        
-        if (!micDiagnosticMode) {
-            // Enter diagnostic mode
-            micDiagnosticMode = true;
-            micDetector.startDiagnostic();
-            
-            // Display diagnostic screen
-            display.getTFT()->fillScreen(TFT_BLACK);
-            display.getTFT()->setTextColor(COLOR_CYAN);
-            display.getTFT()->setTextSize(2);
-            display.getTFT()->setCursor(10, 10);
-            display.getTFT()->println("MIC DIAGNOSTIC");
-            
-            leds[0] = CRGB::Cyan;
-            FastLED.show();
-        } else {
-            // Exit diagnostic mode
-            micDiagnosticMode = false;
-            micDetector.stopDiagnostic();
-            
-            display.getTFT()->fillScreen(TFT_BLACK);
-            leds[0] = CRGB::Green;
-            FastLED.show();
-        }
-    }
-    
-    if (bootState == HIGH) {
-        bootButtonPressed = false;
+        scheduler.schedule(bootHoldJob, 2000);
+        powerManager.notifyActivity();
+    } else if (bootState == HIGH && lastBootState == LOW) {
+        scheduler.cancel(bootHoldJob);
     }
     lastBootState = bootState;
 
+    // Run the wheel jobs that are due (holds, debounce, diagnostic LED)
+    scheduler.advance(millis());
+
+    // Serial commands (stats, diagnostics)
+    console.update();
+    perfMonitor.update();
+
     // Update modules
+    uint32_t levelStart = PerfMonitor::stamp();
     levelMonitor.update();
+    display.getLevelPredictor().sample(levelMonitor.getFilteredAngle(), levelMonitor.getSampleUs());
+    perfMonitor.record(PERF_LEVEL, levelStart);
     timer.update();
     buzzer.update();
+    
+    // Never sleep while the timer is armed/running or diagnostics are open
+    powerManager.setInhibited(micDiagnosticMode ||
+                              timer.getState() == TIMER_READY ||
+                              timer.getState() == TIMER_RUNNING);
+    
+    // Frame rate and backlight follow what the user is doing
+    DisplayActivity displayActivity;
+    displayActivity.menuOpen = menu.isInMenu();
+    displayActivity.keepBright = micDiagnosticMode ||
+                                 timer.getState() == TIMER_READY ||
+                                 timer.getState() == TIMER_RUNNING;
+    displayActivity.timerRunning = timer.getState() == TIMER_RUNNING;
+    displayActivity.remainingMs = timer.getRemainingMs();
+    displayActivity.fastLevel = settings.levelDisplayMode == LEVEL_DISPLAY_BUBBLE;
+    powerManager.setDisplayActivity(displayActivity);
+    powerManager.update();
 
     // Diagnostic mode display update
     if (micDiagnosticMode) {
+        uint32_t micStart = PerfMonitor::stamp();
         micDetector.update();  // Keep processing audio
+        perfMonitor.record(PERF_MIC, micStart);
         
-        static unsigned long lastDiagUpdate = 0;
-        if (millis() - lastDiagUpdate > 100) {  // Update display every 100ms
-            lastDiagUpdate = millis();
-            
-            MicStats stats = micDetector.getStats();
-            
-            // Clear and redraw stats
-            display.getTFT()->fillRect(0, 40, 170, 250, TFT_BLACK);
-            
-            display.getTFT()->setTextSize(1);
-            display.getTFT()->setTextColor(TFT_WHITE);
-            
-            // Current magnitude bar
-            display.getTFT()->setCursor(10, 50);
-            display.getTFT()->print("Level: ");
-            display.getTFT()->print(stats.currentMagnitude, 0);
-            
-            int barLength = constrain(stats.currentMagnitude / 50, 0, 150);
-            display.getTFT()->fillRect(10, 65, barLength, 10, COLOR_GREEN);
-            display.getTFT()->drawRect(10, 65, 150, 10, TFT_WHITE);
-            
-            // Peak magnitude
-            display.getTFT()->setCursor(10, 90);
-            display.getTFT()->print("Peak: ");
-            display.getTFT()->print(stats.peakMagnitude, 0);
-            display.getTFT()->print(" @ ");
-            display.getTFT()->print(stats.detectedFrequency, 0);
-            display.getTFT()->print("Hz");
-            
-            // Noise floor
-            display.getTFT()->setCursor(10, 110);
-            display.getTFT()->print("Noise: ");
-            display.getTFT()->print(stats.noiseFloor, 0);
-            
-            // SNR
-            display.getTFT()->setCursor(10, 130);
-            display.getTFT()->print("SNR: ");
-            display.getTFT()->print(stats.snr, 1);
-            display.getTFT()->print("x");
-            
-            // Thresholds
-            display.getTFT()->setCursor(10, 150);
-            display.getTFT()->print("Thresh: ");
-            display.getTFT()->print(stats.threshold, 0);
-            
-            display.getTFT()->setCursor(10, 170);
-            display.getTFT()->print("SNR Req: ");
-            display.getTFT()->print(stats.snrThreshold, 1);
-            display.getTFT()->print("x");
-            
-            // Instructions
-            display.getTFT()->setTextColor(TFT_DARKGREY);
-            display.getTFT()->setCursor(10, 200);
-            display.getTFT()->println("Test your beeper!");
-            display.getTFT()->setCursor(10, 215);
-            display.getTFT()->println("Watch for peaks");
-            display.getTFT()->setCursor(10, 230);
-            display.getTFT()->println("1400-2300Hz range");
-            
-            display.getTFT()->setCursor(10, 260);
-            display.getTFT()->println("Hold BOOT 2s exit");
-            display.getTFT()->setCursor(10, 275);
-            display.getTFT()->println("Encoder: adjust");
-            
-            // LED color based on signal strength
-            if (stats.snr > stats.snrThreshold) {
-                leds[0] = CRGB::Red;  // Would trigger
-            } else if (stats.snr > 1.5) {
-                leds[0] = CRGB::Yellow;  // Getting close
-            } else {
-                leds[0] = CRGB::Cyan;  // Baseline
-            }
-            FastLED.show();
-        }
+        // One waterfall row per audio block
+        spectrogram.update();
         
         // Allow threshold adjustment with encoder in diagnostic mode
         static int lastEncoderDiag = 0;
@@ -297,38 +309,59 @@ void loop() {
 
     // Normal operation (non-diagnostic)
     // Check for beep detection in READY state
-    if (timer.getState() == TIMER_READY && micDetector.update()) {
-        // Beep detected! Auto-start timer
-        USBSerial.println("Beep detected - auto-starting timer!");
-        timer.start();
+    if (timer.getState() == TIMER_READY) {
+        uint32_t micStart = PerfMonitor::stamp();
+        bool beep = micDetector.update();
+        perfMonitor.record(PERF_MIC, micStart);
+        
+        if (beep) {
+            // Beep detected! Auto-start timer
+            USBSerial.println("Beep detected - auto-starting timer!");
+            timer.start();
+        }
     }
     
-    // Handle encoder button
+    // Split timer: mic listens for shots while a stage runs, recoil from
+    // the IMU counts too (the log merges the two reports of one shot)
+    bool wantShots = timer.getState() == TIMER_RUNNING && timer.isSplitMode();
+    if (wantShots != micDetector.isShotListening()) {
+        if (wantShots) {
+            micDetector.startShotListening();
+        } else {
+            micDetector.stopShotListening();
+        }
+    }
+    if (wantShots) {
+        int64_t shotUs;
+        uint32_t micStart = PerfMonitor::stamp();
+        if (micDetector.updateShots(shotUs)) {
+            timer.recordShot(shotUs, SHOT_MIC);
+        }
+        perfMonitor.record(PERF_MIC, micStart);
+        if (levelMonitor.takeRecoil(shotUs)) {
+            timer.recordShot(shotUs, SHOT_IMU);
+        }
+    }
+    
+    // Handle encoder button (long press and debounce are wheel jobs)
     static bool lastButtonState = HIGH;
-    static unsigned long buttonPressStart = 0;
-    static bool longPressDetected = false;
     bool buttonState = digitalRead(ENCODER_SW);
     
     // Button press started
     if (buttonState == LOW && lastButtonState == HIGH) {
-        buttonPressStart = millis();
+        buttonDebounced = false;
         longPressDetected = false;
-    }
-    
-    // Long press detection (>1 second) - only in main display for timer
-    if (buttonState == LOW && !longPressDetected && !menu.isInMenu()) {
-        if (millis() - buttonPressStart > 1000) {
-            longPressDetected = true;
-            timer.setReady();
-            micDetector.startListening();  // Start listening for beep
-            leds[0] = CRGB::Yellow;
-            FastLED.show();
-        }
+        scheduler.schedule(debounceJob, 50);
+        scheduler.schedule(longPressJob, 1000);
+        powerManager.notifyActivity();
     }
     
     // Button released (short press)
-    if (buttonState == HIGH && lastButtonState == LOW && (millis() - buttonPressStart > 50)) {
-        if (!longPressDetected) {
+    if (buttonState == HIGH && lastButtonState == LOW) {
+        scheduler.cancel(debounceJob);
+        scheduler.cancel(longPressJob);
+        
+        if (buttonDebounced && !longPressDetected) {
             // Short press
             if (!menu.isInMenu()) {
                 if (timer.getState() == TIMER_READY) {
@@ -355,6 +388,7 @@ void loop() {
     
     if (newPos != lastEncoderPos) {
         int delta = newPos - lastEncoderPos;
+        powerManager.notifyActivity();
         
         if (menu.isInMenu()) {
             menu.handleRotation(delta);
@@ -363,55 +397,50 @@ void loop() {
         lastEncoderPos = newPos;
     }
     
+    // Menu repaints only the rows/value box the input above changed
+    menu.render();
+    
+    // Queued full-screen drawing (menu pages, SHOOTER READY), one
+    // budget-sized slice per pass
+    renderQueue.service();
+    
     // Update display if in main mode
-    if (!menu.isInMenu()) {
-        static unsigned long lastDisplayUpdate = 0;
-        if (millis() - lastDisplayUpdate > 20) {
-            lastDisplayUpdate = millis();
+    bool displayIdle = true;
+    if (menu.isInMenu()) {
+        panelOverwritten = true;  // Menu draws directly to the TFT
+    } else {
+        // Time spent in display code this pass (render + present/DMA feed)
+        unsigned long displayStart = micros();
+        
+        // Frame rate set by the display governor (idle 10 fps .. final seconds ~58 fps)
+        if (powerManager.frameDue()) {
+            uint32_t frameStart = PerfMonitor::stamp();
             
-            // Check if we're in SHOOTER READY mode
-            static TimerState lastTimerState = TIMER_IDLE;
             TimerState currentTimerState = timer.getState();
-
-           if (currentTimerState == TIMER_READY) {
-                // Draw full-screen SHOOTER READY if state just changed
-                if (lastTimerState != TIMER_READY) {
-                    display.drawShooterReady();
-                }
-                // Don't update anything else while in READY mode
-                lastTimerState = currentTimerState;
+            
+            if (currentTimerState == TIMER_READY) {
+                // Full-screen SHOOTER READY (drawn once, no-op while shown)
+                display.showShooterReady();
             } else {
-                // Normal display updates
-                
-                // If we just left READY state, force full redraw
-                if (lastTimerState == TIMER_READY) {
-                    display.getTFT()->fillScreen(TFT_BLACK);
+                // Menu/diagnostics drew over the panel - push both regions in full
+                if (panelOverwritten) {
+                    display.invalidate();
+                    panelOverwritten = false;
                 }
                 
-                // Update level indicator
-                if (levelMonitor.needsRedraw() || lastTimerState == TIMER_READY) {
-                    display.drawLevelIndicator(
-                        levelMonitor.getFilteredAngle(),
-                        levelMonitor.getStatusColor(),
-                        levelMonitor.getStatusText()
-                    );
-                    levelMonitor.clearRedrawFlag();
-                } else {
-                    display.updateLevelAngle(
-                        levelMonitor.getFilteredAngle(),
-                        levelMonitor.getStatusColor()
-                    );
-                }
+                // Widgets only repaint what changed since the last frame
+                display.setLevel(
+                    levelMonitor.getFilteredAngle(),
+                    levelMonitor.getStatusColor(),
+                    levelMonitor.getAngleRate(),
+                    levelMonitor.getSampleUs()
+                );
                 
-                // Update timer display
                 const char* timerStateText;
                 switch(currentTimerState) {
                     case TIMER_IDLE:
                         timerStateText = "Long press to ready";
                         break;
-                    case TIMER_READY:
-                        timerStateText = "READY - Press to start";
-                        break;
                     case TIMER_RUNNING:
                         timerStateText = "RUNNING";
                         break;
@@ -422,14 +451,17 @@ void loop() {
                         timerStateText = "";
                 }
                 
-                display.drawTimerDisplay(
-                    timer.getRemainingSeconds(),
+                display.setTimer(
+                    timer.getRemainingMs(),
+                    currentTimerState == TIMER_RUNNING,
                     timer.getPercentRemaining(),
                     timer.getTimerColor(),
                     timerStateText
                 );
+                display.setShots(settings.profile->stageShots > 0 ? &shotLog : nullptr);
                 
-                lastTimerState = currentTimerState;
+                // Repaint invalidated widgets, send only the tiles that changed
+                display.present();
             }
             
             // Update LED (unless timer finished)
@@ -440,8 +472,23 @@ void loop() {
                 leds[0] = CRGB::Red;
                 FastLED.show();
             }
+            perfMonitor.record(PERF_DISPLAY, frameStart);
         }
+        
+        // Feed queued tiles to the SPI DMA (no-op in blocking mode)
+        if (timer.getState() != TIMER_READY) {
+            displayIdle = display.service();
+        }
+        display.recordBlockTime(micros() - displayStart);
     }
     
-    yield();
+    // Idle main screen: light sleep until the next frame/job instead of
+    // spinning (mic, buzzer and queued drawing need the CPU clocked)
+    bool napAllowed = !menu.isInMenu() &&
+                      (timer.getState() == TIMER_IDLE || timer.getState() == TIMER_FINISHED) &&
+                      !micDetector.isListening() && !micDetector.isShotListening() &&
+                      !buzzer.isBusy() && renderQueue.isIdle() && displayIdle;
+    if (!powerManager.nap(napAllowed)) {
+        yield();
+    }
 }
\ No newline at end of file
@@ -5,652 +5,641 @@
 #include <FastLED.h>
 #include "buzzer.h"
 #include "mic_detector.h" 
+#include "perf_monitor.h"
 
 extern CRGB leds[];
 
 MenuSystem menu;
 
-enum TopMenuItem {
-    TOP_LEVEL,
-    TOP_TIMER,
-    TOP_DISPLAY,
-    TOP_MICROPHONE,  
-    TOP_EXIT,
-    TOP_ITEM_COUNT
+// ---------------------------------------------------------------------------
+// Descriptors
+// ---------------------------------------------------------------------------
+
+// An adjustable setting: where it lives, its bounds and what changing it does
+struct MenuValue {
+    const char* title;                      // Adjust screen heading
+    const char* unit;
+    int Settings::* deviceInt;              // Target field - exactly one is set
+    int SettingsProfile::* profileInt;
+    float SettingsProfile::* profileFloat;
+    float minValue;
+    float maxValue;
+    float step;                             // Per encoder detent
+    uint8_t decimals;
+    float (*upperBound)();                  // Tighter max from other values (or null)
+    void (*apply)(int position);            // Live effect while adjusting (or null)
+};
+
+static constexpr MenuValue makeValue(const char* title, const char* unit, int Settings::* field,
+                                     float minValue, float maxValue, float step,
+                                     void (*apply)(int) = nullptr) {
+    return MenuValue{title, unit, field, nullptr, nullptr, minValue, maxValue, step, 0, nullptr, apply};
+}
+
+static constexpr MenuValue makeValue(const char* title, const char* unit, int SettingsProfile::* field,
+                                     float minValue, float maxValue, float step,
+                                     float (*upperBound)() = nullptr) {
+    return MenuValue{title, unit, nullptr, field, nullptr, minValue, maxValue, step, 0, upperBound, nullptr};
+}
+
+static constexpr MenuValue makeValue(const char* title, const char* unit, float SettingsProfile::* field,
+                                     float minValue, float maxValue, float step, uint8_t decimals,
+                                     void (*apply)(int) = nullptr) {
+    return MenuValue{title, unit, nullptr, nullptr, field, minValue, maxValue, step, decimals, nullptr, apply};
+}
+
+static float readValue(const MenuValue& v) {
+    if (v.deviceInt) return settings.*(v.deviceInt);
+    if (v.profileInt) return settings.profile->*(v.profileInt);
+    return settings.profile->*(v.profileFloat);
+}
+
+static void writeValue(const MenuValue& v, float value) {
+    if (v.deviceInt) {
+        settings.*(v.deviceInt) = (int)lroundf(value);
+    } else if (v.profileInt) {
+        settings.profile->*(v.profileInt) = (int)lroundf(value);
+    } else {
+        settings.profile->*(v.profileFloat) = value;
+    }
+}
+
+enum MenuAction : uint8_t {
+    ACTION_PAGE,        // open a submenu
+    ACTION_ADJUST,      // edit the row's value on the adjust screen
+    ACTION_RUN,         // call the row's hook
+    ACTION_BACK,        // to the parent page
+    ACTION_EXIT         // leave the menu
+};
+
+enum MenuPageId : uint8_t {
+    PAGE_TOP,
+    PAGE_LEVEL,
+    PAGE_TIMER,
+    PAGE_DISPLAY,
+    PAGE_MIC,
+    PAGE_PROFILE,
+    PAGE_COUNT
+};
+
+struct MenuItem {
+    const char* label;                          // null: labelHook names the row
+    MenuAction action;
+    uint8_t page;                               // ACTION_PAGE
+    const MenuValue* value;                     // ACTION_ADJUST, shown under the label
+    void (MenuSystem::*run)(uint8_t arg);       // ACTION_RUN
+    uint8_t arg;
+    const char* (*labelHook)(uint8_t arg);
+    bool (*describe)(uint8_t arg, char* out, size_t size);   // second line, true = highlight
+};
+
+struct MenuPage {
+    const char* title;
+    const MenuItem* items;
+    uint8_t count;
+    uint8_t parent;             // page Back returns to
+    uint8_t parentRow;          // and the row selected there
+    int16_t startY;
+    int16_t rowHeight;
+    int16_t spacing;
+    const char* pressHint;
+    uint8_t (*firstRow)();      // row selected on entry (null = first)
+};
+
+// ---------------------------------------------------------------------------
+// Hooks
+// ---------------------------------------------------------------------------
+
+static float yellowLimit() { return warningUpperBound(settings.profile->parTimeSeconds, YELLOW_WARNING_MIN); }
+static float redLimit() { return warningUpperBound(settings.profile->yellowWarningSeconds, RED_WARNING_MIN); }
+
+static void applyBrightness(int position) {
+    display.setBrightness(settings.displayBrightness);
+}
+
+static void applyLedBrightness(int position) {
+    FastLED.setBrightness(settings.ledBrightness);
+    leds[0] = CRGB::White;
+    FastLED.show();
+}
+
+static void applyBuzzerVolume(int position) {
+    // Test beep every 20% change
+    if (position % 4 == 0) {
+        buzzer.beepStart();
+    }
+}
+
+static void applyMicThreshold(int position) {
+    micDetector.setThreshold(settings.profile->micThreshold);
+}
+
+static bool describeDisplayMode(uint8_t arg, char* out, size_t size) {
+    snprintf(out, size, "%s", levelDisplayModeName(settings.levelDisplayMode));
+    return false;
+}
+
+static bool describeFineDigits(uint8_t arg, char* out, size_t size) {
+    static const char* FINE_NAMES[] = {"Seconds", "Tenths", "Hundredths"};
+    snprintf(out, size, "%s", FINE_NAMES[constrain(settings.timerFineDigits, 0, 2)]);
+    return false;
+}
+
+static bool describeShots(uint8_t arg, char* out, size_t size) {
+    if (settings.profile->stageShots > 0) {
+        snprintf(out, size, "%d (splits)", settings.profile->stageShots);
+    } else {
+        snprintf(out, size, "Off");
+    }
+    return false;
+}
+
+static bool describePerfOverlay(uint8_t arg, char* out, size_t size) {
+    snprintf(out, size, "%s", perfMonitor.isOverlayOn() ? "On" : "Off");
+    return false;
+}
+
+static const char* profileName(uint8_t arg) {
+    return settings.getProfile(arg).name;
+}
+
+// Active slot, otherwise what sets it apart at a glance
+static bool describeProfile(uint8_t arg, char* out, size_t size) {
+    if (arg == settings.getProfileIndex()) {
+        snprintf(out, size, "Active");
+        return true;
+    }
+    const SettingsProfile& p = settings.getProfile(arg);
+    snprintf(out, size, "%ds %.1fdeg", p.parTimeSeconds, p.tolerance);
+    return false;
+}
+
+static uint8_t activeProfileRow() {
+    return (uint8_t)settings.getProfileIndex();
+}
+
+// ---------------------------------------------------------------------------
+// Tables
+// ---------------------------------------------------------------------------
+
+static constexpr MenuValue TOLERANCE_VALUE =
+    makeValue("TOLERANCE", "deg", &SettingsProfile::tolerance, 0.1f, 5.0f, 0.1f, 1);
+static constexpr MenuValue PAR_TIME_VALUE =
+    makeValue("PAR TIME", "sec", &SettingsProfile::parTimeSeconds, 5, 600, 1);
+static constexpr MenuValue YELLOW_WARNING_VALUE =
+    makeValue("YELLOW WARN", "sec", &SettingsProfile::yellowWarningSeconds, YELLOW_WARNING_MIN, 600, 1, yellowLimit);
+static constexpr MenuValue RED_WARNING_VALUE =
+    makeValue("RED WARNING", "sec", &SettingsProfile::redWarningSeconds, RED_WARNING_MIN, 600, 1, redLimit);
+static constexpr MenuValue STAGE_SHOTS_VALUE =
+    makeValue("SHOTS", "0 = off", &SettingsProfile::stageShots, 0, 99, 1);
+static constexpr MenuValue BRIGHTNESS_VALUE =
+    makeValue("BRIGHTNESS", "", &Settings::displayBrightness, 10, 255, 10, applyBrightness);
+static constexpr MenuValue LED_BRIGHTNESS_VALUE =
+    makeValue("LED BRIGHTNESS", "", &Settings::ledBrightness, 5, 255, 5, applyLedBrightness);
+static constexpr MenuValue BUZZER_VOLUME_VALUE =
+    makeValue("BUZZER VOL", "%", &Settings::buzzerVolume, 0, 100, 5, applyBuzzerVolume);
+static constexpr MenuValue MIC_THRESHOLD_VALUE =
+    makeValue("MIC THRESH", "", &SettingsProfile::micThreshold, 100.0f, 10000.0f, 50.0f, 0, applyMicThreshold);
+
+static constexpr MenuItem TOP_ITEMS[] = {
+    {"Level",      ACTION_PAGE, PAGE_LEVEL},
+    {"Timer",      ACTION_PAGE, PAGE_TIMER},
+    {"Display",    ACTION_PAGE, PAGE_DISPLAY},
+    {"Microphone", ACTION_PAGE, PAGE_MIC},
+    {"Profile",    ACTION_PAGE, PAGE_PROFILE},
+    {"Exit",       ACTION_EXIT},
+};
+
+static constexpr MenuItem LEVEL_ITEMS[] = {
+    {"Calibrate",  ACTION_RUN,    0, nullptr, &MenuSystem::runCalibrate},
+    {"Tolerance",  ACTION_ADJUST, 0, &TOLERANCE_VALUE},
+    {"Display",    ACTION_RUN,    0, nullptr, &MenuSystem::runCycleDisplayMode, 0, nullptr, describeDisplayMode},
+    {"Back",       ACTION_BACK},
+};
+
+static constexpr MenuItem TIMER_ITEMS[] = {
+    {"Par Time",    ACTION_ADJUST, 0, &PAR_TIME_VALUE},
+    {"Yellow Warn", ACTION_ADJUST, 0, &YELLOW_WARNING_VALUE},
+    {"Red Warning", ACTION_ADJUST, 0, &RED_WARNING_VALUE},
+    {"Last 10s",    ACTION_RUN,    0, nullptr, &MenuSystem::runCycleFineDigits, 0, nullptr, describeFineDigits},
+    // Shots per stage - anything but 0 logs splits during the run
+    {"Shots",       ACTION_ADJUST, 0, &STAGE_SHOTS_VALUE, nullptr, 0, nullptr, describeShots},
+    {"Back",        ACTION_BACK},
 };
 
-enum LevelSubItem {
-    LEVEL_CALIBRATE,
-    LEVEL_TOLERANCE,
-    LEVEL_DISPLAY_MODE,
-    LEVEL_BACK,
-    LEVEL_ITEM_COUNT
+static constexpr MenuItem DISPLAY_ITEMS[] = {
+    {"Brightness",   ACTION_ADJUST, 0, &BRIGHTNESS_VALUE},
+    {"LED Bright",   ACTION_ADJUST, 0, &LED_BRIGHTNESS_VALUE},
+    {"Buzzer Vol",   ACTION_ADJUST, 0, &BUZZER_VOLUME_VALUE},
+    // Runtime only - not saved, the overlay is a tuning aid
+    {"Perf Overlay", ACTION_RUN,    0, nullptr, &MenuSystem::runTogglePerfOverlay, 0, nullptr, describePerfOverlay},
+    {"Back",         ACTION_BACK},
 };
 
-enum TimerSubItem {
-    TIMER_PAR_TIME,
-    TIMER_YELLOW_WARNING,
-    TIMER_RED_WARNING,
-    TIMER_BACK,
-    TIMER_ITEM_COUNT
+static constexpr MenuItem MIC_ITEMS[] = {
+    {"Monitor",    ACTION_RUN,    0, nullptr, &MenuSystem::runMicMonitor},
+    {"Threshold",  ACTION_ADJUST, 0, &MIC_THRESHOLD_VALUE},
+    {"Back",       ACTION_BACK},
 };
 
-enum DisplaySubItem {
-    DISPLAY_BRIGHTNESS,
-    DISPLAY_LED_BRIGHTNESS,
-    DISPLAY_BUZZER_VOLUME, 
-    DISPLAY_BACK,
-    DISPLAY_ITEM_COUNT
+// One row per slot, named after the profile
+static constexpr MenuItem PROFILE_ITEMS[] = {
+    {nullptr, ACTION_RUN, 0, nullptr, &MenuSystem::runSelectProfile, 0, profileName, describeProfile},
+    {nullptr, ACTION_RUN, 0, nullptr, &MenuSystem::runSelectProfile, 1, profileName, describeProfile},
+    {nullptr, ACTION_RUN, 0, nullptr, &MenuSystem::runSelectProfile, 2, profileName, describeProfile},
+    {nullptr, ACTION_RUN, 0, nullptr, &MenuSystem::runSelectProfile, 3, profileName, describeProfile},
+    {"Back",  ACTION_BACK},
 };
+static_assert(sizeof(PROFILE_ITEMS) / sizeof(PROFILE_ITEMS[0]) == PROFILE_COUNT + 1,
+              "one profile row per slot");
+
+#define ITEMS(table) table, (uint8_t)(sizeof(table) / sizeof(table[0]))
 
-enum MicSubItem {
-    MIC_MONITOR,
-    MIC_THRESHOLD,
-    MIC_BACK,
-    MIC_ITEM_COUNT
+static constexpr MenuPage PAGES[PAGE_COUNT] = {
+    // title         rows                  parent    row   y    h   gap
+    {"SETTINGS",     ITEMS(TOP_ITEMS),     PAGE_TOP, 0,    50,  36, 5, "Press: Confirm"},
+    {"LEVEL",        ITEMS(LEVEL_ITEMS),   PAGE_TOP, 0,    50,  50, 8, "Press: Confirm"},
+    {"TIMER",        ITEMS(TIMER_ITEMS),   PAGE_TOP, 1,    36,  40, 2, "Press: Confirm"},
+    {"DISPLAY",      ITEMS(DISPLAY_ITEMS), PAGE_TOP, 2,    50,  42, 4, "Press: Confirm"},
+    {"MICROPHONE",   ITEMS(MIC_ITEMS),     PAGE_TOP, 3,    70,  60, 10, "Press: Confirm"},
+    {"PROFILE",      ITEMS(PROFILE_ITEMS), PAGE_TOP, 4,    50,  42, 4, "Press: Switch", activeProfileRow},
 };
 
+// ---------------------------------------------------------------------------
+// Navigation
+// ---------------------------------------------------------------------------
+
 MenuSystem::MenuSystem() {
     currentMenu = MAIN_DISPLAY;
-    selectedTopItem = 0;
-    selectedMicItem = 0;
-    selectedLevelItem = 0;
-    selectedTimerItem = 0;
-    selectedDisplayItem = 0;
-    adjustingFloatValue = nullptr;
-    adjustingIntValue = nullptr;
-    tft = nullptr;
+    page = &PAGES[PAGE_TOP];
+    selected = 0;
+    adjusting = nullptr;
+    screen = nullptr;
     encoder = nullptr;
+    pageDirty = false;
+    dirtyRows = 0;
+    valueDirty = false;
+    fullRedraw = false;
+    detentPending = false;
+    detentUs = 0;
+    awaitingPixels = false;
+    paintingSinceUs = 0;
+    resetStats();
 }
 
-void MenuSystem::begin(LGFX* tftPtr, RotaryEncoder* encoderPtr) {
-    tft = tftPtr;
+void MenuSystem::begin(RenderQueue* queue, RotaryEncoder* encoderPtr) {
+    screen = queue;
     encoder = encoderPtr;
 }
 
+void MenuSystem::openPage(const MenuPage* target, int row) {
+    currentMenu = MENU_PAGE;
+    page = target;
+    selected = row;
+    pageDirty = true;
+}
+
 void MenuSystem::handleButton() {
     if (currentMenu == MAIN_DISPLAY) {
         // Enter menu
-        currentMenu = MENU_TOP_LEVEL;
-        selectedTopItem = 0;
-        encoder->setPosition(0);
-        drawTopMenu();
+        openPage(&PAGES[PAGE_TOP], 0);
         Serial.println("Entered menu");
-    } else if (currentMenu == MENU_TOP_LEVEL) {
-        executeTopMenuItem(selectedTopItem);
-    } else if (currentMenu == MENU_LEVEL_SUBMENU) {
-        executeLevelMenuItem(selectedLevelItem);
-    } else if (currentMenu == MENU_TIMER_SUBMENU) {
-        executeTimerMenuItem(selectedTimerItem);
-    } else if (currentMenu == MENU_DISPLAY_SUBMENU) {
-        executeDisplayMenuItem(selectedDisplayItem);
-        } else if (currentMenu == MENU_MIC_SUBMENU) {
-        executeMicMenuItem(selectedMicItem);
-    } else if (currentMenu == MIC_DIAGNOSTIC_MODE) {
-        // Exit diagnostic mode
-        currentMenu = MENU_MIC_SUBMENU;
-        drawMicSubmenu();
-    } else if (currentMenu == ADJUSTING_VALUE) {
-
-        // Save and return
-        if (adjustingFloatValue != nullptr) {
-            if (adjustingFloatValue == &settings.tolerance) {
-                currentMenu = MENU_LEVEL_SUBMENU;
-                drawLevelSubmenu();
-            } else if (adjustingFloatValue == &settings.micThreshold) {  // ADD THIS
-                micDetector.setThreshold(settings.micThreshold);
-                currentMenu = MENU_MIC_SUBMENU;
-                drawMicSubmenu();
+    } else if (currentMenu == MENU_PAGE) {
+        const MenuItem& item = page->items[selected];
+        switch (item.action) {
+            case ACTION_PAGE: {
+                const MenuPage* target = &PAGES[item.page];
+                openPage(target, target->firstRow ? target->firstRow() : 0);
+                break;
             }
-            adjustingFloatValue = nullptr;
-        } else if (adjustingIntValue != nullptr) {
-            if (adjustingIntValue == &settings.displayBrightness) {
+            case ACTION_ADJUST:
+                // Absolute encoder position = value / step
+                currentMenu = ADJUSTING_VALUE;
+                adjusting = item.value;
+                encoder->setPosition((int)lroundf(readValue(*adjusting) / adjusting->step));
+                pageDirty = true;
+                break;
+            case ACTION_RUN:
+                (this->*item.run)(item.arg);
+                break;
+            case ACTION_BACK:
+                openPage(&PAGES[page->parent], page->parentRow);
+                break;
+            case ACTION_EXIT:
+                settings.flush();
+                currentMenu = MAIN_DISPLAY;
                 display.setBrightness(settings.displayBrightness);
-                currentMenu = MENU_DISPLAY_SUBMENU;
-                drawDisplaySubmenu();
-            } else if (adjustingIntValue == &settings.ledBrightness) {
                 FastLED.setBrightness(settings.ledBrightness);
-                currentMenu = MENU_DISPLAY_SUBMENU;
-                drawDisplaySubmenu();
-            } else if (adjustingIntValue == &settings.buzzerVolume) {  // <-- Add this
-                currentMenu = MENU_DISPLAY_SUBMENU;
-                drawDisplaySubmenu();
-            } else {
-                currentMenu = MENU_TIMER_SUBMENU;
-                drawTimerSubmenu();
-            }
-            adjustingIntValue = nullptr;
+                screen->fillScreen(TFT_BLACK); 
+                Serial.println("Exited menu");
+                break;
         }
+    } else if (currentMenu == MIC_DIAGNOSTIC_MODE) {
+        // Exit diagnostic mode
+        currentMenu = MENU_PAGE;
+        pageDirty = true;
+    } else if (currentMenu == ADJUSTING_VALUE) {
+        // Save and return to the row we came from
+        adjusting = nullptr;
+        currentMenu = MENU_PAGE;
+        pageDirty = true;
         settings.save();
     }
 }
 
 void MenuSystem::handleRotation(int delta) {
-    if (currentMenu == MENU_TOP_LEVEL) {
-        selectedTopItem += delta;
-        if (selectedTopItem < 0) selectedTopItem = TOP_ITEM_COUNT - 1;
-        if (selectedTopItem >= TOP_ITEM_COUNT) selectedTopItem = 0;
-        drawTopMenu();
-    } else if (currentMenu == MENU_LEVEL_SUBMENU) {
-        selectedLevelItem += delta;
-        if (selectedLevelItem < 0) selectedLevelItem = LEVEL_ITEM_COUNT - 1;
-        if (selectedLevelItem >= LEVEL_ITEM_COUNT) selectedLevelItem = 0;
-        drawLevelSubmenu();
-    } else if (currentMenu == MENU_TIMER_SUBMENU) {
-        selectedTimerItem += delta;
-        if (selectedTimerItem < 0) selectedTimerItem = TIMER_ITEM_COUNT - 1;
-        if (selectedTimerItem >= TIMER_ITEM_COUNT) selectedTimerItem = 0;
-        drawTimerSubmenu();
-    } else if (currentMenu == MENU_DISPLAY_SUBMENU) {
-        selectedDisplayItem += delta;
-        if (selectedDisplayItem < 0) selectedDisplayItem = DISPLAY_ITEM_COUNT - 1;
-        if (selectedDisplayItem >= DISPLAY_ITEM_COUNT) selectedDisplayItem = 0;
-        drawDisplaySubmenu();
-        } else if (currentMenu == MENU_MIC_SUBMENU) {
-        selectedMicItem += delta;
-        if (selectedMicItem < 0) selectedMicItem = MIC_ITEM_COUNT - 1;
-        if (selectedMicItem >= MIC_ITEM_COUNT) selectedMicItem = 0;
-        drawMicSubmenu();
+    if (currentMenu == MENU_PAGE) {
+        int previous = selected;
+        selected = (selected + delta) % page->count;
+        if (selected < 0) selected += page->count;
+        if (selected == previous) return;
+
+        dirtyRows |= (1UL << previous) | (1UL << selected);
+        markRotation();
     } else if (currentMenu == MIC_DIAGNOSTIC_MODE) {
         // In diagnostic mode, adjust threshold with encoder
         int newPos = encoder->getPosition();
-        settings.micThreshold = newPos * 50;
-        settings.micThreshold = constrain(settings.micThreshold, 100.0, 10000.0);
+        settings.profile->micThreshold = newPos * 50;
+        settings.profile->micThreshold = constrain(settings.profile->micThreshold, 100.0, 10000.0);
         // Don't redraw here, main loop handles it
     } else if (currentMenu == ADJUSTING_VALUE) {
-        int newPos = encoder->getPosition();
-        
-        if (adjustingFloatValue != nullptr) {
-            if (adjustingFloatValue == &settings.tolerance) {
-                *adjustingFloatValue = newPos * 0.1;
-                *adjustingFloatValue = constrain(*adjustingFloatValue, 0.1, 5.0);
-                drawValueAdjustment("TOLERANCE", *adjustingFloatValue, "deg");
-            }
-        } else if (adjustingIntValue != nullptr) {
-            if (adjustingIntValue == &settings.displayBrightness) {
-                *adjustingIntValue = newPos * 10;
-                *adjustingIntValue = constrain(*adjustingIntValue, 10, 255);
-                display.setBrightness(*adjustingIntValue);
-                drawValueAdjustment("BRIGHTNESS", *adjustingIntValue, "");
-            } else if (adjustingIntValue == &settings.ledBrightness) {
-                *adjustingIntValue = newPos * 5;
-                *adjustingIntValue = constrain(*adjustingIntValue, 5, 255);
-                FastLED.setBrightness(*adjustingIntValue);
-                leds[0] = CRGB::White;
-                FastLED.show();
-                drawValueAdjustment("LED BRIGHTNESS", *adjustingIntValue, "");
-            } else if (adjustingIntValue == &settings.buzzerVolume) {  // <-- Add this
-                *adjustingIntValue = newPos * 5;
-                *adjustingIntValue = constrain(*adjustingIntValue, 0, 100);
-                // Test beep when adjusting
-                if (newPos % 4 == 0) {  // Beep every 20% change
-                    buzzer.beepStart();
-                }
-                drawValueAdjustment("BUZZER VOL", *adjustingIntValue, "%");    
-            } else if (adjustingIntValue == &settings.parTimeSeconds) {
-                *adjustingIntValue = newPos;
-                *adjustingIntValue = constrain(*adjustingIntValue, 5, 600);
-                drawValueAdjustment("PAR TIME", *adjustingIntValue, "sec");
-            } else if (adjustingIntValue == &settings.yellowWarningSeconds) {
-                *adjustingIntValue = newPos;
-                *adjustingIntValue = constrain(*adjustingIntValue, 5, settings.parTimeSeconds - 5);
-                drawValueAdjustment("YELLOW WARN", *adjustingIntValue, "sec");
-            } else if (adjustingIntValue == &settings.redWarningSeconds) {
-                *adjustingIntValue = newPos;
-                *adjustingIntValue = constrain(*adjustingIntValue, 1, settings.yellowWarningSeconds - 5);
-                drawValueAdjustment("RED WARNING", *adjustingIntValue, "sec");
-            }
+        const MenuValue& v = *adjusting;
+        int position = encoder->getPosition();
+        // A dependent bound may fall under the minimum - never invert the range
+        float upper = v.upperBound ? max(v.minValue, min(v.maxValue, v.upperBound())) : v.maxValue;
+        float value = constrain(position * v.step, v.minValue, upper);
+        if (value == readValue(v)) return;
+
+        writeValue(v, value);
+        if (v.apply) {
+            v.apply(position);
         }
+        valueDirty = true;
+        markRotation();
     }
 }
 
-void MenuSystem::drawTopMenu() {
-    tft->fillScreen(TFT_BLACK);
-    tft->setTextSize(2);
-    tft->setTextColor(TFT_WHITE);
-    tft->setCursor(25, 15);
-    tft->println("SETTINGS");
+void MenuSystem::markRotation() {
+    detents++;
+    if (fullRedraw) {
+        pageDirty = true;
+    }
+    if (!detentPending) {
+        detentPending = true;
+        detentUs = micros();
+    }
+}
+
+void MenuSystem::runCalibrate(uint8_t arg) {
+    screen->fillScreen(COLOR_CYAN);
+    screen->setTextColor(TFT_BLACK);
+    screen->setTextSize(1);
+    screen->setCursor(10, 100);
+    screen->println("CALIBRATING...");
+    screen->setCursor(10, 120);
+    screen->println("Hold LEVEL");
+    screen->flush();  // must be on the panel before the blocking wait
+    delay(1000);
     
-    const char* menuItems[] = {"Level", "Timer", "Display", "Microphone", "Exit"};
-    int startY = 60;
-    int boxHeight = 45;
-    int spacing = 8;
+    levelMonitor.calibrate();
     
-    for (int i = 0; i < TOP_ITEM_COUNT; i++) {
-        int y = startY + (i * (boxHeight + spacing));
-        
-        if (i == selectedTopItem) {
-            tft->fillRect(5, y, 160, boxHeight, TFT_BLUE);
-            tft->setTextColor(TFT_WHITE);
-        } else {
-            tft->drawRect(5, y, 160, boxHeight, TFT_DARKGREY);
-            tft->setTextColor(TFT_LIGHTGREY);
+    screen->fillScreen(COLOR_GREEN);
+    screen->setTextSize(2);
+    screen->setCursor(30, 140);
+    screen->println("DONE!");
+    screen->flush();
+    delay(1500);
+    pageDirty = true;
+}
+
+void MenuSystem::runCycleDisplayMode(uint8_t arg) {
+    // Cycle degrees -> arrow -> bubble
+    settings.levelDisplayMode = (LevelDisplayMode)((settings.levelDisplayMode + 1) % LEVEL_DISPLAY_MODE_COUNT);
+    settings.save();
+    dirtyRows |= 1UL << selected;
+    Serial.printf("Display mode changed to: %s\n",
+                    levelDisplayModeName(settings.levelDisplayMode));
+}
+
+void MenuSystem::runCycleFineDigits(uint8_t arg) {
+    // Cycle seconds -> tenths -> hundredths
+    settings.timerFineDigits = (settings.timerFineDigits + 1) % 3;
+    settings.save();
+    dirtyRows |= 1UL << selected;
+}
+
+void MenuSystem::runTogglePerfOverlay(uint8_t arg) {
+    perfMonitor.setOverlay(!perfMonitor.isOverlayOn());
+    dirtyRows |= 1UL << selected;
+}
+
+void MenuSystem::runMicMonitor(uint8_t arg) {
+    // Enter real-time diagnostic mode
+    currentMenu = MIC_DIAGNOSTIC_MODE;
+    micDetector.resetStats();
+    encoder->setPosition((int)(settings.profile->micThreshold / 50));
+    Serial.println("Entered mic diagnostic mode");
+}
+
+void MenuSystem::runSelectProfile(uint8_t arg) {
+    // Pointer swap - the choice is written with the next debounced save
+    int previous = settings.getProfileIndex();
+    settings.selectProfile(arg);
+    micDetector.setThreshold(settings.profile->micThreshold);
+    dirtyRows |= (1UL << previous) | (1UL << arg);
+    Serial.printf("Profile switched to %d: %s\n", arg + 1, settings.profile->name);
+}
+
+// ---------------------------------------------------------------------------
+// Drawing
+// ---------------------------------------------------------------------------
+
+void MenuSystem::render() {
+    // Previous repaint fully replayed: its pixels are on the panel
+    if (awaitingPixels && screen->isIdle()) {
+        uint32_t latency = micros() - paintingSinceUs;
+        latencyCount++;
+        latencySumUs += latency;
+        if (latency > latencyMaxUs) {
+            latencyMaxUs = latency;
         }
-        
-        tft->setTextSize(2);
-        tft->setCursor(45, y + 14);
-        tft->println(menuItems[i]);
+        awaitingPixels = false;
     }
-    
-    tft->setTextSize(1);
-    tft->setTextColor(TFT_DARKGREY);
-    tft->setCursor(15, 295);
-    tft->println("Turn: Select");
-    tft->setCursor(15, 310);
-    tft->println("Press: Confirm");
-}
-
-void MenuSystem::drawLevelSubmenu() {
-    tft->fillScreen(TFT_BLACK);
-    tft->setTextSize(2);
-    tft->setTextColor(TFT_WHITE);
-    tft->setCursor(5, 10);
-    tft->println("< LEVEL");
-    
-    const char* menuItems[] = {"Calibrate", "Tolerance", "Display", "Back"};
-    int startY = 50;
-    int boxHeight = 50;
-    int spacing = 8;
-    
-    for (int i = 0; i < LEVEL_ITEM_COUNT; i++) {
-        int y = startY + (i * (boxHeight + spacing));
-        
-        if (i == selectedLevelItem) {
-            tft->fillRect(5, y, 160, boxHeight, TFT_BLUE);
-            tft->setTextColor(TFT_WHITE);
+
+    if (!pageDirty && dirtyRows == 0 && !valueDirty) return;
+
+    // Let the last repaint land first - turns in the meantime fold into one
+    if (!screen->isIdle()) return;
+
+    if (currentMenu == MENU_PAGE) {
+        if (pageDirty) {
+            drawPage();
         } else {
-            tft->drawRect(5, y, 160, boxHeight, TFT_DARKGREY);
-            tft->setTextColor(TFT_LIGHTGREY);
-        }
-        
-        tft->setTextSize(2);
-        tft->setCursor(10, y + 5);
-        tft->println(menuItems[i]);
-        
-        if (i == LEVEL_TOLERANCE) {
-            tft->setTextSize(2);
-            tft->setCursor(10, y + 27);
-            tft->print(settings.tolerance, 1);
-            tft->print(" deg");
-        } else if (i == LEVEL_DISPLAY_MODE) {
-            tft->setTextSize(2);
-            tft->setCursor(10, y + 27);
-            if (settings.levelDisplayMode == LEVEL_DISPLAY_DEGREES) {
-                tft->print("Degrees");
-            } else {
-                tft->print("Arrow");
+            for (int i = 0; i < page->count; i++) {
+                if (dirtyRows & (1UL << i)) drawRow(i, true);
             }
         }
-    }
-    
-    tft->setTextSize(1);
-    tft->setTextColor(TFT_DARKGREY);
-    tft->setCursor(15, 295);
-    tft->println("Turn: Select");
-    tft->setCursor(15, 310);
-    tft->println("Press: Confirm");
-}
-
-void MenuSystem::drawTimerSubmenu() {
-    tft->fillScreen(TFT_BLACK);
-    tft->setTextSize(2);
-    tft->setTextColor(TFT_WHITE);
-    tft->setCursor(5, 10);
-    tft->println("< TIMER");
-    
-    const char* menuItems[] = {"Par Time", "Yellow Warn", "Red Warning", "Back"};
-    int startY = 50;
-    int boxHeight = 50;
-    int spacing = 8;
-    
-    for (int i = 0; i < TIMER_ITEM_COUNT; i++) {
-        int y = startY + (i * (boxHeight + spacing));
-        
-        if (i == selectedTimerItem) {
-            tft->fillRect(5, y, 160, boxHeight, TFT_BLUE);
-            tft->setTextColor(TFT_WHITE);
+    } else if (currentMenu == ADJUSTING_VALUE) {
+        if (pageDirty) {
+            drawAdjustScreen();
         } else {
-            tft->drawRect(5, y, 160, boxHeight, TFT_DARKGREY);
-            tft->setTextColor(TFT_LIGHTGREY);
-        }
-        
-        tft->setTextSize(2);
-        tft->setCursor(10, y + 5);
-        tft->println(menuItems[i]);
-        
-        if (i == TIMER_PAR_TIME) {
-            tft->setCursor(10, y + 27);
-            tft->print(settings.parTimeSeconds);
-            tft->print(" sec");
-        } else if (i == TIMER_YELLOW_WARNING) {
-            tft->setCursor(10, y + 27);
-            tft->print(settings.yellowWarningSeconds);
-            tft->print(" sec");
-        } else if (i == TIMER_RED_WARNING) {
-            tft->setCursor(10, y + 27);
-            tft->print(settings.redWarningSeconds);
-            tft->print(" sec");
+            drawValueBox(true);
         }
     }
+    pageDirty = false;
+    dirtyRows = 0;
+    valueDirty = false;
+
+    if (detentPending) {
+        paintingSinceUs = detentUs;
+        awaitingPixels = true;
+        detentPending = false;
+        repaints++;
+    }
+}
+
+void MenuSystem::drawPage() {
+    screen->fillScreen(TFT_BLACK);
+    fillBytes += 170UL * 320UL * 2;
+
+    screen->setTextSize(2);
+    screen->setTextColor(TFT_WHITE);
+    if (page == &PAGES[PAGE_TOP]) {
+        screen->setCursor(25, 15);
+    } else {
+        screen->setCursor(5, 10);
+        screen->print("< ");
+    }
+    screen->println(page->title);
     
-    tft->setTextSize(1);
-    tft->setTextColor(TFT_DARKGREY);
-    tft->setCursor(15, 295);
-    tft->println("Turn: Select");
-    tft->setCursor(15, 310);
-    tft->println("Press: Confirm");
-}
-
-void MenuSystem::drawDisplaySubmenu() {
-    tft->fillScreen(TFT_BLACK);
-    tft->setTextSize(2);
-    tft->setTextColor(TFT_WHITE);
-    tft->setCursor(5, 10);
-    tft->println("< DISPLAY");
-    
-    const char* menuItems[] = {"Brightness", "LED Bright", "Buzzer Vol", "Back"};
-    int startY = 50;
-    int boxHeight = 45;
-    int spacing = 6;
+    for (int i = 0; i < page->count; i++) {
+        drawRow(i, false);
+    }
+    drawFooter("Turn: Select", page->pressHint, 290);
+}
+
+void MenuSystem::drawRow(int row, bool clear) {
+    const MenuItem& item = page->items[row];
+    int h = page->rowHeight;
+    int y = page->startY + (row * (h + page->spacing));
     
-    for (int i = 0; i < DISPLAY_ITEM_COUNT; i++) {
-        int y = startY + (i * (boxHeight + spacing));
-        
-        if (i == selectedDisplayItem) {
-            tft->fillRect(5, y, 160, boxHeight, TFT_BLUE);
-            tft->setTextColor(TFT_WHITE);
-        } else {
-            tft->drawRect(5, y, 160, boxHeight, TFT_DARKGREY);
-            tft->setTextColor(TFT_LIGHTGREY);
-        }
-        
-        tft->setTextSize(2);
-        tft->setCursor(10, y + 5);
-        tft->println(menuItems[i]);
-        
-        if (i == DISPLAY_BRIGHTNESS) {
-            tft->setTextSize(2);
-            tft->setCursor(10, y + 25);
-            tft->print(settings.displayBrightness);
-        } else if (i == DISPLAY_LED_BRIGHTNESS) {
-            tft->setTextSize(2);
-            tft->setCursor(10, y + 25);
-            tft->print(settings.ledBrightness);
-        } else if (i == DISPLAY_BUZZER_VOLUME) {
-            tft->setTextSize(2);
-            tft->setCursor(10, y + 25);
-            tft->print(settings.buzzerVolume);
-            tft->print("%");
+    if (row == selected) {
+        screen->fillRect(5, y, 160, h, TFT_BLUE);
+        screen->setTextColor(TFT_WHITE);
+        fillBytes += 160UL * h * 2;
+    } else {
+        if (clear) {
+            // Was the highlighted row
+            screen->fillRect(5, y, 160, h, TFT_BLACK);
+            fillBytes += 160UL * h * 2;
         }
+        screen->drawRect(5, y, 160, h, TFT_DARKGREY);
+        screen->setTextColor(TFT_LIGHTGREY);
     }
     
-    tft->setTextSize(1);
-    tft->setTextColor(TFT_DARKGREY);
-    tft->setCursor(15, 290);
-    tft->println("Turn: Select");
-    tft->setCursor(15, 305);
-    tft->println("Press: Confirm");
-}
-
-void MenuSystem::drawValueAdjustment(const char* label, float value, const char* unit) {
-    tft->fillScreen(TFT_BLACK);
-    tft->setTextSize(2);
-    tft->setTextColor(TFT_WHITE);
-    tft->setCursor(5, 15);
-    tft->print("< ");
-    tft->println(label);
-    
-    tft->drawRect(5, 80, 160, 90, TFT_WHITE);
-    tft->setTextSize(4);
-    tft->setTextColor(COLOR_CYAN);
-    tft->setCursor(15, 100);
-    tft->print(value, 2);
-    
-    tft->setTextSize(2);
-    tft->setCursor(15, 140);
-    tft->print(unit);
-    
-    tft->setTextSize(1);
-    tft->setTextColor(TFT_DARKGREY);
-    tft->setCursor(15, 250);
-    tft->println("Turn: Adjust");
-    tft->setCursor(15, 265);
-    tft->println("Press: Save & Exit");
-}
-
-void MenuSystem::drawValueAdjustment(const char* label, int value, const char* unit) {
-    tft->fillScreen(TFT_BLACK);
-    tft->setTextSize(2);
-    tft->setTextColor(TFT_WHITE);
-    tft->setCursor(5, 15);
-    tft->print("< ");
-    tft->println(label);
-    
-    tft->drawRect(5, 80, 160, 90, TFT_WHITE);
-    tft->setTextSize(4);
-    tft->setTextColor(COLOR_CYAN);
-    tft->setCursor(40, 110);
-    tft->print(value);
-    
-    tft->setTextSize(2);
-    tft->setCursor(15, 140);
-    tft->print(unit);
-    
-    int barWidth = map(constrain(value, 0, 255), 0, 255, 0, 150);
-    tft->fillRect(10, 190, barWidth, 15, COLOR_GREEN);
-    tft->drawRect(10, 190, 150, 15, TFT_WHITE);
+    screen->setTextSize(2);
+    if (page == &PAGES[PAGE_TOP]) {
+        screen->setCursor(45, y + (h - 16) / 2);
+    } else {
+        screen->setCursor(10, y + 5);
+    }
+    screen->println(item.label ? item.label : item.labelHook(item.arg));
     
-    tft->setTextSize(1);
-    tft->setTextColor(TFT_DARKGREY);
-    tft->setCursor(15, 250);
-    tft->println("Turn: Adjust");
-    tft->setCursor(15, 265);
-    tft->println("Press: Save & Exit");
-}
-
-void MenuSystem::executeTopMenuItem(int item) {
-    switch(item) {
-        case TOP_LEVEL:
-            currentMenu = MENU_LEVEL_SUBMENU;
-            selectedLevelItem = 0;
-            encoder->setPosition(0);
-            drawLevelSubmenu();
-            break;
-        case TOP_TIMER:
-            currentMenu = MENU_TIMER_SUBMENU;
-            selectedTimerItem = 0;
-            encoder->setPosition(0);
-            drawTimerSubmenu();
-            break;
-        case TOP_DISPLAY:
-            currentMenu = MENU_DISPLAY_SUBMENU;
-            selectedDisplayItem = 0;
-            encoder->setPosition(0);
-            drawDisplaySubmenu();
-            break;
-        case TOP_MICROPHONE:  // ADD THIS CASE
-            currentMenu = MENU_MIC_SUBMENU;
-            selectedMicItem = 0;
-            encoder->setPosition(0);
-            drawMicSubmenu();
-            break;
-        case TOP_EXIT:
-            settings.save();
-            currentMenu = MAIN_DISPLAY;
-            display.setBrightness(settings.displayBrightness);
-            FastLED.setBrightness(settings.ledBrightness);
-            tft->fillScreen(TFT_BLACK); 
-            Serial.println("Exited menu");
-            break;
+    // Second line: current value or state
+    char text[24];
+    bool highlight = false;
+    if (item.describe) {
+        highlight = item.describe(item.arg, text, sizeof(text));
+    } else if (item.value) {
+        const MenuValue& v = *item.value;
+        int len = snprintf(text, sizeof(text), "%.*f", v.decimals, readValue(v));
+        if (v.unit[0]) {
+            snprintf(text + len, sizeof(text) - len, " %s", v.unit);
+        }
+    } else {
+        return;
+    }
+    if (highlight) {
+        screen->setTextColor(COLOR_GREEN);
     }
+    screen->setCursor(10, y + 22);
+    screen->print(text);
 }
 
-void MenuSystem::executeLevelMenuItem(int item) {
-    switch(item) {
-        case LEVEL_CALIBRATE:
-            tft->fillScreen(COLOR_CYAN);
-            tft->setTextColor(TFT_BLACK);
-            tft->setTextSize(1);
-            tft->setCursor(10, 100);
-            tft->println("CALIBRATING...");
-            tft->setCursor(10, 120);
-            tft->println("Hold LEVEL");
-            delay(1000);
-            
-            levelMonitor.calibrate();
-            
-            tft->fillScreen(COLOR_GREEN);
-            tft->setTextSize(2);
-            tft->setCursor(30, 140);
-            tft->println("DONE!");
-            delay(1500);
-            drawLevelSubmenu();
-            break;
-        case LEVEL_TOLERANCE:
-            currentMenu = ADJUSTING_VALUE;
-            adjustingFloatValue = &settings.tolerance;
-            encoder->setPosition((int)(settings.tolerance * 10));
-            drawValueAdjustment("TOLERANCE", settings.tolerance, "deg");
-            break;
-        case LEVEL_DISPLAY_MODE:
-            // Toggle between degrees and arrow
-            if (settings.levelDisplayMode == LEVEL_DISPLAY_DEGREES) {
-                settings.levelDisplayMode = LEVEL_DISPLAY_ARROW;
-            } else {
-                settings.levelDisplayMode = LEVEL_DISPLAY_DEGREES;
-            }
-            settings.save();
-            drawLevelSubmenu();
-            Serial.printf("Display mode changed to: %s\n",
-                            settings.levelDisplayMode == LEVEL_DISPLAY_DEGREES ? "Degrees" : "Arrow");
-            break;
-        case LEVEL_BACK:
-            currentMenu = MENU_TOP_LEVEL;
-            selectedTopItem = 0;
-            encoder->setPosition(0);
-            drawTopMenu();
-            break;
-    }
+void MenuSystem::drawAdjustScreen() {
+    screen->fillScreen(TFT_BLACK);
+    fillBytes += 170UL * 320UL * 2;
+
+    screen->setTextSize(2);
+    screen->setTextColor(TFT_WHITE);
+    screen->setCursor(5, 15);
+    screen->print("< ");
+    screen->println(adjusting->title);
+    
+    screen->drawRect(5, 80, 160, 90, TFT_WHITE);
+    drawValueBox(false);
+    drawFooter("Turn: Adjust", "Press: Save & Exit", 250);
 }
 
-void MenuSystem::executeTimerMenuItem(int item) {
-    switch(item) {
-        case TIMER_PAR_TIME:
-            currentMenu = ADJUSTING_VALUE;
-            adjustingIntValue = &settings.parTimeSeconds;
-            encoder->setPosition(settings.parTimeSeconds);
-            drawValueAdjustment("PAR TIME", settings.parTimeSeconds, "sec");
-            break;
-        case TIMER_YELLOW_WARNING:
-            currentMenu = ADJUSTING_VALUE;
-            adjustingIntValue = &settings.yellowWarningSeconds;
-            encoder->setPosition(settings.yellowWarningSeconds);
-            drawValueAdjustment("YELLOW WARN", settings.yellowWarningSeconds, "sec");
-            break;
-        case TIMER_RED_WARNING:
-            currentMenu = ADJUSTING_VALUE;
-            adjustingIntValue = &settings.redWarningSeconds;
-            encoder->setPosition(settings.redWarningSeconds);
-            drawValueAdjustment("RED WARNING", settings.redWarningSeconds, "sec");
-            break;
-        case TIMER_BACK:
-            currentMenu = MENU_TOP_LEVEL;
-            selectedTopItem = 1;
-            encoder->setPosition(1);
-            drawTopMenu();
-            break;
+void MenuSystem::drawValueBox(bool clear) {
+    const MenuValue& v = *adjusting;
+    float value = readValue(v);
+
+    // Inside of the frame and the bar only - the rest of the screen stays
+    if (clear) {
+        screen->fillRect(6, 81, 158, 88, TFT_BLACK);
+        screen->fillRect(10, 190, 150, 15, TFT_BLACK);
+        fillBytes += (158UL * 88 + 150UL * 15) * 2;
     }
-}
-void MenuSystem::drawMicSubmenu() {
-    tft->fillScreen(TFT_BLACK);
-    tft->setTextSize(2);
-    tft->setTextColor(TFT_WHITE);
-    tft->setCursor(5, 10);
-    tft->println("< MICROPHONE");
-    
-    const char* menuItems[] = {"Monitor", "Threshold", "Back"};
-    int startY = 70;
-    int boxHeight = 60;
-    int spacing = 10;
+
+    char text[16];
+    snprintf(text, sizeof(text), "%.*f", v.decimals, value);
+    screen->setTextSize(4);
+    screen->setTextColor(COLOR_CYAN);
+    screen->setCursor(15, 100);
+    screen->print(text);
     
-    for (int i = 0; i < MIC_ITEM_COUNT; i++) {
-        int y = startY + (i * (boxHeight + spacing));
-        
-        if (i == selectedMicItem) {
-            tft->fillRect(5, y, 160, boxHeight, TFT_BLUE);
-            tft->setTextColor(TFT_WHITE);
-        } else {
-            tft->drawRect(5, y, 160, boxHeight, TFT_DARKGREY);
-            tft->setTextColor(TFT_LIGHTGREY);
-        }
-        
-        tft->setTextSize(2);
-        tft->setCursor(10, y + 10);
-        tft->println(menuItems[i]);
-        
-        if (i == MIC_THRESHOLD) {
-            tft->setTextSize(2);
-            tft->setCursor(10, y + 35);
-            tft->printf("%.0f", settings.micThreshold);
-        }
-    }
+    screen->setTextSize(2);
+    screen->setCursor(15, 140);
+    screen->print(v.unit);
     
-    tft->setTextSize(1);
-    tft->setTextColor(TFT_DARKGREY);
-    tft->setCursor(15, 290);
-    tft->println("Turn: Select");
-    tft->setCursor(15, 305);
-    tft->println("Press: Confirm");
-}
-
-void MenuSystem::executeMicMenuItem(int item) {
-    switch(item) {
-        case MIC_MONITOR:
-            // Enter real-time diagnostic mode
-            currentMenu = MIC_DIAGNOSTIC_MODE;
-            micDetector.resetStats();
-            encoder->setPosition((int)(settings.micThreshold / 50));
-            Serial.println("Entered mic diagnostic mode");
-            break;
-        case MIC_THRESHOLD:
-            currentMenu = ADJUSTING_VALUE;
-            adjustingFloatValue = &settings.micThreshold;
-            encoder->setPosition((int)(settings.micThreshold / 50));
-            drawValueAdjustment("MIC THRESH", settings.micThreshold, "");
-            break;
-        case MIC_BACK:
-            currentMenu = MENU_TOP_LEVEL;
-            selectedTopItem = 3;  // Position on "Microphone"
-            encoder->setPosition(3);
-            drawTopMenu();
-            break;
-    }
+    int barWidth = (int)((value - v.minValue) * 150 / (v.maxValue - v.minValue));
+    barWidth = constrain(barWidth, 0, 150);
+    screen->fillRect(10, 190, barWidth, 15, COLOR_GREEN);
+    screen->drawRect(10, 190, 150, 15, TFT_WHITE);
 }
-void MenuSystem::executeDisplayMenuItem(int item) {
-    switch(item) {
-        case DISPLAY_BRIGHTNESS:
-            currentMenu = ADJUSTING_VALUE;
-            adjustingIntValue = &settings.displayBrightness;
-            encoder->setPosition(settings.displayBrightness / 10);
-            drawValueAdjustment("BRIGHTNESS", settings.displayBrightness, "");
-            break;
-        case DISPLAY_LED_BRIGHTNESS:
-            currentMenu = ADJUSTING_VALUE;
-            adjustingIntValue = &settings.ledBrightness;
-            encoder->setPosition(settings.ledBrightness / 5);
-            drawValueAdjustment("LED BRIGHTNESS", settings.ledBrightness, "");
-            break;
-        case DISPLAY_BUZZER_VOLUME:  // <-- Add this
-            currentMenu = ADJUSTING_VALUE;
-            adjustingIntValue = &settings.buzzerVolume;
-            encoder->setPosition(settings.buzzerVolume / 5);
-            drawValueAdjustment("BUZZER VOL", settings.buzzerVolume, "%");
-            break;
-        case DISPLAY_BACK:
-            currentMenu = MENU_TOP_LEVEL;
-            selectedTopItem = 2;
-            encoder->setPosition(2);
-            drawTopMenu();
-            break;
+
+void MenuSystem::drawFooter(const char* turnHint, const char* pressHint, int y) {
+    screen->setTextSize(1);
+    screen->setTextColor(TFT_DARKGREY);
+    screen->setCursor(15, y);
+    screen->println(turnHint);
+    screen->setCursor(15, y + 15);
+    screen->println(pressHint);
+}
+
+// ---------------------------------------------------------------------------
+// Measurements
+// ---------------------------------------------------------------------------
+
+void MenuSystem::printReport() {
+    Serial.printf("Menu: %s redraw per detent\n", fullRedraw ? "full page" : "row/value box");
+    if (latencyCount == 0) {
+        Serial.println("Menu: no detents measured - turn the encoder in the menu");
+        return;
     }
-}
\ No newline at end of file
+    Serial.printf("Menu: encoder-to-pixel avg %lu us, max %lu us over %lu repaints (%lu detents)\n",
+                  (unsigned long)(latencySumUs / latencyCount), (unsigned long)latencyMaxUs,
+                  (unsigned long)latencyCount, (unsigned long)detents);
+    Serial.printf("Menu: %lu B filled per repaint\n",
+                  (unsigned long)(fillBytes / (repaints ? repaints : 1)));
+}
+
+void MenuSystem::resetStats() {
+    latencyCount = 0;
+    latencySumUs = 0;
+    latencyMaxUs = 0;
+    repaints = 0;
+    detents = 0;
+    fillBytes = 0;
+}
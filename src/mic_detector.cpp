@@ -7,6 +7,8 @@ MicDetector micDetector;
 
 MicDetector::MicDetector()
     : listening(false)
+    , shotListening(false)
+    , lastShotUs(0)
     , diagnosticMode(false)
     , lastMagnitude(0.0)
     , detectionThreshold(1500.0)
@@ -19,7 +21,16 @@ MicDetector::MicDetector()
     , statsStartTime(0)
     , sampleCount(0)
     , magnitudeSum(0.0)
+    , i2sEvents(nullptr)
+    , pendingBytes(0)
+    , blankedBlocks(0)
 {
+    ownTonesLock = portMUX_INITIALIZER_UNLOCKED;
+    ownTones.configure(DEFAULT_RING_DOWN_MS * 1000, BLANK_HALF_WIDTH_HZ);
+    audioStats.blocksRead = 0;
+    audioStats.overruns = 0;
+    audioStats.fillPercent = 0;
+    audioStats.peakFillPercent = 0;
 }
 
 bool MicDetector::begin() {
@@ -36,8 +47,8 @@ bool MicDetector::begin() {
         .channel_format = I2S_CHANNEL_FMT_ONLY_LEFT,  // Mono, left channel
         .communication_format = I2S_COMM_FORMAT_STAND_I2S,
         .intr_alloc_flags = ESP_INTR_FLAG_LEVEL1,
-        .dma_buf_count = 4,
-        .dma_buf_len = 1024,
+        .dma_buf_count = DMA_BUF_COUNT,
+        .dma_buf_len = DMA_BUF_LEN,
         .use_apll = false,
         .tx_desc_auto_clear = false,
         .fixed_mclk = 0
@@ -51,8 +62,8 @@ bool MicDetector::begin() {
         .data_in_num = I2S_DIN
     };
 
-    // Install and start I2S driver
-    esp_err_t err = i2s_driver_install(I2S_PORT, &i2s_config, 0, NULL);
+    // Install and start I2S driver (event queue reports DMA fill and overruns)
+    esp_err_t err = i2s_driver_install(I2S_PORT, &i2s_config, 8, &i2sEvents);
     if (err != ESP_OK) {
         Serial.printf("ERROR: Failed to install I2S driver: %d\n", err);
         return false;
@@ -87,6 +98,7 @@ void MicDetector::calculateCoefficients() {
         float normalizedFreq = freq / SAMPLE_RATE;
         coefficients[freqIndex] = 2.0 * cos(2.0 * PI * normalizedFreq);
         targetFrequencies[freqIndex] = freq;
+        binMagnitudes[freqIndex] = 0.0;
         freqIndex++;
         if (freqIndex >= MAX_FREQ_BINS) break;
     }
@@ -104,11 +116,9 @@ void MicDetector::estimateNoiseFloor() {
     unsigned long startTime = millis();
     
     while (millis() - startTime < calibrationTime) {
-        size_t bytesRead = 0;
-        esp_err_t err = i2s_read(I2S_PORT, audioBuffer, sizeof(audioBuffer),
-                                 &bytesRead, 10);  // 10ms timeout
+        size_t bytesRead = readBlock(10);  // 10ms timeout
         
-        if (err == ESP_OK && bytesRead > 0) {
+        if (bytesRead > 0) {
             int samplesRead = bytesRead / sizeof(int32_t);
             
             // Process with middle frequency for noise estimation
@@ -130,9 +140,67 @@ void MicDetector::estimateNoiseFloor() {
     Serial.printf("Noise floor calibrated: %.1f\n", noiseFloor);
 }
 
+size_t MicDetector::readBlock(TickType_t timeout) {
+    // Drain driver events: every RX_DONE is one DMA buffer filled
+    i2s_event_t event;
+    while (i2sEvents && xQueueReceive(i2sEvents, &event, 0) == pdTRUE) {
+        if (event.type == I2S_EVENT_RX_DONE) {
+            pendingBytes += DMA_BUF_LEN * sizeof(int32_t);
+        } else if (event.type == I2S_EVENT_RX_Q_OVF) {
+            audioStats.overruns++;
+        }
+    }
+    
+    // Fill as seen at read time = how close the ring came to overflowing
+    if (pendingBytes > DMA_RING_BYTES) pendingBytes = DMA_RING_BYTES;
+    audioStats.fillPercent = pendingBytes * 100 / DMA_RING_BYTES;
+    if (audioStats.fillPercent > audioStats.peakFillPercent) {
+        audioStats.peakFillPercent = audioStats.fillPercent;
+    }
+    
+    size_t bytesRead = 0;
+    esp_err_t err = i2s_read(I2S_PORT, audioBuffer, sizeof(audioBuffer),
+                             &bytesRead, timeout);
+    if (err != ESP_OK) {
+        return 0;
+    }
+    
+    pendingBytes = (bytesRead > pendingBytes) ? 0 : pendingBytes - bytesRead;
+    if (bytesRead > 0) {
+        audioStats.blocksRead++;
+    }
+    return bytesRead;
+}
+
+void MicDetector::blockWindow(int samplesRead, int64_t readUs, int64_t& fromUs, int64_t& toUs) const {
+    // pendingBytes was updated by the read: samples recorded after this block
+    toUs = readUs - (int64_t)(pendingBytes / sizeof(int32_t)) * 1000000 / SAMPLE_RATE;
+    fromUs = toUs - (int64_t)samplesRead * 1000000 / SAMPLE_RATE - BLOCK_TIME_SLACK_US;
+}
+
+void MicDetector::noteOwnTone(int64_t startUs, int64_t endUs, uint16_t frequency) {
+    portENTER_CRITICAL(&ownTonesLock);
+    ownTones.addTone(startUs, endUs, frequency);
+    portEXIT_CRITICAL(&ownTonesLock);
+}
+
+void MicDetector::setRingDownMs(uint32_t ms) {
+    portENTER_CRITICAL(&ownTonesLock);
+    ownTones.configure(ms * 1000, BLANK_HALF_WIDTH_HZ);
+    portEXIT_CRITICAL(&ownTonesLock);
+}
+
+void MicDetector::discardAudioEvents() {
+    i2s_event_t event;
+    while (i2sEvents && xQueueReceive(i2sEvents, &event, 0) == pdTRUE) {
+    }
+    pendingBytes = 0;
+}
+
 void MicDetector::startListening() {
     if (!listening) {
         listening = true;
+        discardAudioEvents();
         lastMagnitude = 0.0;
         detectedFrequency = 0.0;
         
@@ -150,24 +218,107 @@ void MicDetector::stopListening() {
     }
 }
 
+void MicDetector::startShotListening() {
+    if (!shotListening) {
+        shotListening = true;
+        discardAudioEvents();
+        lastShotUs = 0;
+        Serial.println("Mic: Listening for shots...");
+    }
+}
+
+void MicDetector::stopShotListening() {
+    if (shotListening) {
+        shotListening = false;
+        Serial.println("Mic: Stopped shot listening");
+    }
+}
+
+bool MicDetector::updateShots(int64_t& shotUs) {
+    if (!shotListening) {
+        return false;
+    }
+    
+    size_t bytesRead = readBlock(0);  // Non-blocking read
+    if (bytesRead == 0) {
+        return false;
+    }
+    int64_t readUs = esp_timer_get_time();
+    int samplesRead = bytesRead / sizeof(int32_t);
+    
+    for (int i = 0; i < samplesRead; i++) {
+        notchBuffer[i] = (float)(audioBuffer[i] >> 14) / 131072.0;
+    }
+    
+    // Our own beeps (warnings during a stage) notched out - a report is
+    // broadband and stays above the level
+    int64_t fromUs, toUs;
+    blockWindow(samplesRead, readUs, fromUs, toUs);
+    uint16_t toneHz[ToneBlanker::MAX_TONES];
+    portENTER_CRITICAL(&ownTonesLock);
+    int tones = ownTones.activeTones(fromUs, toUs, toneHz, ToneBlanker::MAX_TONES);
+    portEXIT_CRITICAL(&ownTonesLock);
+    
+    int first = 0;
+    for (int t = 0; t < tones; t++) {
+        int settle = ToneBlanker::notch(notchBuffer, samplesRead, toneHz[t], SAMPLE_RATE);
+        if (settle > first) first = settle;
+    }
+    if (tones > 0) {
+        blankedBlocks++;
+    }
+    
+    // First sample over the shot level - a report saturates the mic.
+    // Onset, not peak: the peak can fall into the next block.
+    int onset = -1;
+    for (int i = first; i < samplesRead; i++) {
+        if (fabs(notchBuffer[i]) >= SHOT_LEVEL) {
+            onset = i;
+            break;
+        }
+    }
+    if (onset < 0) {
+        return false;
+    }
+    
+    // Everything after the onset (rest of the block, still in DMA) is newer
+    int samplesAfter = (samplesRead - 1 - onset) + pendingBytes / sizeof(int32_t);
+    int64_t atUs = readUs - (int64_t)samplesAfter * 1000000 / SAMPLE_RATE;
+    
+    if (lastShotUs != 0 && atUs - lastShotUs < SHOT_REFRACTORY_US) {
+        return false;
+    }
+    lastShotUs = atUs;
+    shotUs = atUs;
+    return true;
+}
+
 bool MicDetector::update() {
     if (!listening && !diagnosticMode) {
         return false;
     }
 
     // Read audio samples from I2S
-    size_t bytesRead = 0;
-    esp_err_t err = i2s_read(I2S_PORT, audioBuffer, sizeof(audioBuffer),
-                             &bytesRead, 0);  // Non-blocking read
+    size_t bytesRead = readBlock(0);  // Non-blocking read
 
-    if (err != ESP_OK || bytesRead == 0) {
+    if (bytesRead == 0) {
         return false;  // No data available yet
     }
 
     int samplesRead = bytesRead / sizeof(int32_t);
+    
+    // Bins on our own buzzer tones (and their ring-down) do not count
+    int64_t fromUs, toUs;
+    blockWindow(samplesRead, esp_timer_get_time(), fromUs, toUs);
+    portENTER_CRITICAL(&ownTonesLock);
+    uint32_t blankMask = ownTones.binMask(fromUs, toUs, targetFrequencies, numFrequencies);
+    portEXIT_CRITICAL(&ownTonesLock);
+    if (blankMask) {
+        blankedBlocks++;
+    }
 
     // Process block with multiple Goertzel filters
-    float magnitude = processMultiFrequency(audioBuffer, samplesRead);
+    float magnitude = processMultiFrequency(audioBuffer, samplesRead, blankMask);
     lastMagnitude = magnitude;
 
     // Detection logic: magnitude threshold AND signal-to-noise ratio
@@ -196,11 +347,9 @@ bool MicDetector::update() {
 
 float MicDetector::updateDiagnostic() {
     // Read audio samples from I2S
-    size_t bytesRead = 0;
-    esp_err_t err = i2s_read(I2S_PORT, audioBuffer, sizeof(audioBuffer),
-                             &bytesRead, 0);  // Non-blocking read
+    size_t bytesRead = readBlock(0);  // Non-blocking read
 
-    if (err != ESP_OK || bytesRead == 0) {
+    if (bytesRead == 0) {
         return lastMagnitude;  // Return last value if no new data
     }
 
@@ -266,6 +415,7 @@ MicStats MicDetector::getStats() const {
 }
 
 void MicDetector::startDiagnostic() {
+    discardAudioEvents();
     diagnosticMode = true;
     listening = true;  // Enable audio processing
     resetStats();
@@ -321,15 +471,16 @@ float MicDetector::processBlock(int32_t* samples, int numSamples, float coeff) {
     return magnitude;
 }
 
-float MicDetector::processMultiFrequency(int32_t* samples, int numSamples) {
+float MicDetector::processMultiFrequency(int32_t* samples, int numSamples, uint32_t blankMask) {
     float maxMagnitude = 0.0;
     float maxFrequency = 0.0;
     
     // Process with all frequency filters
     for (int i = 0; i < numFrequencies; i++) {
         float magnitude = processBlock(samples, numSamples, coefficients[i]);
+        binMagnitudes[i] = magnitude;
         
-        if (magnitude > maxMagnitude) {
+        if (!(blankMask & (1UL << i)) && magnitude > maxMagnitude) {
             maxMagnitude = magnitude;
             maxFrequency = targetFrequencies[i];
         }
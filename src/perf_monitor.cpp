@@ -0,0 +1,150 @@
+#include "perf_monitor.h"
+#include "display_manager.h"
+#include "mic_detector.h"
+#include <algorithm>
+
+PerfMonitor perfMonitor;
+
+static const char* SECTION_NAMES[PERF_SECTION_COUNT] = {"level", "mic", "display"};
+
+PerfMonitor::PerfMonitor() {
+    cyclesPerUs = 240;
+    windowStartMs = 0;
+    loopCount = 0;
+    lastLoopStamp = 0;
+    loopMaxCycles = 0;
+    lastDisplayBytes = 0;
+    frameHead = 0;
+    frameCount = 0;
+    overlayOn = false;
+    memset(sectionCycles, 0, sizeof(sectionCycles));
+    memset(sectionCount, 0, sizeof(sectionCount));
+    memset(&summary, 0, sizeof(summary));
+}
+
+void PerfMonitor::begin() {
+    cyclesPerUs = ESP.getCpuFreqMHz();
+    windowStartMs = millis();
+    lastLoopStamp = stamp();
+}
+
+void PerfMonitor::markLoop() {
+    uint32_t now = stamp();
+    uint32_t pass = now - lastLoopStamp;  // wraps every ~17 s, deltas stay valid
+    lastLoopStamp = now;
+
+    loopCount++;
+    if (pass > loopMaxCycles) {
+        loopMaxCycles = pass;
+    }
+}
+
+void PerfMonitor::record(PerfSection section, uint32_t startCycles) {
+    uint32_t cycles = stamp() - startCycles;
+    sectionCycles[section] += cycles;
+    sectionCount[section]++;
+
+    if (section == PERF_DISPLAY) {
+        frameCycles[frameHead] = cycles;
+        frameHead = (frameHead + 1) % FRAME_SAMPLES;
+        if (frameCount < FRAME_SAMPLES) frameCount++;
+    }
+}
+
+void PerfMonitor::update() {
+    unsigned long now = millis();
+    if (now - windowStartMs < REPORT_INTERVAL_MS) return;
+
+    uint32_t t0 = stamp();
+    closeWindow(now);
+    if (overlayOn) {
+        pushOverlay();
+    }
+    summary.selfUs = (stamp() - t0) / cyclesPerUs;
+}
+
+void PerfMonitor::closeWindow(unsigned long nowMs) {
+    uint32_t windowMs = nowMs - windowStartMs;
+
+    summary.loopHz = loopCount * 1000UL / windowMs;
+    summary.loopMaxUs = loopMaxCycles / cyclesPerUs;
+    summary.frameP50Us = framePercentileUs(50);
+    summary.frameP99Us = framePercentileUs(99);
+
+    for (int i = 0; i < PERF_SECTION_COUNT; i++) {
+        summary.sectionAvgUs[i] = sectionCount[i] ? (sectionCycles[i] / sectionCount[i]) / cyclesPerUs : 0;
+        sectionCycles[i] = 0;
+        sectionCount[i] = 0;
+    }
+
+    // The display command resets its counters - treat a drop as a fresh start
+    uint32_t bytes = display.getStats().totalBytes;
+    uint32_t delta = (bytes >= lastDisplayBytes) ? bytes - lastDisplayBytes : bytes;
+    summary.displayBytesPerSec = (uint64_t)delta * 1000ULL / windowMs;
+    lastDisplayBytes = bytes;
+
+    windowStartMs = nowMs;
+    loopCount = 0;
+    loopMaxCycles = 0;
+}
+
+uint32_t PerfMonitor::framePercentileUs(int percent) const {
+    if (frameCount == 0) return 0;
+
+    // Copy and select - 128 samples twice a second
+    uint32_t sorted[FRAME_SAMPLES];
+    memcpy(sorted, frameCycles, frameCount * sizeof(uint32_t));
+    int index = (frameCount - 1) * percent / 100;
+    std::nth_element(sorted, sorted + index, sorted + frameCount);
+    return sorted[index] / cyclesPerUs;
+}
+
+void PerfMonitor::setOverlay(bool on) {
+    overlayOn = on;
+    display.showPerfOverlay(on);
+    if (on) {
+        pushOverlay();
+    }
+    Serial.printf("Perf overlay %s\n", on ? "on" : "off");
+}
+
+void PerfMonitor::pushOverlay() {
+    MicAudioStats audio = micDetector.getAudioStats();
+    micDetector.clearAudioPeak();
+
+    // 27 chars fit at text size 1
+    char line[32];
+    snprintf(line, sizeof(line), "Loop %lu Hz max %lu us",
+             (unsigned long)summary.loopHz, (unsigned long)summary.loopMaxUs);
+    display.setPerfLine(0, line);
+
+    snprintf(line, sizeof(line), "Frame p50 %lu p99 %lu us",
+             (unsigned long)summary.frameP50Us, (unsigned long)summary.frameP99Us);
+    display.setPerfLine(1, line);
+
+    snprintf(line, sizeof(line), "SPI %lu.%lu kB/s",
+             (unsigned long)(summary.displayBytesPerSec / 1000),
+             (unsigned long)(summary.displayBytesPerSec % 1000) / 100);
+    display.setPerfLine(2, line);
+
+    snprintf(line, sizeof(line), "I2S %u%% pk %u%% ovr %lu",
+             audio.fillPercent, audio.peakFillPercent, (unsigned long)audio.overruns);
+    display.setPerfLine(3, line);
+}
+
+void PerfMonitor::printReport() const {
+    MicAudioStats audio = micDetector.getAudioStats();
+
+    Serial.printf("Perf: loop %lu Hz, longest pass %lu us\n",
+                  (unsigned long)summary.loopHz, (unsigned long)summary.loopMaxUs);
+    Serial.printf("Perf: frame p50 %lu us, p99 %lu us (last %d frames)\n",
+                  (unsigned long)summary.frameP50Us, (unsigned long)summary.frameP99Us, frameCount);
+    for (int i = 0; i < PERF_SECTION_COUNT; i++) {
+        Serial.printf("Perf: %-8s avg %lu us\n", SECTION_NAMES[i], (unsigned long)summary.sectionAvgUs[i]);
+    }
+    Serial.printf("Perf: display %lu B/s\n", (unsigned long)summary.displayBytesPerSec);
+    Serial.printf("Perf: I2S fill %u%% (peak %u%%), %lu overruns, %lu blocks\n",
+                  audio.fillPercent, audio.peakFillPercent,
+                  (unsigned long)audio.overruns, (unsigned long)audio.blocksRead);
+    Serial.printf("Perf: monitor self time %lu us per report\n", (unsigned long)summary.selfUs);
+}
@@ -0,0 +1,453 @@
+#include "power_manager.h"
+#include "display_manager.h"
+#include "level_monitor.h"
+#include "settings.h"
+#include "timer_wheel.h"
+#include <FastLED.h>
+#include <esp_sleep.h>
+#include <driver/gpio.h>
+#include <driver/rtc_io.h>
+#include <driver/ledc.h>
+#include <sys/time.h>
+
+extern CRGB leds[];
+
+PowerManager powerManager;
+
+// Survives deep sleep so the wake report can cover the whole sleep cycle
+#define RTC_STATS_MAGIC 0x534C5031  // "SLP1"
+RTC_DATA_ATTR static uint32_t rtcMagic = 0;
+RTC_DATA_ATTR static int64_t rtcSleepStartUs = 0;
+RTC_DATA_ATTR static uint64_t rtcActiveMs = 0;
+RTC_DATA_ATTR static uint64_t rtcLightSleepMs = 0;
+RTC_DATA_ATTR static uint32_t rtcDeepSleepCount = 0;
+
+// RTC-backed wall clock keeps counting through deep sleep
+static int64_t wallClockUs() {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (int64_t)tv.tv_sec * 1000000LL + tv.tv_usec;
+}
+
+PowerManager::PowerManager() {
+    qmi = nullptr;
+    motionReferenceAngle = 0;
+    activeSinceMs = 0;
+    activeMs = 0;
+    lightSleepMs = 0;
+    appliedBacklight = -1;
+    memset(&displayActivity, 0, sizeof(displayActivity));
+    napEnabled = true;
+    encoderIsr = nullptr;
+    backlightOnRcFast = false;
+    napCount = 0;
+    napGpioWakes = 0;
+    napUs = 0;
+    napLatencySumUs = 0;
+    napTimerWakes = 0;
+    napMaxLatencyUs = 0;
+    napStatsSinceMs = 0;
+}
+
+void PowerManager::begin(SensorQMI8658* qmiPtr) {
+    qmi = qmiPtr;
+    policy.configure(LIGHT_SLEEP_AFTER_MS, DEEP_SLEEP_AFTER_MS);
+    policy.notifyActivity(millis());
+    motionReferenceAngle = levelMonitor.getFilteredAngle();
+    activeSinceMs = millis();
+
+    governor.configure(DIM_AFTER_MS, DisplayManager::FINE_TIME_BELOW_MS);
+    governor.notifyActivity(millis());
+    governor.skipElapsed(millis());
+
+    // Wake pins are plain inputs while awake
+    pinMode(IMU_WAKE_PIN, INPUT);
+    resetNapStats();
+
+    Serial.printf("Power: light sleep after %lus, deep sleep after %lus\n",
+                  (unsigned long)(LIGHT_SLEEP_AFTER_MS / 1000),
+                  (unsigned long)(DEEP_SLEEP_AFTER_MS / 1000));
+}
+
+bool PowerManager::wokeFromDeepSleep() const {
+    esp_sleep_wakeup_cause_t cause = esp_sleep_get_wakeup_cause();
+    return cause == ESP_SLEEP_WAKEUP_EXT0 || cause == ESP_SLEEP_WAKEUP_EXT1;
+}
+
+void PowerManager::notifyActivity() {
+    if (policy.getState() != POWER_ACTIVE) {
+        // Woken by the deep sleep timer but the user showed up first
+        restoreAfterSleep();
+    }
+    policy.notifyActivity(millis());
+    governor.notifyActivity(millis());
+
+    // Full panel back before anything (menu, ready screen) draws on it
+    display.setStandby(false);
+}
+
+void PowerManager::setInhibited(bool inhibit) {
+    policy.setInhibited(inhibit, millis());
+}
+
+void PowerManager::setDisplayActivity(const DisplayActivity& activity) {
+    displayActivity = activity;
+}
+
+void PowerManager::update() {
+    if (!qmi) return;
+
+    // Handling the rifle counts as activity even without touching the encoder
+    float angle = levelMonitor.getFilteredAngle();
+    if (fabs(angle - motionReferenceAngle) > MOTION_ACTIVITY_DEG) {
+        motionReferenceAngle = angle;
+        notifyActivity();
+    }
+
+    // Frame rate and backlight for this pass; the panel only hears about changes
+    governor.update(millis(), displayActivity, constrain(settings.displayBrightness, 0, 255));
+    if (governor.getBacklight() != appliedBacklight) {
+        appliedBacklight = governor.getBacklight();
+        display.setBrightness(appliedBacklight);
+    }
+
+    // Dimmed main screen drops to partial/idle panel mode (not over the menu)
+    display.setStandby(governor.getMode() == DISPLAY_MODE_DIMMED && !displayActivity.menuOpen);
+
+    switch (policy.update(millis())) {
+        case POWER_ACTION_LIGHT_SLEEP:
+            enterLightSleep();
+            break;
+        case POWER_ACTION_DEEP_SLEEP:
+            enterDeepSleep();
+            break;
+        default:
+            break;
+    }
+}
+
+void PowerManager::setNapEnabled(bool enable) {
+    napEnabled = enable;
+    napMaxLatencyUs = 0;
+}
+
+void PowerManager::resetNapStats() {
+    napCount = 0;
+    napGpioWakes = 0;
+    napUs = 0;
+    napLatencySumUs = 0;
+    napTimerWakes = 0;
+    napMaxLatencyUs = 0;
+    napStatsSinceMs = millis();
+}
+
+void PowerManager::armNapWake(int pin) {
+    // Wake on whichever level the pin is not at now (encoder A/B rest at
+    // either level depending on the detent)
+    gpio_wakeup_enable((gpio_num_t)pin,
+                       digitalRead(pin) == HIGH ? GPIO_INTR_LOW_LEVEL : GPIO_INTR_HIGH_LEVEL);
+}
+
+void PowerManager::keepBacklightInSleep() {
+    // The backlight channel's LEDC timer 0 is set up on the APB clock,
+    // which stops in light sleep
+    if (backlightOnRcFast) return;
+
+    ledc_timer_config_t cfg = {};
+    cfg.speed_mode = LEDC_LOW_SPEED_MODE;
+    cfg.duty_resolution = LEDC_TIMER_8_BIT;
+    cfg.timer_num = LEDC_TIMER_0;
+    cfg.freq_hz = LCD_BL_PWM_HZ;
+    cfg.clk_cfg = LEDC_USE_RTC8M_CLK;
+    backlightOnRcFast = ledc_timer_config(&cfg) == ESP_OK;
+    esp_sleep_pd_config(ESP_PD_DOMAIN_RTC8M, ESP_PD_OPTION_ON);
+}
+
+bool PowerManager::nap(bool allowed) {
+    if (!allowed || !napEnabled || !qmi) return false;
+
+    // Only the quiet main screen - right after input stay fully awake
+    DisplayMode mode = governor.getMode();
+    if (mode != DISPLAY_MODE_IDLE && mode != DISPLAY_MODE_DIMMED) return false;
+
+    // USB host attached: the USB-Serial/JTAG link drops in light sleep,
+    // and on USB power there is no battery to save
+    if (Serial) return false;
+
+    // Earliest of: next frame, wheel job, IMU sample, sleep policy
+    uint32_t now = millis();
+    uint32_t napMs = governor.msUntilFrame(now);
+
+    uint32_t jobMs;
+    if (scheduler.nextDeadline(now, jobMs) && jobMs < napMs) {
+        napMs = jobMs;
+    }
+
+    uint32_t sinceSampleMs = (micros() - levelMonitor.getSampleUs()) / 1000;
+    uint32_t imuMs = sinceSampleMs >= IMU_SAMPLE_MS ? 0 : IMU_SAMPLE_MS - sinceSampleMs;
+    napMs = min(napMs, imuMs);
+    napMs = min(napMs, policy.msUntilNextTransition(now));
+    if (napMs < MIN_NAP_MS) return false;
+
+    keepBacklightInSleep();
+
+    // Encoder edge ISRs off meanwhile - a level wake source would retrigger them
+    gpio_intr_disable((gpio_num_t)ENCODER_CLK);
+    gpio_intr_disable((gpio_num_t)ENCODER_DT);
+    armNapWake(ENCODER_CLK);
+    armNapWake(ENCODER_DT);
+    armNapWake(ENCODER_SW);
+    armNapWake(BOOT_BUTTON);
+    armNapWake(IMU_WAKE_PIN);
+    esp_sleep_enable_gpio_wakeup();
+
+    uint64_t sleepUs = (uint64_t)napMs * 1000ULL;
+    esp_sleep_enable_timer_wakeup(sleepUs);
+
+    int64_t startUs = esp_timer_get_time();
+    esp_light_sleep_start();
+    int64_t wakeUs = esp_timer_get_time();
+
+    esp_sleep_wakeup_cause_t cause = esp_sleep_get_wakeup_cause();
+    esp_sleep_disable_wakeup_source(ESP_SLEEP_WAKEUP_ALL);
+    gpio_wakeup_disable((gpio_num_t)ENCODER_CLK);
+    gpio_wakeup_disable((gpio_num_t)ENCODER_DT);
+    gpio_wakeup_disable((gpio_num_t)ENCODER_SW);
+    gpio_wakeup_disable((gpio_num_t)BOOT_BUTTON);
+    gpio_wakeup_disable((gpio_num_t)IMU_WAKE_PIN);
+
+    // Pick up the edge that woke us before the ISR is back
+    gpio_set_intr_type((gpio_num_t)ENCODER_CLK, GPIO_INTR_ANYEDGE);
+    gpio_set_intr_type((gpio_num_t)ENCODER_DT, GPIO_INTR_ANYEDGE);
+    if (encoderIsr) {
+        encoderIsr();
+    }
+    gpio_intr_enable((gpio_num_t)ENCODER_CLK);
+    gpio_intr_enable((gpio_num_t)ENCODER_DT);
+
+    napCount++;
+    napUs += wakeUs - startUs;
+
+    if (cause != ESP_SLEEP_WAKEUP_TIMER) {
+        napGpioWakes++;
+        return true;
+    }
+
+    // Overshoot of a timer wake: sleep entry + wake-up, the same path a
+    // GPIO wake takes
+    int64_t overUs = wakeUs - startUs - (int64_t)sleepUs;
+    uint32_t latencyUs = overUs > 0 ? (uint32_t)overUs : 0;
+    napTimerWakes++;
+    napLatencySumUs += latencyUs;
+    if (latencyUs > napMaxLatencyUs) {
+        napMaxLatencyUs = latencyUs;
+    }
+    if (latencyUs > MAX_WAKE_LATENCY_US) {
+        napEnabled = false;
+        Serial.printf("Power: nap wake-up took %lu us (budget %lu us) - naps off\n",
+                      (unsigned long)latencyUs, (unsigned long)MAX_WAKE_LATENCY_US);
+    }
+    return true;
+}
+
+void PowerManager::printNapReport() {
+    uint32_t spanMs = millis() - napStatsSinceMs;
+
+    Serial.printf("Power: naps %s, %lu naps in %lus (%lu woken by input)\n",
+                  napEnabled ? "on" : "off", (unsigned long)napCount,
+                  (unsigned long)(spanMs / 1000), (unsigned long)napGpioWakes);
+    if (napCount > 0 && spanMs > 0) {
+        float share = (napUs / 1000.0f) / spanMs;
+        // Backlight draws the same napping or awake
+        float savedMa = share * (EST_ACTIVE_MA - EST_BACKLIGHT_MA - EST_LIGHT_SLEEP_MA);
+        Serial.printf("Power: napped %.0f%% of the time, avg %lu ms, est. %.1f mA lower average\n",
+                      share * 100.0f, (unsigned long)(napUs / 1000 / napCount), savedMa);
+    }
+    if (napTimerWakes > 0) {
+        Serial.printf("Power: wake-up avg %lu us, max %lu us (budget %lu us)\n",
+                      (unsigned long)(napLatencySumUs / napTimerWakes),
+                      (unsigned long)napMaxLatencyUs, (unsigned long)MAX_WAKE_LATENCY_US);
+    }
+    if (Serial) {
+        Serial.println("Power: (no naps while a USB host is attached)");
+    }
+    resetNapStats();
+}
+
+bool PowerManager::armWakeOnMotion() {
+    // Accel drops to low-power 128Hz, gyro off. The INT pin idles low
+    // and toggles high on the first motion event.
+    int err = qmi->configWakeOnMotion(WOM_THRESHOLD_MG,
+                                      SensorQMI8658::ACC_ODR_LOWPOWER_128Hz,
+                                      SensorQMI8658::INTERRUPT_PIN_1,
+                                      0);
+    if (err < 0) {
+        Serial.println("Power: WARNING - wake-on-motion setup failed");
+        return false;
+    }
+    return true;
+}
+
+void PowerManager::restoreAfterSleep() {
+    unsigned long t0 = micros();
+
+    // Leave wake-on-motion and bring accel + gyro back to full rate
+    qmi->reset();
+    levelMonitor.configureSensors();
+
+    display.setBrightness(settings.displayBrightness);
+    appliedBacklight = settings.displayBrightness;
+    governor.notifyActivity(millis());
+    governor.skipElapsed(millis());
+    motionReferenceAngle = levelMonitor.getFilteredAngle();
+    activeSinceMs = millis();
+
+    Serial.printf("Power: display and IMU restored in %lu us\n", (unsigned long)(micros() - t0));
+}
+
+void PowerManager::enterLightSleep() {
+    Serial.println("Power: idle - entering light sleep");
+    Serial.flush();
+
+    activeMs += millis() - activeSinceMs;
+
+    // Panel keeps its contents, only the backlight goes dark
+    display.setBrightness(0);
+    leds[0] = CRGB::Black;
+    FastLED.show();
+
+    armWakeOnMotion();
+
+    gpio_wakeup_enable((gpio_num_t)ENCODER_SW, GPIO_INTR_LOW_LEVEL);
+    gpio_wakeup_enable((gpio_num_t)IMU_WAKE_PIN, GPIO_INTR_HIGH_LEVEL);
+    esp_sleep_enable_gpio_wakeup();
+
+    // Timer wake to hand over to deep sleep (small margin so the policy is due)
+    uint32_t untilDeep = policy.msUntilNextTransition(millis());
+    if (untilDeep != UINT32_MAX) {
+        esp_sleep_enable_timer_wakeup(((uint64_t)untilDeep + 50) * 1000ULL);
+    }
+
+    int64_t sleepStartUs = esp_timer_get_time();
+    esp_light_sleep_start();
+    int64_t wakeUs = esp_timer_get_time();
+
+    esp_sleep_wakeup_cause_t cause = esp_sleep_get_wakeup_cause();
+    esp_sleep_disable_wakeup_source(ESP_SLEEP_WAKEUP_ALL);
+    gpio_wakeup_disable((gpio_num_t)ENCODER_SW);
+    gpio_wakeup_disable((gpio_num_t)IMU_WAKE_PIN);
+
+    lightSleepMs += (wakeUs - sleepStartUs) / 1000;
+
+    if (cause == ESP_SLEEP_WAKEUP_TIMER) {
+        // Nobody came back - continue straight into deep sleep
+        if (policy.update(millis()) == POWER_ACTION_DEEP_SLEEP) {
+            enterDeepSleep();
+        }
+        return;
+    }
+
+    restoreAfterSleep();
+    policy.notifyActivity(millis());
+
+    Serial.printf("Power: woke from light sleep (%s) after %llds, wake-to-ready %lld us\n",
+                  digitalRead(ENCODER_SW) == LOW ? "button" : "motion",
+                  (long long)((wakeUs - sleepStartUs) / 1000000LL),
+                  (long long)(esp_timer_get_time() - wakeUs));
+}
+
+void PowerManager::enterDeepSleep() {
+    Serial.println("Power: idle - entering deep sleep");
+
+    // RAM is lost - a debounced settings write must land first
+    settings.flush();
+
+    if (policy.getState() == POWER_ACTIVE) {
+        activeMs += millis() - activeSinceMs;
+    }
+
+    // Everything off: backlight, panel, LED. IMU stays in wake-on-motion.
+    display.setBrightness(0);
+    display.sleep();
+    leds[0] = CRGB::Black;
+    FastLED.show();
+
+    armWakeOnMotion();
+
+    // Encoder button (active low) on EXT0, IMU interrupt (active high) on EXT1
+    rtc_gpio_pullup_en((gpio_num_t)ENCODER_SW);
+    rtc_gpio_pulldown_dis((gpio_num_t)ENCODER_SW);
+    esp_sleep_enable_ext0_wakeup((gpio_num_t)ENCODER_SW, 0);
+    esp_sleep_enable_ext1_wakeup(1ULL << IMU_WAKE_PIN, ESP_EXT1_WAKEUP_ANY_HIGH);
+
+    rtcMagic = RTC_STATS_MAGIC;
+    rtcSleepStartUs = wallClockUs();
+    rtcActiveMs = activeMs;
+    rtcLightSleepMs = lightSleepMs;
+    rtcDeepSleepCount++;
+
+    Serial.flush();
+    esp_deep_sleep_start();
+}
+
+void PowerManager::reportWake() {
+    if (!wokeFromDeepSleep() || rtcMagic != RTC_STATS_MAGIC) return;
+
+    // esp_timer starts at app start, so this excludes the ROM bootloader
+    int64_t readyMs = esp_timer_get_time() / 1000;
+    uint64_t deepSleepMs = (uint64_t)(wallClockUs() - rtcSleepStartUs) / 1000ULL;
+
+    Serial.printf("Power: woke from deep sleep #%lu by %s after %llus\n",
+                  (unsigned long)rtcDeepSleepCount,
+                  esp_sleep_get_wakeup_cause() == ESP_SLEEP_WAKEUP_EXT0 ? "button" : "motion",
+                  (unsigned long long)(deepSleepMs / 1000ULL));
+    Serial.printf("Power: wake-to-ready %lld ms\n", (long long)readyMs);
+
+    activeMs = rtcActiveMs;
+    lightSleepMs = rtcLightSleepMs;
+    printCurrentEstimate(deepSleepMs);
+
+    // Start a fresh accounting cycle
+    activeMs = 0;
+    lightSleepMs = 0;
+    rtcMagic = 0;
+}
+
+void PowerManager::printCurrentEstimate(uint64_t deepSleepMs) {
+    uint64_t totalMs = activeMs + lightSleepMs + deepSleepMs;
+    if (totalMs == 0) return;
+
+    float avgMa = (activeMs * EST_ACTIVE_MA +
+                   lightSleepMs * EST_LIGHT_SLEEP_MA +
+                   deepSleepMs * EST_DEEP_SLEEP_MA) / (float)totalMs;
+
+    Serial.printf("Power: cycle active %llus, light %llus, deep %llus\n",
+                  (unsigned long long)(activeMs / 1000ULL),
+                  (unsigned long long)(lightSleepMs / 1000ULL),
+                  (unsigned long long)(deepSleepMs / 1000ULL));
+    Serial.printf("Power: est. sleep current light %.2f mA, deep %.2f mA, cycle avg %.2f mA\n",
+                  EST_LIGHT_SLEEP_MA, EST_DEEP_SLEEP_MA, avgMa);
+}
+
+void PowerManager::printDisplayReport() {
+    uint32_t totalMs = governor.getTotalMs();
+    DisplayMode mode = governor.getMode();
+    float duty = governor.getBacklightDuty();
+
+    Serial.printf("Power: display %s%s, %lu ms/frame, backlight %u/255\n",
+                  DisplayGovernor::modeName(mode), display.isStandby() ? " (standby)" : "",
+                  (unsigned long)governor.getFrameIntervalMs(), governor.getBacklight());
+
+    if (totalMs > 0) {
+        Serial.printf("Power: over %lus - backlight duty %.0f%% (~%.1f mA), %.1f frames/s\n",
+                      (unsigned long)(totalMs / 1000), duty * 100.0f, duty * EST_BACKLIGHT_MA,
+                      governor.getFrames() * 1000.0f / totalMs);
+        for (int i = 0; i < DISPLAY_MODE_COUNT; i++) {
+            uint32_t ms = governor.getModeMs((DisplayMode)i);
+            if (ms == 0) continue;
+            Serial.printf("Power:   %-8s %3lu%%\n", DisplayGovernor::modeName((DisplayMode)i),
+                          (unsigned long)((uint64_t)ms * 100 / totalMs));
+        }
+    }
+    governor.resetStats();
+}
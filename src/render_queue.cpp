@@ -0,0 +1,195 @@
+#include "render_queue.h"
+#include <stdarg.h>
+
+RenderQueue renderQueue;
+
+RenderQueue::RenderQueue() {
+    tft = nullptr;
+    head = 0;
+    count = 0;
+    textUsed = 0;
+    budgetUs = DEFAULT_BUDGET_US;
+    resetStats();
+}
+
+void RenderQueue::begin(lgfx::LovyanGFX* target) {
+    tft = target;
+}
+
+void RenderQueue::resetStats() {
+    maxSliceUs = 0;
+    steps = 0;
+    overflows = 0;
+}
+
+void RenderQueue::clear() {
+    head = 0;
+    count = 0;
+    textUsed = 0;
+}
+
+RenderQueue::Op* RenderQueue::push(OpType type) {
+    if (count == MAX_OPS) {
+        // Out of slots - finish the backlog the old, blocking way
+        overflows++;
+        flush();
+    }
+    Op* op = &ops[count++];
+    op->type = type;
+    return op;
+}
+
+void RenderQueue::pushText(OpType type, const char* str) {
+    int len = strlen(str) + 1;
+    if (len > TEXT_POOL) return;
+    if (textUsed + len > TEXT_POOL) {
+        overflows++;
+        flush();
+    }
+
+    Op* op = push(type);
+    memcpy(&text[textUsed], str, len);
+    op->value = textUsed;
+    textUsed += len;
+}
+
+void RenderQueue::fillScreen(uint16_t color) {
+    // Everything still pending ends up underneath
+    clear();
+    fillRect(0, 0, tft->width(), tft->height(), color);
+}
+
+void RenderQueue::fillRect(int x, int y, int w, int h, uint16_t color) {
+    Op* op = push(OP_FILL_RECT);
+    op->x = x;
+    op->y = y;
+    op->w = w;
+    op->h = h;
+    op->value = color;
+}
+
+void RenderQueue::drawRect(int x, int y, int w, int h, uint16_t color) {
+    Op* op = push(OP_DRAW_RECT);
+    op->x = x;
+    op->y = y;
+    op->w = w;
+    op->h = h;
+    op->value = color;
+}
+
+void RenderQueue::setCursor(int x, int y) {
+    Op* op = push(OP_CURSOR);
+    op->x = x;
+    op->y = y;
+}
+
+void RenderQueue::setTextSize(int size) {
+    push(OP_TEXT_SIZE)->value = size;
+}
+
+void RenderQueue::setTextColor(uint16_t color) {
+    push(OP_TEXT_COLOR)->value = color;
+}
+
+void RenderQueue::print(const char* str) {
+    pushText(OP_PRINT, str);
+}
+
+void RenderQueue::print(int value) {
+    char buf[12];
+    snprintf(buf, sizeof(buf), "%d", value);
+    pushText(OP_PRINT, buf);
+}
+
+void RenderQueue::print(float value, int decimals) {
+    char buf[24];
+    snprintf(buf, sizeof(buf), "%.*f", decimals, value);
+    pushText(OP_PRINT, buf);
+}
+
+void RenderQueue::println(const char* str) {
+    pushText(OP_PRINTLN, str);
+}
+
+void RenderQueue::printf(const char* format, ...) {
+    char buf[64];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(buf, sizeof(buf), format, args);
+    va_end(args);
+    pushText(OP_PRINT, buf);
+}
+
+bool RenderQueue::runStep(Op& op) {
+    switch (op.type) {
+        case OP_FILL_RECT: {
+            // One band per step; the op shrinks until it is used up
+            int rows = min((int)op.h, FILL_BAND_ROWS);
+            tft->fillRect(op.x, op.y, op.w, rows, op.value);
+            op.y += rows;
+            op.h -= rows;
+            return op.h <= 0;
+        }
+        case OP_DRAW_RECT:
+            tft->drawRect(op.x, op.y, op.w, op.h, op.value);
+            return true;
+        case OP_CURSOR:
+            tft->setCursor(op.x, op.y);
+            return true;
+        case OP_TEXT_SIZE:
+            tft->setTextSize(op.value);
+            return true;
+        case OP_TEXT_COLOR:
+            tft->setTextColor(op.value);
+            return true;
+        case OP_PRINT:
+            tft->print(&text[op.value]);
+            return true;
+        case OP_PRINTLN:
+            tft->println(&text[op.value]);
+            return true;
+    }
+    return true;
+}
+
+bool RenderQueue::service() {
+    if (!tft || head == count) return true;
+
+    unsigned long t0 = micros();
+    tft->startWrite();
+
+    // At least one step per pass, so a tiny budget still makes progress
+    do {
+        if (runStep(ops[head])) {
+            head++;
+        }
+        steps++;
+    } while (head < count && micros() - t0 < budgetUs);
+
+    tft->endWrite();
+
+    uint32_t sliceUs = micros() - t0;
+    if (sliceUs > maxSliceUs) {
+        maxSliceUs = sliceUs;
+    }
+
+    if (head == count) {
+        clear();
+        return true;
+    }
+    return false;
+}
+
+void RenderQueue::flush() {
+    if (!tft) return;
+
+    tft->startWrite();
+    while (head < count) {
+        if (runStep(ops[head])) {
+            head++;
+        }
+        steps++;
+    }
+    tft->endWrite();
+    clear();
+}
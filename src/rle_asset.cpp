@@ -0,0 +1,30 @@
+#include "rle_asset.h"
+
+// Token layout, must match tools/build_assets.py
+#define RLE_LONG_RUN   0x0F   // length nibble: run = 16 + next byte
+#define RLE_LONG_BASE  16
+
+void drawRleAsset(lgfx::LovyanGFX& dst, int x, int y, const RleAsset& asset,
+                  const uint16_t* palette) {
+    if (!palette) {
+        palette = asset.palette;
+    }
+
+    dst.startWrite();
+    dst.setAddrWindow(x, y, asset.width, asset.height);
+
+    const uint8_t* p = asset.data;
+    const uint8_t* end = asset.data + asset.dataSize;
+    while (p < end) {
+        uint8_t token = *p++;
+        uint32_t run = token & 0x0F;
+        if (run == RLE_LONG_RUN) {
+            run = RLE_LONG_BASE + *p++;
+        } else {
+            run += 1;
+        }
+        dst.writeColor(palette[token >> 4], run);
+    }
+
+    dst.endWrite();
+}
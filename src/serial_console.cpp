@@ -0,0 +1,462 @@
+#include "serial_console.h"
+#include "buzzer.h"
+#include "display_manager.h"
+#include "menu_system.h"
+#include "mic_detector.h"
+#include "perf_monitor.h"
+#include "power_manager.h"
+#include "render_queue.h"
+#include "settings.h"
+#include "settings_json.h"
+#include "shot_log.h"
+#include "timer.h"
+#include "timer_wheel.h"
+#include <FastLED.h>
+
+SerialConsole console;
+
+struct ConsoleCommand {
+    const char* name;
+    const char* help;
+    void (*handler)(const char* args);
+};
+
+static void cmdHelp(const char* args);
+
+static void cmdDisplay(const char* args) {
+    const DisplayStats& s = display.getStats();
+    uint32_t fullFrame = 170 * 320 * 2;
+
+    Serial.printf("Display: %lu frames, %lu bytes sent\n",
+                  (unsigned long)s.frames, (unsigned long)s.totalBytes);
+    if (s.frames > 0) {
+        Serial.printf("Display: avg %lu B/frame, last %lu B, peak %lu B (full frame %lu B)\n",
+                      (unsigned long)(s.totalBytes / s.frames), (unsigned long)s.lastFrameBytes,
+                      (unsigned long)s.peakFrameBytes, (unsigned long)fullFrame);
+        Serial.printf("Display: %.2f widget repaints/frame\n",
+                      s.widgetsPainted / (float)s.frames);
+    }
+    Serial.printf("Display: longest frame render %lu us, %lu frames over the %lu us budget\n",
+                  (unsigned long)s.maxFrameUs, (unsigned long)s.overBudgetFrames,
+                  (unsigned long)DisplayManager::FRAME_BUDGET_US);
+    Serial.printf("Display: longest loop() block in display code %lu us (%s)\n",
+                  (unsigned long)s.maxBlockUs, display.isAsyncPresent() ? "async DMA" : "blocking");
+    Serial.printf("Display: longest render queue slice %lu us (budget %lu us), %lu overflow flushes\n",
+                  (unsigned long)renderQueue.getMaxSliceUs(), (unsigned long)renderQueue.getBudgetUs(),
+                  (unsigned long)renderQueue.getOverflows());
+    display.resetStats();
+    renderQueue.resetStats();
+}
+
+static void cmdQueue(const char* args) {
+    if (*args) {
+        int us = atoi(args);
+        if (us < 100 || us > 20000) {
+            Serial.println("Budget must be 100..20000 us");
+            return;
+        }
+        renderQueue.setBudgetUs(us);
+    }
+    Serial.printf("Render queue: %lu us per pass, %lu steps, longest slice %lu us\n",
+                  (unsigned long)renderQueue.getBudgetUs(), (unsigned long)renderQueue.getSteps(),
+                  (unsigned long)renderQueue.getMaxSliceUs());
+}
+
+static void cmdDma(const char* args) {
+    if (strcmp(args, "on") == 0) {
+        display.setAsyncPresent(true);
+    } else if (strcmp(args, "off") == 0) {
+        display.setAsyncPresent(false);
+    } else {
+        Serial.printf("DMA presentation is %s (dma on|off)\n",
+                      display.isAsyncPresent() ? "on" : "off");
+        return;
+    }
+    display.invalidate();
+    display.resetStats();
+}
+
+static void cmdMenu(const char* args) {
+    if (strcmp(args, "full") == 0) {
+        menu.setFullRedraw(true);
+    } else if (strcmp(args, "rows") == 0) {
+        menu.setFullRedraw(false);
+    } else {
+        menu.printReport();
+        return;
+    }
+    menu.resetStats();
+}
+
+static void cmdBench(const char* args) {
+    display.runRenderBenchmark();
+    // Benchmark drew into scratch memory only, but it stalls loop() for a while
+    display.resetStats();
+}
+
+static void cmdPerf(const char* args) {
+    if (strcmp(args, "on") == 0) {
+        perfMonitor.setOverlay(true);
+    } else if (strcmp(args, "off") == 0) {
+        perfMonitor.setOverlay(false);
+    } else {
+        perfMonitor.printReport();
+    }
+}
+
+static void cmdCanvas(const char* args) {
+    int bpp = atoi(args);
+    if (bpp != 0 && !display.setCanvasDepth(bpp)) {
+        Serial.println("Usage: canvas [16|8|4]");
+        return;
+    }
+    if (bpp != 0) {
+        // Let the repaint land before timing a full push
+        display.present();
+    }
+    display.printCanvasReport();
+    display.resetStats();
+}
+
+static void cmdLevel(const char* args) {
+    LevelPredictor& p = display.getLevelPredictor();
+    if (strcmp(args, "on") == 0) {
+        p.setEnabled(true);
+    } else if (strcmp(args, "off") == 0) {
+        p.setEnabled(false);
+    }
+
+    Serial.printf("Level: bubble prediction %s, extrapolating %lu us past the sample age\n",
+                  p.isEnabled() ? "on" : "off", (unsigned long)p.getPipelineUs());
+    Serial.printf("Level: sensor-to-photon avg %lu us, max %lu us over %lu bubble frames\n",
+                  (unsigned long)p.getAvgLatencyUs(), (unsigned long)p.getMaxLatencyUs(),
+                  (unsigned long)p.getFrames());
+    if (p.getScored() > 0) {
+        Serial.printf("Level: error on glass rms %.3f deg shown vs %.3f deg uncompensated (%lu frames)\n",
+                      p.getRmsErrorPredicted(), p.getRmsErrorRaw(), (unsigned long)p.getScored());
+    }
+    p.resetStats();
+}
+
+static void cmdTimer(const char* args) {
+    Serial.printf("Timer: warnings/alarm fired at most %lu us after their deadline\n",
+                  (unsigned long)timer.getMaxLatenessUs());
+    Serial.printf("Timer: buzzer cue steps switched at most %lu us late\n",
+                  (unsigned long)buzzer.getMaxLatenessUs());
+    timer.resetStats();
+    buzzer.resetStats();
+}
+
+static void cmdNap(const char* args) {
+    if (strcmp(args, "on") == 0) {
+        powerManager.setNapEnabled(true);
+    } else if (strcmp(args, "off") == 0) {
+        powerManager.setNapEnabled(false);
+    }
+    powerManager.printNapReport();
+}
+
+static void cmdBlank(const char* args) {
+    if (*args) {
+        int ms = atoi(args);
+        if (ms < 0 || ms > 500) {
+            Serial.println("Ring-down must be 0..500 ms");
+            return;
+        }
+        micDetector.setRingDownMs(ms);
+    }
+    Serial.printf("Mic: own buzzer tones blanked + %lu ms ring-down, %lu blocks affected\n",
+                  (unsigned long)micDetector.getRingDownMs(),
+                  (unsigned long)micDetector.getBlankedBlocks());
+    micDetector.resetBlankedBlocks();
+}
+
+static void cmdSched(const char* args) {
+    uint32_t nextMs;
+    if (scheduler.nextDeadline(millis(), nextMs)) {
+        Serial.printf("Scheduler: %d jobs pending, next in %lu ms\n",
+                      scheduler.getPending(), (unsigned long)nextMs);
+    } else {
+        Serial.println("Scheduler: no jobs pending");
+    }
+    Serial.printf("Scheduler: jobs ran at most %lu ms late, %lu periods skipped\n",
+                  (unsigned long)scheduler.getMaxLatenessMs(),
+                  (unsigned long)scheduler.getMissedPeriods());
+    scheduler.resetStats();
+}
+
+static void cmdShots(const char* args) {
+    if (strcmp(args, "bin") == 0) {
+        // Header, then the stored splits packed back to back (see shot_log.h)
+        uint8_t buf[ShotLog::BINARY_HEADER_BYTES];
+        Serial.write(buf, shotLog.writeBinaryHeader(buf));
+        for (int i = 0; i < shotLog.getStored(); i++) {
+            ShotLog::packRecord(shotLog.get(i), buf);
+            Serial.write(buf, ShotLog::BINARY_RECORD_BYTES);
+        }
+        return;
+    }
+
+    // CSV: splits of the current/last stage, then the stage summaries
+    Serial.println("stage,shot,time_ms,split_ms,source");
+    int firstShot = shotLog.getShots() - shotLog.getStored() + 1;
+    uint32_t previousUs = 0;
+    for (int i = 0; i < shotLog.getStored(); i++) {
+        const ShotRecord& r = shotLog.get(i);
+        Serial.printf("%u,%d,%.1f,", shotLog.getStage(), firstShot + i, r.atUs / 1000.0f);
+        if (i > 0 || firstShot == 1) {
+            // Shot 1 splits from the start (draw); dropped predecessors leave it empty
+            Serial.printf("%.1f", (r.atUs - previousUs) / 1000.0f);
+        }
+        Serial.printf(",%s\n", r.source == SHOT_MIC ? "mic" : "imu");
+        previousUs = r.atUs;
+    }
+
+    Serial.println("stage,shots,expected,first_ms,fastest_ms,average_ms,total_ms");
+    for (int i = 0; i < shotLog.getSummaryCount(); i++) {
+        const StageSummary& s = shotLog.getSummary(i);
+        Serial.printf("%u,%u,%u,%.1f,%.1f,%.1f,%.1f\n", s.stage, s.shots, s.expected,
+                      s.firstShotUs / 1000.0f, s.fastestSplitUs / 1000.0f,
+                      s.averageSplitUs / 1000.0f, s.lastShotUs / 1000.0f);
+    }
+}
+
+static void cmdPower(const char* args) {
+    powerManager.printDisplayReport();
+}
+
+static void cmdSettings(const char* args) {
+    if (strcmp(args, "flush") == 0) {
+        settings.flush();
+    }
+    settings.printReport();
+}
+
+// Countdown reads the profile live and must not be held up
+static bool timerBusy() {
+    return timer.getState() == TIMER_READY || timer.getState() == TIMER_RUNNING;
+}
+
+static void cmdProfile(const char* args) {
+    if (strncmp(args, "name ", 5) == 0) {
+        const char* name = args + 5;
+        if (*name == '\0') {
+            Serial.println("Usage: profile name <text>");
+            return;
+        }
+        strncpy(settings.profile->name, name, PROFILE_NAME_LEN - 1);
+        settings.profile->name[PROFILE_NAME_LEN - 1] = '\0';
+        settings.save();
+    } else if (strncmp(args, "copy ", 5) == 0) {
+        // Active profile's values into another slot (keeps that slot's name)
+        int slot = atoi(args + 5) - 1;
+        if (slot < 0 || slot >= PROFILE_COUNT || slot == settings.getProfileIndex()) {
+            Serial.printf("Usage: profile copy <1..%d, not the active one>\n", PROFILE_COUNT);
+            return;
+        }
+        SettingsProfile& target = settings.getProfile(slot);
+        char name[PROFILE_NAME_LEN];
+        memcpy(name, target.name, sizeof(name));
+        target = *settings.profile;
+        memcpy(target.name, name, sizeof(name));
+        settings.save();
+    } else if (*args) {
+        int slot = atoi(args) - 1;
+        if (slot < 0 || slot >= PROFILE_COUNT) {
+            Serial.printf("Usage: profile [1..%d | name <text> | copy <n>]\n", PROFILE_COUNT);
+            return;
+        }
+        if (timerBusy()) {
+            Serial.println("Stop the timer before switching profiles");
+            return;
+        }
+        settings.selectProfile(slot);
+        micDetector.setThreshold(settings.profile->micThreshold);
+    }
+
+    for (int i = 0; i < PROFILE_COUNT; i++) {
+        const SettingsProfile& p = settings.getProfile(i);
+        Serial.printf("%c%d %-11s par %d/%d/%d s, tol %.1f deg, mic %.0f, %s\n",
+                      i == settings.getProfileIndex() ? '*' : ' ', i + 1, p.name,
+                      p.parTimeSeconds, p.yellowWarningSeconds, p.redWarningSeconds,
+                      p.tolerance, p.micThreshold,
+                      p.gravity.isCalibrated ? "calibrated" : "not calibrated");
+    }
+}
+
+// "import keepcal": another unit's IMU sits differently, keep ours
+static bool importKeepCalibration = false;
+
+static void onConfigDocument(char* text, size_t length) {
+    if (timerBusy()) {
+        Serial.println("Import: timer is running, nothing changed");
+        return;
+    }
+    if (!importSettingsJson(text, length, importKeepCalibration)) return;
+
+    display.setBrightness(settings.displayBrightness);
+    FastLED.setBrightness(settings.ledBrightness);
+    micDetector.setThreshold(settings.profile->micThreshold);
+    settings.flush();
+}
+
+static void cmdConfig(const char* args) {
+    // Both walk every setting and print or parse ~1 KB: not mid-stage
+    if (timerBusy()) {
+        Serial.println("Stop the timer first");
+        return;
+    }
+
+    if (strcmp(args, "export") == 0) {
+        exportSettingsJson(Serial);
+        Serial.println();
+    } else if (strncmp(args, "import", 6) == 0) {
+        importKeepCalibration = strcmp(args + 6, " keepcal") == 0;
+        console.captureDocument(onConfigDocument);
+        Serial.printf("Paste the JSON document (%lu s timeout)\n",
+                      (unsigned long)(SerialConsole::CAPTURE_TIMEOUT_MS / 1000));
+    } else {
+        Serial.println("Usage: config export | import [keepcal]");
+    }
+}
+
+static const ConsoleCommand commands[] = {
+    {"help",    "List commands",                            cmdHelp},
+    {"display", "Display SPI bytes/frame since last call",  cmdDisplay},
+    {"dma",     "Async DMA presentation on|off",            cmdDma},
+    {"menu",    "Menu latency, or redraw full|rows",        cmdMenu},
+    {"queue",   "Render queue slice budget [us]",           cmdQueue},
+    {"bench",   "Font vs glyph cache render time per readout", cmdBench},
+    {"perf",    "Loop/frame timing report, overlay on|off",  cmdPerf},
+    {"canvas",  "Canvas RAM/push time, depth 16|8|4 bpp",  cmdCanvas},
+    {"power",   "Display mode, backlight duty since last call", cmdPower},
+    {"nap",     "Idle light-sleep naps and wake latency, on|off", cmdNap},
+    {"level",   "Bubble latency and prediction error, on|off", cmdLevel},
+    {"timer",   "Countdown event and buzzer step lateness",  cmdTimer},
+    {"blank",   "Mic ring-down after own buzzer tones [ms]", cmdBlank},
+    {"sched",   "Loop job wheel: pending, next deadline, lateness", cmdSched},
+    {"shots",   "Split log and stage summaries, csv|bin",   cmdShots},
+    {"settings", "Settings blob, NVS ops and write times, flush", cmdSettings},
+    {"profile", "List/switch profiles, name <text>, copy <n>", cmdProfile},
+    {"config",  "Settings and profiles as JSON, export|import [keepcal]", cmdConfig},
+};
+
+static const int COMMAND_COUNT = sizeof(commands) / sizeof(commands[0]);
+
+static void cmdHelp(const char* args) {
+    Serial.println("Commands:");
+    for (int i = 0; i < COMMAND_COUNT; i++) {
+        Serial.printf("  %-10s %s\n", commands[i].name, commands[i].help);
+    }
+}
+
+SerialConsole::SerialConsole() {
+    lineLength = 0;
+    lineBuffer[0] = '\0';
+    captureHandler = nullptr;
+    documentLength = 0;
+    documentDepth = 0;
+    inString = false;
+    escaped = false;
+    lastByteMs = 0;
+}
+
+void SerialConsole::captureDocument(void (*handler)(char* text, size_t length)) {
+    captureHandler = handler;
+    documentLength = 0;
+    documentDepth = 0;
+    inString = false;
+    escaped = false;
+    lastByteMs = millis();
+}
+
+void SerialConsole::endCapture() {
+    captureHandler = nullptr;
+    documentLength = 0;
+}
+
+void SerialConsole::feedDocument(char c) {
+    // Skip anything before the opening brace (line ends after the command)
+    if (documentLength == 0 && c != '{') return;
+
+    if (documentLength >= MAX_DOCUMENT - 1) {
+        Serial.printf("Document over %lu bytes - dropped\n", (unsigned long)MAX_DOCUMENT);
+        endCapture();
+        return;
+    }
+    documentBuffer[documentLength++] = c;
+
+    // Track nesting outside strings to find the closing brace
+    if (inString) {
+        if (escaped) {
+            escaped = false;
+        } else if (c == '\\') {
+            escaped = true;
+        } else if (c == '"') {
+            inString = false;
+        }
+        return;
+    }
+    if (c == '"') {
+        inString = true;
+    } else if (c == '{' || c == '[') {
+        documentDepth++;
+    } else if (c == '}' || c == ']') {
+        documentDepth--;
+    }
+
+    if (documentDepth == 0) {
+        documentBuffer[documentLength] = '\0';
+        void (*handler)(char*, size_t) = captureHandler;
+        size_t length = documentLength;
+        endCapture();
+        handler(documentBuffer, length);
+    }
+}
+
+void SerialConsole::update() {
+    if (captureHandler && millis() - lastByteMs > CAPTURE_TIMEOUT_MS) {
+        Serial.println("Document capture timed out");
+        endCapture();
+    }
+
+    while (Serial.available() > 0) {
+        char c = Serial.read();
+
+        if (captureHandler) {
+            lastByteMs = millis();
+            feedDocument(c);
+            continue;
+        }
+
+        if (c == '\r' || c == '\n') {
+            if (lineLength > 0) {
+                lineBuffer[lineLength] = '\0';
+                dispatch(lineBuffer);
+                lineLength = 0;
+            }
+        } else if (lineLength < MAX_LINE - 1) {
+            lineBuffer[lineLength++] = c;
+        }
+    }
+}
+
+void SerialConsole::dispatch(char* line) {
+    // Split "name args..."
+    char* args = strchr(line, ' ');
+    if (args) {
+        *args++ = '\0';
+        while (*args == ' ') args++;
+    } else {
+        args = line + strlen(line);
+    }
+
+    for (int i = 0; i < COMMAND_COUNT; i++) {
+        if (strcmp(line, commands[i].name) == 0) {
+            commands[i].handler(args);
+            return;
+        }
+    }
+
+    Serial.printf("Unknown command '%s' - type help\n", line);
+}
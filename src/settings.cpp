@@ -1,98 +1,479 @@
 #include "settings.h"
+#include "timer_wheel.h"
 #include <Arduino.h>
+#include <esp_rom_crc.h>
+#include <stddef.h>
 
 Settings settings;  // Global instance
 
+#define SETTINGS_NAMESPACE "stage_timer"
+#define SETTINGS_KEY       "config"
+#define PROFILE_KEY_FORMAT "profile%d"
+
+// The per-key code this replaced, counted from its source (not measured):
+// put* calls per save() and get* calls at boot with a calibration
+#define LEGACY_SAVE_PUTS 11
+#define LEGACY_LOAD_GETS 16
+
+static const char* LEVEL_MODE_NAMES[LEVEL_DISPLAY_MODE_COUNT] = {
+    "Degrees", "Arrow", "Bubble"
+};
+
+const char* levelDisplayModeName(LevelDisplayMode mode) {
+    return (mode >= 0 && mode < LEVEL_DISPLAY_MODE_COUNT) ? LEVEL_MODE_NAMES[mode] : "?";
+}
+
+int warningUpperBound(int aboveSeconds, int minSeconds) {
+    int upper = aboveSeconds - WARNING_GAP_SECONDS;
+    return upper > minSeconds ? upper : minSeconds;
+}
+
+// Device blob fields for dirty tracking (bit i = FIELDS[i])
+struct BlobField {
+    const char* name;
+    uint8_t offset;
+    uint8_t size;
+};
+
+#define BLOB_FIELD(member, name) {name, offsetof(SettingsBlob, member), sizeof(SettingsBlob::member)}
+
+static const BlobField FIELDS[] = {
+    BLOB_FIELD(levelDisplayMode,     "disp_mode"),
+    BLOB_FIELD(displayBrightness,    "disp_bright"),
+    BLOB_FIELD(ledBrightness,        "led_bright"),
+    BLOB_FIELD(buzzerVolume,         "buzzer_vol"),
+    BLOB_FIELD(timerFineDigits,      "fine_digits"),
+    BLOB_FIELD(activeProfile,        "active_profile"),
+};
+
+static const int FIELD_COUNT = sizeof(FIELDS) / sizeof(FIELDS[0]);
+
+template <typename Blob>
+static uint32_t blobCrc(const Blob& blob) {
+    return esp_rom_crc32_le(0, (const uint8_t*)&blob, offsetof(Blob, crc));
+}
+
+template <typename Blob>
+static void sealBlob(Blob& blob, uint16_t magic, uint8_t version) {
+    blob.header.magic = magic;
+    blob.header.version = version;
+    blob.header.size = sizeof(Blob);
+    blob.crc = blobCrc(blob);
+}
+
+template <typename Blob>
+static bool blobValid(const Blob& blob, uint16_t magic, uint8_t version) {
+    return blob.header.magic == magic &&
+           blob.header.version == version &&
+           blob.header.size == sizeof(Blob) &&
+           blob.crc == blobCrc(blob);
+}
+
+static void profileKey(char* key, size_t size, int slot) {
+    snprintf(key, size, PROFILE_KEY_FORMAT, slot);
+}
+
+// Debounced write: every save() pushes the deadline back
+static void onSaveDue(void* arg) {
+    settings.flush();
+}
+
+static WheelJob saveJob(onSaveDue);
+
 Settings::Settings() {
     // Default values
-    tolerance = 0.5;
-    // Hysteresis calculated in level_monitor as 10% of tolerance (0.05 with default)
     levelDisplayMode = LEVEL_DISPLAY_DEGREES;  // Default to degrees
     
     displayBrightness = 255;
     ledBrightness = 50;
-    parTimeSeconds = 60;
-    yellowWarningSeconds = 30;
-    redWarningSeconds = 10;
+    timerFineDigits = 1;
     buzzerVolume = 50;
-    micThreshold = 1500.0;
 
-    gravity.x = 0;
-    gravity.y = 0;
-    gravity.z = 0;
-    gravity.magnitude = 1.0;
-    gravity.isCalibrated = false;
+    for (int i = 0; i < PROFILE_COUNT; i++) {
+        SettingsProfile& p = profiles[i];
+        memset(&p, 0, sizeof(p));
+        snprintf(p.name, sizeof(p.name), "Profile %d", i + 1);
+
+        p.tolerance = 0.5;
+        // Hysteresis calculated in level_monitor as 10% of tolerance (0.05 with default)
+        p.parTimeSeconds = 60;
+        p.yellowWarningSeconds = 30;
+        p.redWarningSeconds = 10;
+        p.stageShots = 0;
+        p.micThreshold = 1500.0;
+
+        p.gravity.x = 0;
+        p.gravity.y = 0;
+        p.gravity.z = 0;
+        p.gravity.magnitude = 1.0;
+        p.gravity.isCalibrated = false;
+    }
+    profile = &profiles[0];
+
+    // Nothing in flash yet: the defaults count as stored until changed
+    pack(stored);
+    for (int i = 0; i < PROFILE_COUNT; i++) {
+        packProfile(profiles[i], storedProfiles[i]);
+    }
+    loadUs = 0;
+    loadOps = 0;
+    legacyReads = 0;
+    lastWriteUs = 0;
+    writes = 0;
+    saveRequests = 0;
+    unchangedSaves = 0;
+    lastWriteFields = 0;
+    lastWriteProfiles = 0;
+}
+
+void Settings::pack(SettingsBlob& blob) const {
+    memset(&blob, 0, sizeof(blob));
+    blob.levelDisplayMode = (uint8_t)levelDisplayMode;
+    blob.displayBrightness = (uint8_t)displayBrightness;
+    blob.ledBrightness = (uint8_t)ledBrightness;
+    blob.buzzerVolume = (uint8_t)buzzerVolume;
+    blob.timerFineDigits = (uint8_t)timerFineDigits;
+    blob.activeProfile = (uint8_t)getProfileIndex();
+    sealBlob(blob, SETTINGS_BLOB_MAGIC, SETTINGS_BLOB_VERSION);
+}
+
+void Settings::unpack(const SettingsBlob& blob) {
+    levelDisplayMode = (LevelDisplayMode)blob.levelDisplayMode;
+    if (levelDisplayMode < 0 || levelDisplayMode >= LEVEL_DISPLAY_MODE_COUNT) {
+        levelDisplayMode = LEVEL_DISPLAY_DEGREES;
+    }
+
+    displayBrightness = blob.displayBrightness;
+    ledBrightness = blob.ledBrightness;
+    buzzerVolume = blob.buzzerVolume;
+    timerFineDigits = blob.timerFineDigits;
+    profile = &profiles[blob.activeProfile < PROFILE_COUNT ? blob.activeProfile : 0];
+}
+
+void Settings::packProfile(const SettingsProfile& p, ProfileBlob& blob) {
+    memset(&blob, 0, sizeof(blob));
+    strncpy(blob.name, p.name, sizeof(blob.name) - 1);
+
+    blob.gravityX = p.gravity.x;
+    blob.gravityY = p.gravity.y;
+    blob.gravityZ = p.gravity.z;
+    blob.gravityMagnitude = p.gravity.magnitude;
+    blob.isCalibrated = p.gravity.isCalibrated ? 1 : 0;
+
+    blob.tolerance = p.tolerance;
+    blob.parTimeSeconds = (uint16_t)p.parTimeSeconds;
+    blob.yellowWarningSeconds = (uint16_t)p.yellowWarningSeconds;
+    blob.redWarningSeconds = (uint16_t)p.redWarningSeconds;
+    blob.stageShots = (uint8_t)p.stageShots;
+    blob.micThreshold = p.micThreshold;
+    sealBlob(blob, PROFILE_BLOB_MAGIC, PROFILE_BLOB_VERSION);
+}
+
+void Settings::unpackProfile(const ProfileBlob& blob, SettingsProfile& p) {
+    memcpy(p.name, blob.name, sizeof(p.name));
+    p.name[sizeof(p.name) - 1] = '\0';
+
+    p.gravity.x = blob.gravityX;
+    p.gravity.y = blob.gravityY;
+    p.gravity.z = blob.gravityZ;
+    p.gravity.magnitude = blob.gravityMagnitude;
+    p.gravity.isCalibrated = blob.isCalibrated != 0;
+
+    p.tolerance = blob.tolerance;
+    p.parTimeSeconds = blob.parTimeSeconds;
+    p.yellowWarningSeconds = blob.yellowWarningSeconds;
+    p.redWarningSeconds = blob.redWarningSeconds;
+    p.stageShots = blob.stageShots;
+    p.micThreshold = blob.micThreshold;
+}
+
+uint32_t Settings::dirtyFields() const {
+    SettingsBlob current;
+    pack(current);
+
+    const uint8_t* a = (const uint8_t*)&current;
+    const uint8_t* b = (const uint8_t*)&stored;
+    uint32_t mask = 0;
+    for (int i = 0; i < FIELD_COUNT; i++) {
+        if (memcmp(a + FIELDS[i].offset, b + FIELDS[i].offset, FIELDS[i].size) != 0) {
+            mask |= 1UL << i;
+        }
+    }
+    return mask;
+}
+
+uint32_t Settings::dirtyProfiles() const {
+    uint32_t mask = 0;
+    for (int i = 0; i < PROFILE_COUNT; i++) {
+        ProfileBlob current;
+        packProfile(profiles[i], current);
+        if (memcmp(&current, &storedProfiles[i], sizeof(current)) != 0) {
+            mask |= 1UL << i;
+        }
+    }
+    return mask;
+}
+
+bool Settings::selectProfile(int slot) {
+    if (slot < 0 || slot >= PROFILE_COUNT) return false;
+
+    profile = &profiles[slot];
+    save();
+    return true;
 }
 
 void Settings::load() {
-    preferences.begin("stage_timer", false);
-    
-    tolerance = preferences.getFloat("tolerance", 0.5);
-    levelDisplayMode = (LevelDisplayMode)preferences.getInt("disp_mode", LEVEL_DISPLAY_DEGREES);
-    
-    displayBrightness = preferences.getInt("disp_bright", 255);
-    ledBrightness = preferences.getInt("led_bright", 50);
-    
-    parTimeSeconds = preferences.getInt("par_time", 60);
-    yellowWarningSeconds = preferences.getInt("yellow_warn", 30);
-    redWarningSeconds = preferences.getInt("red_warn", 10);
-  
-    buzzerVolume = preferences.getInt("buzzer_vol", 50);
-    micThreshold = preferences.getFloat("mic_thresh", 1500.0);
-    
-    gravity.isCalibrated = preferences.getBool("calibrated", false);
-    if (gravity.isCalibrated) {
-        gravity.x = preferences.getFloat("grav_x", 0);
-        gravity.y = preferences.getFloat("grav_y", 0);
-        gravity.z = preferences.getFloat("grav_z", 0);
-        gravity.magnitude = preferences.getFloat("grav_mag", 1.0);
-        Serial.println("Loaded calibration from flash");
+    uint32_t t0 = micros();
+    preferences.begin(SETTINGS_NAMESPACE, false);
+
+    // Room for either layout; getBytes() reads nothing into a smaller buffer
+    union {
+        SettingsBlob current;
+        SettingsBlobV1 v1;
+    } blob;
+    size_t length = preferences.getBytes(SETTINGS_KEY, &blob, sizeof(blob));
+    loadOps = 1;
+
+    const char* migrateFrom = nullptr;
+    if (length == sizeof(blob.current) &&
+        blobValid(blob.current, SETTINGS_BLOB_MAGIC, SETTINGS_BLOB_VERSION)) {
+        unpack(blob.current);
+        stored = blob.current;
+    } else if (length == sizeof(blob.v1) &&
+               blobValid(blob.v1, SETTINGS_BLOB_MAGIC, SETTINGS_BLOB_V1)) {
+        unpackV1(blob.v1);
+        migrateFrom = "the v1 blob to profiles";
+    } else {
+        if (length > 0) {
+            Serial.println("Settings: stored blob invalid or from another version, using defaults");
+        }
+        // Pre-blob firmware kept one key per value
+        if (loadLegacy()) {
+            migrateFrom = "per-key settings to blobs";
+        }
+    }
+    bool migrate = migrateFrom != nullptr;
+
+    int loaded = 0;
+    for (int i = 0; i < PROFILE_COUNT && !migrate; i++) {
+        char key[16];
+        ProfileBlob p;
+        profileKey(key, sizeof(key), i);
+        length = preferences.getBytes(key, &p, sizeof(p));
+        loadOps++;
+
+        if (length == sizeof(p) && blobValid(p, PROFILE_BLOB_MAGIC, PROFILE_BLOB_VERSION)) {
+            unpackProfile(p, profiles[i]);
+            storedProfiles[i] = p;
+            loaded |= 1 << i;
+        }
+    }
+
+    // Unused slots start as a copy of the first profile (same rifle,
+    // change what differs); they stay unwritten until edited
+    for (int i = 1; i < PROFILE_COUNT; i++) {
+        if (loaded & (1 << i)) continue;
+        char name[PROFILE_NAME_LEN];
+        memcpy(name, profiles[i].name, sizeof(name));
+        profiles[i] = profiles[0];
+        memcpy(profiles[i].name, name, sizeof(name));
+        packProfile(profiles[i], storedProfiles[i]);
+    }
+
+    if (migrate) {
+        preferences.clear();
+        loadOps++;
     }
-    
     preferences.end();
-    
+    loadUs = micros() - t0;
+
+    if (migrate) {
+        // Nothing valid in flash: write the device blob and the first slot
+        memset(&stored, 0, sizeof(stored));
+        memset(&storedProfiles[0], 0, sizeof(storedProfiles[0]));
+        flush();
+        Serial.printf("Settings: migrated %s\n", migrateFrom);
+    }
+
+    if (profile->gravity.isCalibrated) {
+        Serial.println("Loaded calibration from flash");
+    }
     Serial.println("Settings loaded from flash");
+    Serial.printf("Profile %d: %s\n", getProfileIndex() + 1, profile->name);
     Serial.printf("Tolerance: %.2f° (Hysteresis: %.2f° auto)\n", 
-                  tolerance, tolerance * 0.1f);
+                  profile->tolerance, profile->tolerance * 0.1f);
     Serial.printf("Level display mode: %s\n", 
-                  levelDisplayMode == LEVEL_DISPLAY_DEGREES ? "Degrees" : "Arrow");
+                  levelDisplayModeName(levelDisplayMode));
 }
 
-void Settings::save() {
-    preferences.begin("stage_timer", false);
-    
-    preferences.putFloat("tolerance", tolerance);
-    preferences.putInt("disp_mode", (int)levelDisplayMode);
+void Settings::unpackV1(const SettingsBlobV1& blob) {
+    // Device fields carry over, the rest becomes profile 1
+    SettingsBlob device;
+    memset(&device, 0, sizeof(device));
+    device.levelDisplayMode = blob.levelDisplayMode;
+    device.displayBrightness = blob.displayBrightness;
+    device.ledBrightness = blob.ledBrightness;
+    device.buzzerVolume = blob.buzzerVolume;
+    device.timerFineDigits = blob.timerFineDigits;
+    device.activeProfile = 0;
+    unpack(device);
+
+    SettingsProfile& p = profiles[0];
+    p.tolerance = blob.tolerance;
+    p.parTimeSeconds = blob.parTimeSeconds;
+    p.yellowWarningSeconds = blob.yellowWarningSeconds;
+    p.redWarningSeconds = blob.redWarningSeconds;
+    p.stageShots = blob.stageShots;
+    p.micThreshold = blob.micThreshold;
+    p.gravity.x = blob.gravityX;
+    p.gravity.y = blob.gravityY;
+    p.gravity.z = blob.gravityZ;
+    p.gravity.magnitude = blob.gravityMagnitude;
+    p.gravity.isCalibrated = blob.isCalibrated != 0;
+}
+
+// Per-key reads of the migration, each counted as one NVS op
+int Settings::legacyInt(const char* key, int fallback) {
+    loadOps++;
+    return preferences.getInt(key, fallback);
+}
+
+float Settings::legacyFloat(const char* key, float fallback) {
+    loadOps++;
+    return preferences.getFloat(key, fallback);
+}
+
+bool Settings::legacyBool(const char* key, bool fallback) {
+    loadOps++;
+    return preferences.getBool(key, fallback);
+}
+
+bool Settings::loadLegacy() {
+    // Caller has the namespace open; the old values become profile 1
+    loadOps++;
+    if (!preferences.isKey("par_time")) {
+        return false;
+    }
+    uint32_t before = loadOps;
+
+    SettingsProfile& p = profiles[0];
+    profile = &p;
+
+    p.tolerance = legacyFloat("tolerance", 0.5);
+    levelDisplayMode = (LevelDisplayMode)legacyInt("disp_mode", LEVEL_DISPLAY_DEGREES);
+    if (levelDisplayMode < 0 || levelDisplayMode >= LEVEL_DISPLAY_MODE_COUNT) {
+        levelDisplayMode = LEVEL_DISPLAY_DEGREES;
+    }
     
-    preferences.putInt("disp_bright", displayBrightness);
-    preferences.putInt("led_bright", ledBrightness);
+    displayBrightness = legacyInt("disp_bright", 255);
+    ledBrightness = legacyInt("led_bright", 50);
     
-    preferences.putInt("par_time", parTimeSeconds);
-    preferences.putInt("yellow_warn", yellowWarningSeconds);
-    preferences.putInt("red_warn", redWarningSeconds);
+    p.parTimeSeconds = legacyInt("par_time", 60);
+    p.yellowWarningSeconds = legacyInt("yellow_warn", 30);
+    p.redWarningSeconds = legacyInt("red_warn", 10);
+    timerFineDigits = legacyInt("fine_digits", 1);
+    p.stageShots = legacyInt("stage_shots", 0);
+  
+    buzzerVolume = legacyInt("buzzer_vol", 50);
+    p.micThreshold = legacyFloat("mic_thresh", 1500.0);
     
-    preferences.putInt("buzzer_vol", buzzerVolume);
-    preferences.putFloat("mic_thresh", micThreshold);
+    p.gravity.isCalibrated = legacyBool("calibrated", false);
+    if (p.gravity.isCalibrated) {
+        p.gravity.x = legacyFloat("grav_x", 0);
+        p.gravity.y = legacyFloat("grav_y", 0);
+        p.gravity.z = legacyFloat("grav_z", 0);
+        p.gravity.magnitude = legacyFloat("grav_mag", 1.0);
+    }
+    legacyReads = loadOps - before;
+    return true;
+}
+
+void Settings::save() {
+    saveRequests++;
+
+    if (dirtyFields() == 0 && dirtyProfiles() == 0) {
+        // Value confirmed unchanged (or changed back): nothing to write
+        unchangedSaves++;
+        scheduler.cancel(saveJob);
+        return;
+    }
+    scheduler.schedule(saveJob, SAVE_DELAY_MS);
+}
+
+void Settings::flush() {
+    scheduler.cancel(saveJob);
+
+    uint32_t fields = dirtyFields();
+    uint32_t slots = dirtyProfiles();
+    if (fields == 0 && slots == 0) return;
+
+    uint32_t t0 = micros();
+    preferences.begin(SETTINGS_NAMESPACE, false);
+
+    if (fields != 0) {
+        pack(stored);
+        preferences.putBytes(SETTINGS_KEY, &stored, sizeof(stored));
+        writes++;
+    }
+    for (int i = 0; i < PROFILE_COUNT; i++) {
+        if (!(slots & (1UL << i))) continue;
+        char key[16];
+        profileKey(key, sizeof(key), i);
+        packProfile(profiles[i], storedProfiles[i]);
+        preferences.putBytes(key, &storedProfiles[i], sizeof(storedProfiles[i]));
+        writes++;
+    }
 
     preferences.end();
-    
-    Serial.println("Settings saved to flash");
-    Serial.printf("Tolerance: %.2f° (Hysteresis: %.2f° auto)\n", 
-                  tolerance, tolerance * 0.1f);
-    Serial.printf("Level display mode: %s\n", 
-                  levelDisplayMode == LEVEL_DISPLAY_DEGREES ? "Degrees" : "Arrow");
+    lastWriteUs = micros() - t0;
+    lastWriteFields = fields;
+    lastWriteProfiles = slots;
+
+    Serial.printf("Settings saved to flash (%lu us)\n", (unsigned long)lastWriteUs);
 }
 
 void Settings::saveCalibration() {
-    preferences.begin("stage_timer", false);
-    
-    preferences.putBool("calibrated", gravity.isCalibrated);
-    preferences.putFloat("grav_x", gravity.x);
-    preferences.putFloat("grav_y", gravity.y);
-    preferences.putFloat("grav_z", gravity.z);
-    preferences.putFloat("grav_mag", gravity.magnitude);
-    
-    preferences.end();
-    
+    flush();
     Serial.println("Calibration saved to flash");
-}
\ No newline at end of file
+}
+
+void Settings::printReport() {
+    Serial.printf("Settings: %u B device blob + %d x %u B profiles, boot load %lu NVS ops in %lu us\n",
+                  (unsigned)sizeof(SettingsBlob), PROFILE_COUNT, (unsigned)sizeof(ProfileBlob),
+                  (unsigned long)loadOps, (unsigned long)loadUs);
+    if (legacyReads > 0) {
+        Serial.printf("Settings: this boot migrated the per-key layout (%lu key reads)\n",
+                      (unsigned long)legacyReads);
+    }
+    Serial.printf("Settings: %lu save requests, %lu unchanged, %lu blob writes\n",
+                  (unsigned long)saveRequests, (unsigned long)unchangedSaves,
+                  (unsigned long)writes);
+    Serial.printf("Settings: per-key code for comparison (static count): %d puts per save, up to %d gets at boot\n",
+                  LEGACY_SAVE_PUTS, LEGACY_LOAD_GETS);
+
+    if (writes > 0) {
+        Serial.printf("Settings: last flush %lu us:", (unsigned long)lastWriteUs);
+        for (int i = 0; i < FIELD_COUNT; i++) {
+            if (lastWriteFields & (1UL << i)) Serial.printf(" %s", FIELDS[i].name);
+        }
+        for (int i = 0; i < PROFILE_COUNT; i++) {
+            if (lastWriteProfiles & (1UL << i)) Serial.printf(" profile%d", i + 1);
+        }
+        Serial.println();
+    }
+
+    uint32_t dirty = dirtyFields();
+    uint32_t slots = dirtyProfiles();
+    if (dirty == 0 && slots == 0) {
+        Serial.println("Settings: flash is up to date");
+    } else {
+        Serial.print("Settings: pending:");
+        for (int i = 0; i < FIELD_COUNT; i++) {
+            if (dirty & (1UL << i)) Serial.printf(" %s", FIELDS[i].name);
+        }
+        for (int i = 0; i < PROFILE_COUNT; i++) {
+            if (slots & (1UL << i)) Serial.printf(" profile%d", i + 1);
+        }
+        Serial.println();
+    }
+}
@@ -0,0 +1,125 @@
+#include "settings_json.h"
+#include "settings.h"
+#include <ArduinoJson.h>
+
+// Root, device, profile array, then per profile its fields and gravity;
+// slack covers a few unknown keys in an imported document
+static constexpr size_t JSON_CAPACITY =
+    JSON_OBJECT_SIZE(4) + JSON_OBJECT_SIZE(5) + JSON_ARRAY_SIZE(PROFILE_COUNT) +
+    PROFILE_COUNT * (JSON_OBJECT_SIZE(8) + JSON_OBJECT_SIZE(5)) + 128;
+
+// Shared by export and import (both run from loop(), never at once)
+static StaticJsonDocument<JSON_CAPACITY> doc;
+
+void exportSettingsJson(Print& out) {
+    doc.clear();
+    JsonObject root = doc.to<JsonObject>();
+    root["version"] = SETTINGS_JSON_VERSION;
+    root["active_profile"] = settings.getProfileIndex() + 1;
+
+    JsonObject device = root.createNestedObject("device");
+    device["display_mode"] = levelDisplayModeName(settings.levelDisplayMode);
+    device["display_brightness"] = settings.displayBrightness;
+    device["led_brightness"] = settings.ledBrightness;
+    device["buzzer_volume"] = settings.buzzerVolume;
+    device["fine_digits"] = settings.timerFineDigits;
+
+    JsonArray profiles = root.createNestedArray("profiles");
+    for (int i = 0; i < PROFILE_COUNT; i++) {
+        const SettingsProfile& p = settings.getProfile(i);
+        JsonObject po = profiles.createNestedObject();
+        // const char* is stored by reference - no copy in the pool
+        po["name"] = (const char*)p.name;
+        po["tolerance"] = p.tolerance;
+        po["par_time"] = p.parTimeSeconds;
+        po["yellow_warn"] = p.yellowWarningSeconds;
+        po["red_warn"] = p.redWarningSeconds;
+        po["stage_shots"] = p.stageShots;
+        po["mic_threshold"] = p.micThreshold;
+
+        JsonObject g = po.createNestedObject("gravity");
+        g["x"] = p.gravity.x;
+        g["y"] = p.gravity.y;
+        g["z"] = p.gravity.z;
+        g["magnitude"] = p.gravity.magnitude;
+        g["calibrated"] = p.gravity.isCalibrated;
+    }
+
+    serializeJson(doc, out);
+}
+
+static void importProfile(JsonObject po, SettingsProfile& p, bool keepCalibration) {
+    const char* name = po["name"];
+    if (name) {
+        strncpy(p.name, name, PROFILE_NAME_LEN - 1);
+        p.name[PROFILE_NAME_LEN - 1] = '\0';
+    }
+
+    // Same bounds (and order) as the menu
+    p.tolerance = constrain(po["tolerance"] | p.tolerance, 0.1f, 5.0f);
+    p.parTimeSeconds = constrain(po["par_time"] | p.parTimeSeconds, 5, 600);
+    p.yellowWarningSeconds = constrain(po["yellow_warn"] | p.yellowWarningSeconds, YELLOW_WARNING_MIN,
+                                       warningUpperBound(p.parTimeSeconds, YELLOW_WARNING_MIN));
+    p.redWarningSeconds = constrain(po["red_warn"] | p.redWarningSeconds, RED_WARNING_MIN,
+                                    warningUpperBound(p.yellowWarningSeconds, RED_WARNING_MIN));
+    p.stageShots = constrain(po["stage_shots"] | p.stageShots, 0, 99);
+    p.micThreshold = constrain(po["mic_threshold"] | p.micThreshold, 100.0f, 10000.0f);
+
+    JsonObject g = po["gravity"];
+    if (keepCalibration || g.isNull()) return;
+
+    p.gravity.x = g["x"] | p.gravity.x;
+    p.gravity.y = g["y"] | p.gravity.y;
+    p.gravity.z = g["z"] | p.gravity.z;
+    p.gravity.magnitude = g["magnitude"] | p.gravity.magnitude;
+    p.gravity.isCalibrated = g["calibrated"] | p.gravity.isCalibrated;
+}
+
+bool importSettingsJson(char* json, size_t length, bool keepCalibration) {
+    doc.clear();
+    DeserializationError error = deserializeJson(doc, json, length);
+    if (error) {
+        Serial.printf("Import: %s, nothing changed\n", error.c_str());
+        return false;
+    }
+
+    JsonObject root = doc.as<JsonObject>();
+    int version = root["version"] | 0;
+    if (version != SETTINGS_JSON_VERSION) {
+        Serial.printf("Import: version %d, expected %d, nothing changed\n",
+                      version, SETTINGS_JSON_VERSION);
+        return false;
+    }
+
+    JsonObject device = root["device"];
+    if (!device.isNull()) {
+        const char* mode = device["display_mode"];
+        for (int i = 0; mode && i < LEVEL_DISPLAY_MODE_COUNT; i++) {
+            if (strcmp(mode, levelDisplayModeName((LevelDisplayMode)i)) == 0) {
+                settings.levelDisplayMode = (LevelDisplayMode)i;
+            }
+        }
+        settings.displayBrightness = constrain(device["display_brightness"] | settings.displayBrightness, 10, 255);
+        settings.ledBrightness = constrain(device["led_brightness"] | settings.ledBrightness, 5, 255);
+        settings.buzzerVolume = constrain(device["buzzer_volume"] | settings.buzzerVolume, 0, 100);
+        settings.timerFineDigits = constrain(device["fine_digits"] | settings.timerFineDigits, 0, 2);
+    }
+
+    JsonArray profiles = root["profiles"];
+    int count = 0;
+    for (JsonObject po : profiles) {
+        if (count >= PROFILE_COUNT) break;
+        importProfile(po, settings.getProfile(count), keepCalibration);
+        count++;
+    }
+
+    int active = root["active_profile"] | 0;
+    if (active >= 1 && active <= PROFILE_COUNT) {
+        settings.selectProfile(active - 1);
+    }
+
+    Serial.printf("Import: %d profile(s)%s, %lu of %lu document bytes used\n",
+                  count, keepCalibration ? ", calibration kept" : "",
+                  (unsigned long)doc.memoryUsage(), (unsigned long)doc.capacity());
+    return true;
+}
@@ -0,0 +1,123 @@
+#include "shot_log.h"
+
+ShotLog shotLog;
+
+static void putU16(uint8_t* out, uint16_t v) {
+    out[0] = v & 0xFF;
+    out[1] = v >> 8;
+}
+
+static void putU32(uint8_t* out, uint32_t v) {
+    putU16(out, v & 0xFFFF);
+    putU16(out + 2, v >> 16);
+}
+
+ShotLog::ShotLog() {
+    head = 0;
+    stored = 0;
+    open = false;
+    stage = 0;
+    shots = 0;
+    expected = 0;
+    firstShotUs = 0;
+    fastestSplitUs = 0;
+    lastShotUs = 0;
+    summaryHead = 0;
+    summaryCount = 0;
+}
+
+void ShotLog::beginStage(uint16_t expectedShots) {
+    if (open) {
+        endStage();
+    }
+
+    open = true;
+    stage++;
+    expected = expectedShots;
+    head = 0;
+    stored = 0;
+    shots = 0;
+    firstShotUs = 0;
+    fastestSplitUs = 0;
+    lastShotUs = 0;
+}
+
+void ShotLog::endStage() {
+    if (!open) return;
+    open = false;
+
+    StageSummary& s = summaries[summaryHead];
+    s.stage = stage;
+    s.shots = shots;
+    s.expected = expected;
+    s.firstShotUs = firstShotUs;
+    s.fastestSplitUs = fastestSplitUs;
+    s.averageSplitUs = getAverageSplitUs();
+    s.lastShotUs = lastShotUs;
+
+    summaryHead = (summaryHead + 1) % MAX_SUMMARIES;
+    if (summaryCount < MAX_SUMMARIES) {
+        summaryCount++;
+    }
+}
+
+bool ShotLog::record(uint32_t atUs, ShotSource source) {
+    if (!open) return false;
+
+    if (shots > 0) {
+        // Same shot seen by the other sensor (or an echo)
+        if (atUs < lastShotUs + MERGE_US) return false;
+
+        uint32_t split = atUs - lastShotUs;
+        if (fastestSplitUs == 0 || split < fastestSplitUs) {
+            fastestSplitUs = split;
+        }
+    } else {
+        firstShotUs = atUs;
+    }
+
+    lastShotUs = atUs;
+    if (shots < UINT16_MAX) {
+        shots++;
+    }
+
+    ring[head].atUs = atUs;
+    ring[head].source = source;
+    head = (head + 1) % MAX_SHOTS;
+    if (stored < MAX_SHOTS) {
+        stored++;
+    }
+    return true;
+}
+
+uint32_t ShotLog::getAverageSplitUs() const {
+    // Splits sum to last - first, so no running sum is needed
+    if (shots < 2) return 0;
+    return (lastShotUs - firstShotUs) / (shots - 1);
+}
+
+const ShotRecord& ShotLog::get(int index) const {
+    int oldest = (head - stored + MAX_SHOTS) % MAX_SHOTS;
+    return ring[(oldest + index) % MAX_SHOTS];
+}
+
+const StageSummary& ShotLog::getSummary(int index) const {
+    return summaries[(summaryHead - 1 - index + 2 * MAX_SUMMARIES) % MAX_SUMMARIES];
+}
+
+int ShotLog::writeBinaryHeader(uint8_t* out) const {
+    out[0] = 'S';
+    out[1] = 'P';
+    out[2] = 'L';
+    out[3] = BINARY_VERSION;
+    putU16(out + 4, stage);
+    putU16(out + 6, expected);
+    putU16(out + 8, shots);
+    putU16(out + 10, stored);
+    return BINARY_HEADER_BYTES;
+}
+
+void ShotLog::packRecord(const ShotRecord& r, uint8_t* out) {
+    putU32(out, r.atUs);
+    out[4] = r.source;
+}
@@ -0,0 +1,187 @@
+#include "spectrogram_view.h"
+#include "mic_detector.h"
+#include <cmath>
+
+SpectrogramView spectrogram;
+
+// ST7789 vertical scrolling
+#define ST7789_VSCRDEF  0x33  // Vertical scrolling definition (TFA, VSA, BFA)
+#define ST7789_VSCSAD   0x37  // Vertical scroll start address
+
+// Colour scale in log2 steps relative to the detection threshold
+#define SCALE_MIN_LOG2  -6.0f   // 1/64 of threshold -> black
+#define SCALE_MAX_LOG2   2.0f   // 4x threshold -> red
+
+SpectrogramView::SpectrogramView() {
+    tft = nullptr;
+    active = false;
+    scrollLine = 0;
+    lastBlock = 0;
+    lastFooterUpdate = 0;
+}
+
+void SpectrogramView::begin(LGFX* tftPtr) {
+    tft = tftPtr;
+    buildPalette();
+}
+
+void SpectrogramView::buildPalette() {
+    // black -> blue -> cyan -> yellow (threshold) -> red
+    struct Stop { int index; uint8_t r, g, b; };
+    const Stop stops[] = {
+        {0,   0,   0,   0},
+        {16,  0,   0,   160},
+        {32,  0,   200, 200},
+        {47,  255, 220, 0},
+        {63,  255, 0,   0},
+    };
+    const int stopCount = sizeof(stops) / sizeof(stops[0]);
+
+    for (int s = 0; s < stopCount - 1; s++) {
+        const Stop& a = stops[s];
+        const Stop& b = stops[s + 1];
+        for (int i = a.index; i <= b.index; i++) {
+            int t = (i - a.index) * 256 / (b.index - a.index);
+            uint8_t r = a.r + ((b.r - a.r) * t >> 8);
+            uint8_t g = a.g + ((b.g - a.g) * t >> 8);
+            uint8_t bl = a.b + ((b.b - a.b) * t >> 8);
+            uint16_t c = ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (bl >> 3);
+            palette[i] = (c >> 8) | (c << 8);  // panel byte order
+        }
+    }
+}
+
+void SpectrogramView::setScrollArea(uint16_t top, uint16_t height, uint16_t bottom) {
+    tft->startWrite();
+    tft->writeCommand(ST7789_VSCRDEF);
+    tft->writeData(top >> 8);
+    tft->writeData(top & 0xFF);
+    tft->writeData(height >> 8);
+    tft->writeData(height & 0xFF);
+    tft->writeData(bottom >> 8);
+    tft->writeData(bottom & 0xFF);
+    tft->endWrite();
+}
+
+void SpectrogramView::setScrollStart(uint16_t line) {
+    tft->startWrite();
+    tft->writeCommand(ST7789_VSCSAD);
+    tft->writeData(line >> 8);
+    tft->writeData(line & 0xFF);
+    tft->endWrite();
+}
+
+void SpectrogramView::start() {
+    if (!tft) return;
+
+    // Queued main-screen tiles must not land on the diagnostic screen
+    display.invalidate();
+
+    tft->fillScreen(TFT_BLACK);
+    drawHeader();
+    drawFooter();
+
+    setScrollArea(HEADER_ROWS, SCROLL_ROWS, FOOTER_ROWS);
+    scrollLine = 0;
+    setScrollStart(HEADER_ROWS);
+
+    lastBlock = micDetector.getBlockCount();
+    lastFooterUpdate = millis();
+    active = true;
+}
+
+void SpectrogramView::stop() {
+    if (!active) return;
+    active = false;
+
+    // Whole panel back to a 1:1 mapping
+    setScrollArea(0, 320, 0);
+    setScrollStart(0);
+}
+
+void SpectrogramView::drawHeader() {
+    tft->setTextSize(2);
+    tft->setTextColor(COLOR_CYAN);
+    tft->setCursor(10, 4);
+    tft->println("MIC SPECTRUM");
+
+    // Frequency axis: first, middle and last bin
+    int bins = micDetector.getBinCount();
+    if (bins == 0) return;
+    int bandWidth = 170 / bins;
+    int marks[] = {0, bins / 2, bins - 1};
+
+    tft->setTextSize(1);
+    tft->setTextColor(TFT_LIGHTGREY);
+    for (int bin : marks) {
+        int hz = (int)micDetector.getBinFrequency(bin);
+        int x = constrain(bin * bandWidth + bandWidth / 2 - 12, 0, 170 - 24);
+        tft->setCursor(x, 28);
+        tft->printf("%d.%dk", hz / 1000, (hz % 1000) / 100);
+    }
+}
+
+void SpectrogramView::drawFooter() {
+    MicStats stats = micDetector.getStats();
+    int y = HEADER_ROWS + SCROLL_ROWS;
+
+    tft->fillRect(0, y, 170, FOOTER_ROWS, TFT_BLACK);
+    tft->setTextSize(1);
+
+    tft->setTextColor(TFT_WHITE);
+    tft->setCursor(4, y + 4);
+    tft->printf("Pk %.0fHz %.0f SNR %.1fx", stats.detectedFrequency, stats.currentMagnitude, stats.snr);
+
+    tft->setTextColor(COLOR_YELLOW);
+    tft->setCursor(4, y + 16);
+    tft->printf("Thr %.0f  Noise %.0f", stats.threshold, stats.noiseFloor);
+
+    tft->setTextColor(TFT_DARKGREY);
+    tft->setCursor(4, y + 28);
+    tft->print("Enc: thr  BOOT 2s: exit");
+}
+
+void SpectrogramView::pushRow() {
+    int bins = micDetector.getBinCount();
+    const float* mags = micDetector.getBinMagnitudes();
+    float threshold = micDetector.getThreshold();
+    int bandWidth = bins > 0 ? 170 / bins : 170;
+
+    int x = 0;
+    for (int bin = 0; bin < bins; bin++) {
+        float level = (mags[bin] > 0 && threshold > 0) ? log2f(mags[bin] / threshold) : SCALE_MIN_LOG2;
+        int index = (int)((level - SCALE_MIN_LOG2) * (PALETTE_SIZE - 1) / (SCALE_MAX_LOG2 - SCALE_MIN_LOG2));
+        uint16_t color = palette[constrain(index, 0, PALETTE_SIZE - 1)];
+
+        // Last pixel of each band stays black as a bin separator
+        for (int i = 0; i < bandWidth - 1; i++) {
+            row[x++] = color;
+        }
+        row[x++] = 0;
+    }
+    while (x < 170) {
+        row[x++] = 0;
+    }
+
+    // Write the row into the oldest line, then scroll it to the bottom
+    tft->pushImage(0, HEADER_ROWS + scrollLine, 170, 1, (const lgfx::swap565_t*)row);
+    scrollLine = (scrollLine + 1) % SCROLL_ROWS;
+    setScrollStart(HEADER_ROWS + scrollLine);
+}
+
+void SpectrogramView::update() {
+    if (!active) return;
+
+    // One row per processed audio block
+    uint32_t block = micDetector.getBlockCount();
+    if (block != lastBlock) {
+        lastBlock = block;
+        pushRow();
+    }
+
+    // Footer text is the only full redraw, 4x per second in a fixed area
+    if (millis() - lastFooterUpdate > 250) {
+        lastFooterUpdate = millis();
+        drawFooter();
+    }
+}
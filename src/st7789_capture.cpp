@@ -0,0 +1,231 @@
+#include "st7789_capture.h"
+#include <string.h>
+
+// ST7789 commands the model understands; everything else is counted only
+#define CMD_SLPIN    0x10
+#define CMD_SLPOUT   0x11
+#define CMD_PTLON    0x12
+#define CMD_NORON    0x13
+#define CMD_DISPOFF  0x28
+#define CMD_DISPON   0x29
+#define CMD_CASET    0x2A
+#define CMD_RASET    0x2B
+#define CMD_RAMWR    0x2C
+#define CMD_PTLAR    0x30
+#define CMD_VSCRDEF  0x33
+#define CMD_VSCSAD   0x37
+#define CMD_IDMOFF   0x38
+#define CMD_IDMON    0x39
+#define CMD_RAMWRC   0x3C
+
+St7789Capture::St7789Capture(int viewX, int viewW)
+    : ram(new uint16_t[RAM_W * RAM_H])
+    , viewX(viewX)
+    , viewW(viewW)
+{
+    reset();
+}
+
+St7789Capture::~St7789Capture() {
+    delete[] ram;
+}
+
+void St7789Capture::reset() {
+    memset(ram, 0, RAM_W * RAM_H * sizeof(uint16_t));
+
+    currentCommand = 0;
+    paramCount = 0;
+    colStart = 0;
+    colEnd = RAM_W - 1;
+    rowStart = 0;
+    rowEnd = RAM_H - 1;
+    curCol = 0;
+    curRow = 0;
+    pixelWrite = false;
+    haveHighByte = false;
+    highByte = 0;
+
+    topFixed = 0;
+    scrollArea = RAM_H;
+    bottomFixed = 0;
+    scrollStart = 0;
+
+    partialStart = 0;
+    partialEnd = RAM_H - 1;
+    partialMode = false;
+    idleMode = false;
+
+    sleeping = false;
+    displayOn = true;
+
+    resetStats();
+}
+
+void St7789Capture::resetStats() {
+    memset(&stats, 0, sizeof(stats));
+}
+
+void St7789Capture::command(uint8_t cmd) {
+    stats.commands++;
+
+    currentCommand = cmd;
+    paramCount = 0;
+    pixelWrite = false;
+    haveHighByte = false;
+
+    switch (cmd) {
+        case CMD_SLPIN:   sleeping = true;   break;
+        case CMD_SLPOUT:  sleeping = false;  break;
+        case CMD_DISPOFF: displayOn = false; break;
+        case CMD_DISPON:  displayOn = true;  break;
+        case CMD_PTLON:   partialMode = true;  break;
+        case CMD_NORON:   partialMode = false; break;
+        case CMD_IDMOFF:  idleMode = false;  break;
+        case CMD_IDMON:   idleMode = true;   break;
+
+        case CMD_RAMWR:
+            // Write pointer back to the window origin
+            curCol = colStart;
+            curRow = rowStart;
+            pixelWrite = true;
+            stats.windows++;
+            break;
+
+        case CMD_RAMWRC:
+            // Continue where the last write stopped
+            pixelWrite = true;
+            break;
+
+        default:
+            break;
+    }
+}
+
+void St7789Capture::data(const uint8_t* bytes, uint32_t length) {
+    for (uint32_t i = 0; i < length; i++) {
+        if (pixelWrite) {
+            pixelByte(bytes[i]);
+        } else {
+            parameter(bytes[i]);
+        }
+    }
+}
+
+void St7789Capture::dataRepeat(const uint8_t* pattern, uint8_t patternBytes, uint32_t count) {
+    for (uint32_t n = 0; n < count; n++) {
+        data(pattern, patternBytes);
+    }
+}
+
+void St7789Capture::parameter(uint8_t value) {
+    stats.paramBytes++;
+    if (paramCount < (int)sizeof(params)) {
+        params[paramCount] = value;
+    }
+    paramCount++;
+
+    switch (currentCommand) {
+        case CMD_CASET:
+            if (paramCount == 4) {
+                colStart = (params[0] << 8) | params[1];
+                colEnd = (params[2] << 8) | params[3];
+            }
+            break;
+
+        case CMD_RASET:
+            if (paramCount == 4) {
+                rowStart = (params[0] << 8) | params[1];
+                rowEnd = (params[2] << 8) | params[3];
+            }
+            break;
+
+        case CMD_PTLAR:
+            if (paramCount == 4) {
+                partialStart = (params[0] << 8) | params[1];
+                partialEnd = (params[2] << 8) | params[3];
+            }
+            break;
+
+        case CMD_VSCRDEF:
+            if (paramCount == 6) {
+                topFixed = (params[0] << 8) | params[1];
+                scrollArea = (params[2] << 8) | params[3];
+                bottomFixed = (params[4] << 8) | params[5];
+            }
+            break;
+
+        case CMD_VSCSAD:
+            if (paramCount == 2) {
+                scrollStart = (params[0] << 8) | params[1];
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+void St7789Capture::pixelByte(uint8_t value) {
+    stats.pixelBytes++;
+
+    // RGB565 goes out high byte first
+    if (!haveHighByte) {
+        highByte = value;
+        haveHighByte = true;
+        return;
+    }
+    haveHighByte = false;
+
+    if (curCol < RAM_W && curRow < RAM_H) {
+        ram[curRow * RAM_W + curCol] = (highByte << 8) | value;
+    }
+    stats.pixels++;
+
+    // Advance through the window, wrapping to its origin like the controller
+    if (++curCol > colEnd) {
+        curCol = colStart;
+        if (++curRow > rowEnd) {
+            curRow = rowStart;
+        }
+    }
+}
+
+int St7789Capture::ramRowForView(int y) const {
+    // Rows in the fixed areas map 1:1; the scroll area starts at scrollStart
+    if (scrollArea == 0 || y < topFixed || y >= topFixed + scrollArea) {
+        return y;
+    }
+    int offset = (scrollStart - topFixed + (y - topFixed)) % scrollArea;
+    if (offset < 0) offset += scrollArea;
+    return topFixed + offset;
+}
+
+uint16_t St7789Capture::viewPixel(int x, int y) const {
+    if (sleeping || !displayOn) return 0;
+    if (x < 0 || x >= viewW || y < 0 || y >= RAM_H) return 0;
+
+    // Partial mode: lines outside the partial area are not driven (black)
+    if (partialMode && (y < partialStart || y > partialEnd)) return 0;
+
+    uint16_t p = ram[ramRowForView(y) * RAM_W + viewX + x];
+
+    // Idle mode: 8 colours, only the MSB of each channel reaches the glass
+    if (idleMode) {
+        p = ((p & 0x8000) ? 0xF800 : 0) | ((p & 0x0400) ? 0x07E0 : 0) | ((p & 0x0010) ? 0x001F : 0);
+    }
+    return p;
+}
+
+uint32_t St7789Capture::viewHash(int x, int y, int w, int h) const {
+    uint32_t hash = 2166136261u;
+    for (int row = y; row < y + h; row++) {
+        for (int col = x; col < x + w; col++) {
+            uint16_t p = viewPixel(col, row);
+            hash ^= p & 0xFF;
+            hash *= 16777619u;
+            hash ^= p >> 8;
+            hash *= 16777619u;
+        }
+    }
+    return hash;
+}
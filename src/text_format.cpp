@@ -0,0 +1,81 @@
+#include "text_format.h"
+
+// Writes a non-negative integer, returns characters written
+static int writeUnsigned(char* out, unsigned int value) {
+    char tmp[10];
+    int n = 0;
+    do {
+        tmp[n++] = '0' + (value % 10);
+        value /= 10;
+    } while (value > 0);
+
+    for (int i = 0; i < n; i++) {
+        out[i] = tmp[n - 1 - i];
+    }
+    return n;
+}
+
+int formatInt(char* out, int value) {
+    int len = 0;
+    if (value < 0) {
+        out[len++] = '-';
+        value = -value;
+    }
+    len += writeUnsigned(out + len, value);
+    out[len] = '\0';
+    return len;
+}
+
+int formatTime(char* out, int totalSeconds) {
+    if (totalSeconds < 0) totalSeconds = 0;
+
+    int minutes = totalSeconds / 60;
+    int seconds = totalSeconds % 60;
+
+    int len = writeUnsigned(out, minutes);
+    out[len++] = ':';
+    out[len++] = '0' + seconds / 10;
+    out[len++] = '0' + seconds % 10;
+    out[len] = '\0';
+    return len;
+}
+
+int formatFineTime(char* out, uint32_t remainingMs, int digits) {
+    int len = writeUnsigned(out, remainingMs / 1000);
+    unsigned int fraction = remainingMs % 1000;
+
+    out[len++] = '.';
+    out[len++] = '0' + fraction / 100;
+    if (digits >= 2) {
+        out[len++] = '0' + (fraction / 10) % 10;
+    }
+    out[len] = '\0';
+    return len;
+}
+
+int formatAngle(char* out, float angle) {
+    int len = 0;
+
+    // Work in tenths so rounding matches the displayed precision
+    float scaled = angle * 10.0f;
+    int tenths = (int)(scaled < 0 ? scaled - 0.5f : scaled + 0.5f);
+
+    bool negative = tenths < 0;
+    unsigned int magnitude = negative ? -tenths : tenths;
+
+    if (magnitude < 100) {
+        // Below 10 degrees: show tenths
+        if (negative) out[len++] = '-';
+        len += writeUnsigned(out + len, magnitude / 10);
+        out[len++] = '.';
+        out[len++] = '0' + magnitude % 10;
+    } else {
+        // Whole degrees, rounded
+        unsigned int whole = (magnitude + 5) / 10;
+        if (negative) out[len++] = '-';
+        len += writeUnsigned(out + len, whole);
+    }
+
+    out[len] = '\0';
+    return len;
+}
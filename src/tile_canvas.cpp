@@ -0,0 +1,418 @@
+#include "tile_canvas.h"
+#include <esp_heap_caps.h>
+
+TileCanvas::TileCanvas(int x, int y, int width, int height)
+    : tft(nullptr)
+    , depth(16)
+    , paletteColors(nullptr)
+    , paletteSwapped(nullptr)
+    , paletteCount(0)
+    , originX(x)
+    , originY(y)
+    , regionWidth(width)
+    , regionHeight(height)
+    , tilesX((width + TILE_W - 1) / TILE_W)
+    , tilesY((height + TILE_H - 1) / TILE_H)
+    , tileHashes(nullptr)
+    , forceFull(true)
+    , damageCount(0)
+    , spanStart(nullptr)
+    , spanEnd(nullptr)
+    , asyncMode(false)
+    , tileDirty(nullptr)
+    , pendingTiles(0)
+    , cursorRow(0)
+    , nextStaging(0)
+{
+    for (int i = 0; i < 2; i++) {
+        staging[i].pixels = nullptr;
+        staging[i].state = STAGING_FREE;
+    }
+}
+
+bool TileCanvas::begin(lgfx::LGFX_Device* tftPtr, int bpp) {
+    tft = tftPtr;
+
+    if (!allocateSprite(bpp)) {
+        Serial.printf("ERROR: TileCanvas %dx%d allocation failed\n", regionWidth, regionHeight);
+        return false;
+    }
+
+    tileHashes = new uint32_t[tilesX * tilesY];
+    tileDirty = new bool[tilesX * tilesY]();
+    spanStart = new uint8_t[tilesX * tilesY];
+    spanEnd = new uint8_t[tilesX * tilesY];
+    forceFull = true;
+    return true;
+}
+
+bool TileCanvas::allocateSprite(int bpp) {
+    sprite.deleteSprite();
+
+    switch (bpp) {
+        case 8:  sprite.setColorDepth(lgfx::palette_8bit); break;
+        case 4:  sprite.setColorDepth(lgfx::palette_4bit); break;
+        default: sprite.setColorDepth(16); bpp = 16;       break;
+    }
+    if (sprite.createSprite(regionWidth, regionHeight) == nullptr) {
+        return false;
+    }
+    depth = bpp;
+
+    if (depth < 16 && !paletteColors) {
+        paletteColors = new uint16_t[MAX_PALETTE];
+        paletteSwapped = new uint16_t[MAX_PALETTE];
+    }
+    resetPalette();
+
+    // Index 0 is black, so this clears either way
+    sprite.fillScreen(0);
+    forceFull = true;
+    return true;
+}
+
+bool TileCanvas::setColorDepth(int bpp) {
+    if (bpp == depth) return true;
+
+    int oldDepth = depth;
+    discardPending();
+    if (!allocateSprite(bpp)) {
+        allocateSprite(oldDepth);
+        return false;
+    }
+    return true;
+}
+
+void TileCanvas::resetPalette() {
+    paletteCount = 0;
+    if (depth < 16) {
+        paletteColors[0] = TFT_BLACK;
+        paletteSwapped[0] = 0;
+        paletteCount = 1;
+    }
+}
+
+uint16_t TileCanvas::color(uint16_t rgb565) {
+    if (depth == 16) return rgb565;
+
+    for (int i = 0; i < paletteCount; i++) {
+        if (paletteColors[i] == rgb565) return i;
+    }
+
+    int capacity = 1 << depth;
+    if (paletteCount < capacity) {
+        paletteColors[paletteCount] = rgb565;
+        paletteSwapped[paletteCount] = (rgb565 >> 8) | (rgb565 << 8);
+        return paletteCount++;
+    }
+
+    // Palette full - closest entry by squared RGB565 component distance
+    int best = 0;
+    int bestDist = INT32_MAX;
+    for (int i = 0; i < paletteCount; i++) {
+        int dr = ((paletteColors[i] >> 11) & 0x1F) - ((rgb565 >> 11) & 0x1F);
+        int dg = ((paletteColors[i] >> 5) & 0x3F) - ((rgb565 >> 5) & 0x3F);
+        int db = (paletteColors[i] & 0x1F) - (rgb565 & 0x1F);
+        int dist = 4 * dr * dr + dg * dg + 4 * db * db;
+        if (dist < bestDist) {
+            bestDist = dist;
+            best = i;
+        }
+    }
+    return best;
+}
+
+void TileCanvas::copyRow(uint16_t* dst, int x, int y, int w) const {
+    const uint8_t* row = (const uint8_t*)sprite.getBuffer() + y * rowBytes();
+
+    if (depth == 16) {
+        // Sprite memory is already in panel byte order
+        memcpy(dst, (const uint16_t*)row + x, w * sizeof(uint16_t));
+    } else if (depth == 8) {
+        for (int i = 0; i < w; i++) {
+            dst[i] = paletteSwapped[row[x + i]];
+        }
+    } else {
+        // Two pixels per byte, left pixel in the high nibble
+        for (int i = 0; i < w; i++) {
+            int px = x + i;
+            uint8_t b = row[px >> 1];
+            dst[i] = paletteSwapped[(px & 1) ? (b & 0x0F) : (b >> 4)];
+        }
+    }
+}
+
+uint32_t TileCanvas::hashTile(int tx, int ty, int w, int h) const {
+    // FNV-1a over the raw pixels - a 32-bit hash per tile instead of a
+    // second copy of the frame keeps the diff cheap in RAM
+    const uint8_t* buf = (const uint8_t*)sprite.getBuffer();
+    int stride = rowBytes();
+    uint32_t hash = 2166136261u;
+
+    for (int row = 0; row < h; row++) {
+        const uint8_t* line = buf + (ty + row) * stride;
+        if (depth == 16) {
+            const uint16_t* p = (const uint16_t*)line + tx;
+            for (int col = 0; col < w; col++) {
+                hash ^= p[col];
+                hash *= 16777619u;
+            }
+        } else if (depth == 8) {
+            for (int col = 0; col < w; col++) {
+                hash ^= line[tx + col];
+                hash *= 16777619u;
+            }
+        } else {
+            for (int col = 0; col < w; col++) {
+                int px = tx + col;
+                hash ^= (px & 1) ? (line[px >> 1] & 0x0F) : (line[px >> 1] >> 4);
+                hash *= 16777619u;
+            }
+        }
+    }
+    return hash;
+}
+
+void TileCanvas::addDamage(int x, int y, int w, int h) {
+    // Clip to the region
+    if (x < 0) { w += x; x = 0; }
+    if (y < 0) { h += y; y = 0; }
+    if (x + w > regionWidth) w = regionWidth - x;
+    if (y + h > regionHeight) h = regionHeight - y;
+    if (w <= 0 || h <= 0) return;
+
+    if (damageCount < MAX_DAMAGE) {
+        damage[damageCount++] = {x, y, w, h};
+        return;
+    }
+
+    // Out of slots: collapse everything into one bounding box
+    int x0 = x, y0 = y, x1 = x + w, y1 = y + h;
+    for (int i = 0; i < damageCount; i++) {
+        x0 = min(x0, damage[i].x);
+        y0 = min(y0, damage[i].y);
+        x1 = max(x1, damage[i].x + damage[i].w);
+        y1 = max(y1, damage[i].y + damage[i].h);
+    }
+    damage[0] = {x0, y0, x1 - x0, y1 - y0};
+    damageCount = 1;
+}
+
+bool TileCanvas::damagedSpan(int tx, int ty, int w, int h, int& x0, int& x1) const {
+    bool found = false;
+    x0 = w;
+    x1 = 0;
+
+    for (int i = 0; i < damageCount; i++) {
+        const Rect& d = damage[i];
+        if (d.x >= tx + w || d.x + d.w <= tx || d.y >= ty + h || d.y + d.h <= ty) continue;
+
+        x0 = min(x0, max(d.x, tx) - tx);
+        x1 = max(x1, min(d.x + d.w, tx + w) - tx);
+        found = true;
+    }
+    return found;
+}
+
+void TileCanvas::pushTile(int tx, int ty, int w, int h) {
+    for (int row = 0; row < h; row++) {
+        copyRow(&tileBuffer[row * w], tx, ty + row, w);
+    }
+
+    // Staged rows are in panel byte order
+    tft->pushImage(originX + tx, originY + ty, w, h, (const lgfx::swap565_t*)tileBuffer);
+}
+
+uint32_t TileCanvas::present() {
+    if (!tft || !tileHashes) return 0;
+
+    uint32_t bytes = 0;
+
+    // Nothing drawn since the last frame - skip the hashing entirely
+    if (!forceFull && damageCount == 0) {
+        if (asyncMode) service();
+        return 0;
+    }
+
+    if (!asyncMode) {
+        tft->startWrite();
+    }
+
+    for (int ty = 0; ty < tilesY; ty++) {
+        int y = ty * TILE_H;
+        int h = min(TILE_H, regionHeight - y);
+
+        for (int tx = 0; tx < tilesX; tx++) {
+            int x = tx * TILE_W;
+            int w = min(TILE_W, regionWidth - x);
+
+            // Columns to push within the tile; tiles outside every damage
+            // rect are unchanged and not even hashed
+            int x0 = 0;
+            int x1 = w;
+            if (!forceFull && !damagedSpan(x, y, w, h, x0, x1)) continue;
+
+            int index = ty * tilesX + tx;
+            uint32_t hash = hashTile(x, y, w, h);
+
+            if (!forceFull && hash == tileHashes[index]) continue;
+            tileHashes[index] = hash;
+
+            if (asyncMode) {
+                // Already queued tiles go out with their latest content
+                if (tileDirty[index]) {
+                    spanStart[index] = min((int)spanStart[index], x0);
+                    spanEnd[index] = max((int)spanEnd[index], x1);
+                    continue;
+                }
+                tileDirty[index] = true;
+                spanStart[index] = x0;
+                spanEnd[index] = x1;
+                pendingTiles++;
+            } else {
+                pushTile(x + x0, y, x1 - x0, h);
+            }
+            bytes += (x1 - x0) * h * 2 + ADDR_WINDOW_BYTES;
+        }
+    }
+
+    if (asyncMode) {
+        service();
+    } else {
+        tft->endWrite();
+    }
+
+    forceFull = false;
+    damageCount = 0;
+    return bytes;
+}
+
+bool TileCanvas::setAsync(bool enable) {
+    if (enable == asyncMode) return true;
+
+    if (enable) {
+        // One strip = a full row of tiles, so any run of dirty tiles fits
+        size_t stripBytes = regionWidth * TILE_H * sizeof(uint16_t);
+        for (int i = 0; i < 2; i++) {
+            if (!staging[i].pixels) {
+                staging[i].pixels = (uint16_t*)heap_caps_malloc(stripBytes, MALLOC_CAP_DMA);
+            }
+            if (!staging[i].pixels) {
+                Serial.println("ERROR: TileCanvas DMA staging allocation failed");
+                return false;
+            }
+            staging[i].state = STAGING_FREE;
+        }
+        asyncMode = true;
+    } else {
+        discardPending();
+        asyncMode = false;
+    }
+
+    forceFull = true;
+    return true;
+}
+
+void TileCanvas::discardPending() {
+    if (!tileDirty) return;
+
+    if (asyncMode) {
+        // Fence: nothing may draw over the region while DMA still owns a strip
+        tft->waitDMA();
+    }
+
+    for (int i = 0; i < tilesX * tilesY; i++) {
+        tileDirty[i] = false;
+    }
+    pendingTiles = 0;
+    cursorRow = 0;
+    staging[0].state = STAGING_FREE;
+    staging[1].state = STAGING_FREE;
+
+    // Hashes describe tiles that never reached the panel
+    forceFull = true;
+}
+
+void TileCanvas::retireStaging() {
+    // Only called with the DMA idle: every in-flight strip has completed
+    for (int i = 0; i < 2; i++) {
+        if (staging[i].state == STAGING_IN_FLIGHT) {
+            staging[i].state = STAGING_FREE;
+        }
+    }
+}
+
+bool TileCanvas::prepareNextRun(Staging& s) {
+    if (pendingTiles == 0) {
+        cursorRow = 0;
+        return false;
+    }
+
+    // Scan from the cursor, wrapping once (tiles may be re-marked above it)
+    for (int scanned = 0; scanned < tilesY; scanned++) {
+        bool* row = &tileDirty[cursorRow * tilesX];
+
+        int first = 0;
+        while (first < tilesX && !row[first]) first++;
+
+        if (first < tilesX) {
+            int last = first;
+            while (last + 1 < tilesX && row[last + 1]) last++;
+
+            // Damaged columns of the first tile through those of the last
+            int base = cursorRow * tilesX;
+            s.x = first * TILE_W + spanStart[base + first];
+            s.y = cursorRow * TILE_H;
+            s.w = last * TILE_W + spanEnd[base + last] - s.x;
+            s.h = min(TILE_H, regionHeight - s.y);
+
+            for (int r = 0; r < s.h; r++) {
+                copyRow(&s.pixels[r * s.w], s.x, s.y + r, s.w);
+            }
+
+            for (int i = first; i <= last; i++) {
+                row[i] = false;
+            }
+            pendingTiles -= (last - first + 1);
+            s.state = STAGING_READY;
+            return true;
+        }
+
+        cursorRow = (cursorRow + 1) % tilesY;
+    }
+
+    pendingTiles = 0;
+    return false;
+}
+
+bool TileCanvas::service() {
+    if (!asyncMode) return true;
+
+    bool busy = tft->dmaBusy();
+
+    if (!busy) {
+        retireStaging();
+
+        Staging& s = staging[nextStaging];
+        if (s.state == STAGING_FREE) {
+            prepareNextRun(s);
+        }
+
+        if (s.state == STAGING_READY) {
+            tft->pushImageDMA(originX + s.x, originY + s.y, s.w, s.h,
+                              (const lgfx::swap565_t*)s.pixels);
+            s.state = STAGING_IN_FLIGHT;
+            nextStaging ^= 1;
+        }
+    }
+
+    // Overlap the copy of the next run with the transfer in flight
+    Staging& next = staging[nextStaging];
+    if (next.state == STAGING_FREE) {
+        prepareNextRun(next);
+    }
+
+    return pendingTiles == 0 &&
+           staging[0].state != STAGING_READY &&
+           staging[1].state != STAGING_READY;
+}
@@ -1,6 +1,6 @@
 #include "timer.h"
 #include "settings.h"
-#include "buzzer.h"  // <-- Add this
+#include "buzzer.h"
 
 CountdownTimer timer;
 
@@ -11,8 +11,29 @@ CountdownTimer timer;
 
 CountdownTimer::CountdownTimer() {
     state = TIMER_IDLE;
-    startMillis = 0;
     redrawNeeded = true;
+    splitMode = false;
+    startUs = 0;
+    deadlineTimer = nullptr;
+    lock = portMUX_INITIALIZER_UNLOCKED;
+    unloggedEvents = 0;
+    maxLatenessUs = 0;
+}
+
+void CountdownTimer::begin() {
+    esp_timer_create_args_t args = {};
+    args.callback = &CountdownTimer::onDeadline;
+    args.arg = this;
+    args.dispatch_method = ESP_TIMER_TASK;
+    args.name = "countdown";
+
+    if (esp_timer_create(&args, &deadlineTimer) != ESP_OK) {
+        // update() polls the schedule instead (loop-rate accuracy)
+        deadlineTimer = nullptr;
+        Serial.println("Timer: esp_timer unavailable, polling");
+        return;
+    }
+    Serial.println("Timer: OK!");
 }
 
 void CountdownTimer::setReady() {
@@ -25,78 +46,173 @@ void CountdownTimer::setReady() {
 
 void CountdownTimer::start() {
     if (state == TIMER_READY) {
+        startUs = esp_timer_get_time();
+        splitMode = settings.profile->stageShots > 0;
+        if (splitMode) {
+            shotLog.beginStage(settings.profile->stageShots);
+        }
+
+        portENTER_CRITICAL(&lock);
+        schedule.start(startUs,
+                       (uint32_t)settings.profile->parTimeSeconds * 1000,
+                       (uint32_t)settings.profile->yellowWarningSeconds * 1000,
+                       (uint32_t)settings.profile->redWarningSeconds * 1000);
         state = TIMER_RUNNING;
-        startMillis = millis();
+        unloggedEvents = 0;
+        portEXIT_CRITICAL(&lock);
+
+        armNextDeadline();
         redrawNeeded = true;
-        buzzer.beepStart();  // <-- Add buzzer beep on start
+        buzzer.beepStart();
         Serial.println("Timer STARTED");
     }
 }
 
 void CountdownTimer::reset() {
+    if (deadlineTimer) {
+        esp_timer_stop(deadlineTimer);
+    }
+
+    // A callback already past esp_timer_stop() finds the schedule stopped
+    portENTER_CRITICAL(&lock);
+    schedule.stop();
     state = TIMER_IDLE;
+    unloggedEvents = 0;
+    portEXIT_CRITICAL(&lock);
+
+    endStage();
     redrawNeeded = true;
     Serial.println("Timer RESET");
 }
 
-void CountdownTimer::update() {
-    static int lastRemaining = -1;
-    
-    if (state == TIMER_RUNNING) {
-        int remaining = getRemainingSeconds();
-        
-        // Check for warning thresholds
-        if (lastRemaining != remaining) {
-            // Yellow warning (crossing threshold)
-            if (lastRemaining == settings.yellowWarningSeconds + 1 && 
-                remaining == settings.yellowWarningSeconds) {
-                buzzer.beepYellowWarning();
-            }
-            
-            // Red warning (crossing threshold)
-            if (lastRemaining == settings.redWarningSeconds + 1 && 
-                remaining == settings.redWarningSeconds) {
-                buzzer.beepRedWarning();
-            }
-            
-            lastRemaining = remaining;
-        }
-        
-        // Timer finished
-        if (remaining <= 0) {
-            state = TIMER_FINISHED;
-            redrawNeeded = true;
-            buzzer.beepFinished();
-            Serial.println("Timer FINISHED!");
+void CountdownTimer::armNextDeadline() {
+    if (!deadlineTimer) return;
+
+    portENTER_CRITICAL(&lock);
+    uint64_t deadlineUs;
+    bool pending = schedule.nextDeadline(deadlineUs);
+    portEXIT_CRITICAL(&lock);
+    if (!pending) return;
+
+    int64_t delayUs = (int64_t)deadlineUs - esp_timer_get_time();
+    esp_timer_stop(deadlineTimer);
+    esp_timer_start_once(deadlineTimer, delayUs > 0 ? delayUs : 0);
+}
+
+void CountdownTimer::onDeadline(void* arg) {
+    CountdownTimer* self = static_cast<CountdownTimer*>(arg);
+    self->fireDue();
+    self->armNextDeadline();
+}
+
+void CountdownTimer::fireDue() {
+    uint64_t now = esp_timer_get_time();
+
+    portENTER_CRITICAL(&lock);
+    uint8_t due = schedule.fireDue(now);
+    if (due & CountdownSchedule::eventBit(COUNTDOWN_FINISHED)) {
+        state = TIMER_FINISHED;
+    }
+    unloggedEvents |= due;
+    portEXIT_CRITICAL(&lock);
+
+    // Sound at the deadline; Serial output is left to update()
+    for (int i = 0; i < COUNTDOWN_EVENT_COUNT; i++) {
+        CountdownEvent e = (CountdownEvent)i;
+        if (!(due & CountdownSchedule::eventBit(e))) continue;
+
+        uint32_t lateUs = (uint32_t)(now - schedule.getDeadline(e));
+        if (lateUs > maxLatenessUs) {
+            maxLatenessUs = lateUs;
         }
-    } else {
-        lastRemaining = -1;  // Reset when not running
+    }
+    if (due & CountdownSchedule::eventBit(COUNTDOWN_FINISHED)) {
+        buzzer.beepFinished();
+    } else if (due & CountdownSchedule::eventBit(COUNTDOWN_RED)) {
+        buzzer.beepRedWarning();
+    } else if (due & CountdownSchedule::eventBit(COUNTDOWN_YELLOW)) {
+        buzzer.beepYellowWarning();
     }
 }
 
+void CountdownTimer::update() {
+    // No hardware timer - same schedule, checked once per pass
+    if (!deadlineTimer && state == TIMER_RUNNING) {
+        fireDue();
+    }
+
+    portENTER_CRITICAL(&lock);
+    uint8_t events = unloggedEvents;
+    unloggedEvents = 0;
+    portEXIT_CRITICAL(&lock);
+
+    if (events & CountdownSchedule::eventBit(COUNTDOWN_YELLOW)) {
+        Serial.println("Timer: yellow warning");
+    }
+    if (events & CountdownSchedule::eventBit(COUNTDOWN_RED)) {
+        Serial.println("Timer: red warning");
+    }
+    if (events & CountdownSchedule::eventBit(COUNTDOWN_FINISHED)) {
+        redrawNeeded = true;
+        Serial.println("Timer FINISHED!");
+        endStage();
+    }
+}
+
+bool CountdownTimer::recordShot(int64_t atUs, ShotSource source) {
+    if (state != TIMER_RUNNING || !splitMode || atUs < startUs) {
+        return false;
+    }
+    if (!shotLog.record((uint32_t)(atUs - startUs), source)) {
+        return false;
+    }
+
+    Serial.printf("Shot %u at %.2f s (%s)\n", shotLog.getShots(),
+                  shotLog.getLastShotUs() / 1000000.0f,
+                  source == SHOT_MIC ? "mic" : "imu");
+    return true;
+}
+
+void CountdownTimer::endStage() {
+    if (!shotLog.isOpen()) return;
+    shotLog.endStage();
+
+    Serial.printf("Stage %u: %u/%u shots, first %.2f s, fastest split %.2f s, average %.2f s\n",
+                  shotLog.getStage(), shotLog.getShots(), shotLog.getExpected(),
+                  shotLog.getFirstShotUs() / 1000000.0f,
+                  shotLog.getFastestSplitUs() / 1000000.0f,
+                  shotLog.getAverageSplitUs() / 1000000.0f);
+}
+
 int CountdownTimer::getRemainingSeconds() const {
-    if (state == TIMER_RUNNING) {
-        unsigned long elapsed = millis() - startMillis;
-        int elapsedSec = elapsed / 1000;
-        int remaining = settings.parTimeSeconds - elapsedSec;
-        return max(0, remaining);
+    // Whole seconds left, rounded up: par until the first second has passed
+    return (getRemainingMs() + 999) / 1000;
+}
+
+uint32_t CountdownTimer::getRemainingMs() const {
+    if (state != TIMER_RUNNING) {
+        return (uint32_t)settings.profile->parTimeSeconds * 1000UL;
     }
-    return settings.parTimeSeconds;
+
+    portENTER_CRITICAL(&lock);
+    uint32_t remaining = schedule.remainingMs(esp_timer_get_time());
+    portEXIT_CRITICAL(&lock);
+    return remaining;
 }
 
 float CountdownTimer::getPercentRemaining() const {
-    int remaining = getRemainingSeconds();
-    return (float)remaining / (float)settings.parTimeSeconds;
+    uint32_t remainingMs = getRemainingMs();
+    return (float)remainingMs / ((float)settings.profile->parTimeSeconds * 1000.0f);
 }
 
 uint16_t CountdownTimer::getTimerColor() const {
     int remaining = getRemainingSeconds();
-    
-    if (remaining > settings.yellowWarningSeconds) {
+
+    if (remaining > settings.profile->yellowWarningSeconds) {
         return COLOR_WHITE;
-    } else if (remaining > settings.redWarningSeconds) {
+    } else if (remaining > settings.profile->redWarningSeconds) {
         return COLOR_YELLOW;
     } else {
         return COLOR_RED;
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,254 @@
+#include "timer_wheel.h"
+
+TimerWheel scheduler;
+
+static constexpr uint32_t SLOT_MASK = TimerWheel::SLOTS - 1;
+
+// Jobs detached for firing are on the running list, not in a slot
+static constexpr uint8_t RUNNING_LEVEL = TimerWheel::LEVELS;
+
+// Offset of the first set bit at or after 'from', wrapping (-1 if none)
+static int nextSetFrom(uint64_t bits, int from) {
+    if (bits == 0) return -1;
+    uint64_t rotated = from ? (bits >> from) | (bits << (64 - from)) : bits;
+    return __builtin_ctzll(rotated);
+}
+
+WheelJob::WheelJob(Callback callback, void* arg) {
+    this->callback = callback;
+    this->arg = arg;
+    expiresMs = 0;
+    periodMs = 0;
+    next = nullptr;
+    prev = nullptr;
+    level = 0;
+    slot = 0;
+    pending = false;
+}
+
+TimerWheel::TimerWheel() {
+    for (int l = 0; l < LEVELS; l++) {
+        for (int s = 0; s < SLOTS; s++) {
+            slots[l][s] = nullptr;
+        }
+    }
+    running = nullptr;
+    begin(0);
+}
+
+// Unlink a whole list, so a dropped job can be scheduled again cleanly
+void TimerWheel::detachAll(WheelJob*& head) {
+    WheelJob* job = head;
+    while (job) {
+        WheelJob* next = job->next;
+        job->next = nullptr;
+        job->prev = nullptr;
+        job->pending = false;
+        job = next;
+    }
+    head = nullptr;
+}
+
+void TimerWheel::begin(uint32_t nowMs) {
+    for (int l = 0; l < LEVELS; l++) {
+        for (int s = 0; s < SLOTS; s++) {
+            detachAll(slots[l][s]);
+        }
+        occupied[l] = 0;
+    }
+    detachAll(running);
+    currentMs = nowMs + 1;
+    pendingCount = 0;
+    resetStats();
+}
+
+void TimerWheel::resetStats() {
+    maxLatenessMs = 0;
+    missedPeriods = 0;
+}
+
+void TimerWheel::link(WheelJob& job) {
+    int32_t delta = (int32_t)(job.expiresMs - currentMs);
+    uint8_t level = 0;
+    uint32_t slot;
+
+    if (delta < 0) {
+        // Overdue - fires on the next tick
+        slot = currentMs & SLOT_MASK;
+    } else {
+        while (level < LEVELS - 1 && (uint32_t)delta >= (1UL << (LEVEL_BITS * (level + 1)))) {
+            level++;
+        }
+        slot = (job.expiresMs >> (LEVEL_BITS * level)) & SLOT_MASK;
+    }
+
+    job.level = level;
+    job.slot = slot;
+    job.prev = nullptr;
+    job.next = slots[level][slot];
+    if (job.next) {
+        job.next->prev = &job;
+    }
+    slots[level][slot] = &job;
+    occupied[level] |= 1ULL << slot;
+}
+
+void TimerWheel::unlink(WheelJob& job) {
+    if (job.prev) {
+        job.prev->next = job.next;
+    } else if (job.level == RUNNING_LEVEL) {
+        running = job.next;
+    } else {
+        slots[job.level][job.slot] = job.next;
+        if (!job.next) {
+            occupied[job.level] &= ~(1ULL << job.slot);
+        }
+    }
+    if (job.next) {
+        job.next->prev = job.prev;
+    }
+    job.next = nullptr;
+    job.prev = nullptr;
+}
+
+void TimerWheel::schedule(WheelJob& job, uint32_t delayMs, uint32_t periodMs) {
+    if (job.pending) {
+        unlink(job);
+    } else {
+        pendingCount++;
+    }
+
+    if (delayMs > MAX_DELAY_MS) {
+        delayMs = MAX_DELAY_MS;
+    }
+    // currentMs is one past the last processed tick
+    job.expiresMs = currentMs - 1 + delayMs;
+    job.periodMs = periodMs;
+    job.pending = true;
+    link(job);
+}
+
+void TimerWheel::cancel(WheelJob& job) {
+    if (!job.pending) return;
+    unlink(job);
+    job.pending = false;
+    pendingCount--;
+}
+
+void TimerWheel::cascade(int level, int index) {
+    WheelJob* job = slots[level][index];
+    slots[level][index] = nullptr;
+    occupied[level] &= ~(1ULL << index);
+
+    // Each job lands in a lower level now that it is closer
+    while (job) {
+        WheelJob* next = job->next;
+        link(*job);
+        job = next;
+    }
+}
+
+int TimerWheel::runTick(uint32_t nowMs) {
+    uint32_t tick = currentMs;
+    int index = tick & SLOT_MASK;
+
+    // Level 0 wrapped - bring the next slot of each level above down
+    for (int l = 1; index == 0 && l < LEVELS; l++) {
+        index = (tick >> (LEVEL_BITS * l)) & SLOT_MASK;
+        cascade(l, index);
+    }
+    index = tick & SLOT_MASK;
+
+    // Detach this tick's jobs, so callbacks can schedule into any slot
+    running = slots[0][index];
+    slots[0][index] = nullptr;
+    occupied[0] &= ~(1ULL << index);
+    for (WheelJob* j = running; j; j = j->next) {
+        j->level = RUNNING_LEVEL;
+    }
+    currentMs = tick + 1;
+
+    int ran = 0;
+    while (running) {
+        WheelJob& job = *running;
+        unlink(job);
+
+        uint32_t lateMs = nowMs - job.expiresMs;
+        if (lateMs > maxLatenessMs) {
+            maxLatenessMs = lateMs;
+        }
+
+        if (job.periodMs > 0) {
+            // Stay on the job's grid; skip periods that are already over
+            uint32_t next = job.expiresMs + job.periodMs;
+            if ((int32_t)(next - nowMs) <= 0) {
+                uint32_t missed = (nowMs - next) / job.periodMs + 1;
+                missedPeriods += missed;
+                next += missed * job.periodMs;
+            }
+            job.expiresMs = next;
+            link(job);
+        } else {
+            job.pending = false;
+            pendingCount--;
+        }
+
+        job.callback(job.arg);
+        ran++;
+    }
+    return ran;
+}
+
+int TimerWheel::advance(uint32_t nowMs) {
+    int ran = 0;
+
+    while ((int32_t)(nowMs - currentMs) >= 0) {
+        uint32_t index = currentMs & SLOT_MASK;
+
+        // Skip empty level 0 slots up to the next wrap (no cascade there)
+        if (index != 0) {
+            uint64_t ahead = occupied[0] >> index;
+            uint32_t skip = ahead ? __builtin_ctzll(ahead) : SLOTS - index;
+            if (skip > 0) {
+                uint32_t left = nowMs - currentMs + 1;
+                currentMs += skip < left ? skip : left;
+                continue;
+            }
+        }
+        ran += runTick(nowMs);
+    }
+    return ran;
+}
+
+bool TimerWheel::nextDeadline(uint32_t nowMs, uint32_t& delayMs) const {
+    if (pendingCount == 0) return false;
+
+    bool found = false;
+    uint32_t earliest = 0;
+
+    int n = nextSetFrom(occupied[0], currentMs & SLOT_MASK);
+    if (n >= 0) {
+        earliest = currentMs + n;
+        found = true;
+    }
+
+    for (int l = 1; l < LEVELS; l++) {
+        int shift = LEVEL_BITS * l;
+        uint32_t base = currentMs >> shift;
+        // A slot not yet cascaded at its own start tick is still ahead
+        uint32_t first = (currentMs & ((1UL << shift) - 1)) == 0 ? 0 : 1;
+        n = nextSetFrom(occupied[l], (base + first) & SLOT_MASK);
+        if (n < 0) continue;
+
+        uint32_t start = (base + first + n) << shift;
+        if (!found || (int32_t)(start - earliest) < 0) {
+            earliest = start;
+            found = true;
+        }
+    }
+    if (!found) return false;
+
+    int32_t delta = (int32_t)(earliest - nowMs);
+    delayMs = delta > 0 ? delta : 0;
+    return true;
+}
@@ -0,0 +1,110 @@
+#include "tone_blanker.h"
+#include <math.h>
+
+ToneBlanker::ToneBlanker() {
+    head = 0;
+    count = 0;
+    ringDownUs = 30000;
+    halfWidthHz = 150.0f;
+}
+
+void ToneBlanker::configure(uint32_t ringDown, float halfWidth) {
+    ringDownUs = ringDown;
+    halfWidthHz = halfWidth;
+}
+
+void ToneBlanker::addTone(int64_t startUs, int64_t endUs, uint16_t frequency) {
+    if (frequency == 0 || endUs <= startUs) return;
+
+    // Oldest entry goes first - tones are reported in time order
+    OwnTone& t = tones[head];
+    t.startUs = startUs;
+    t.endUs = endUs;
+    t.frequency = frequency;
+    head = (head + 1) % MAX_TONES;
+    if (count < MAX_TONES) {
+        count++;
+    }
+}
+
+void ToneBlanker::clear() {
+    head = 0;
+    count = 0;
+}
+
+bool ToneBlanker::overlaps(const OwnTone& t, int64_t fromUs, int64_t toUs) const {
+    return t.startUs <= toUs && t.endUs + (int64_t)ringDownUs >= fromUs;
+}
+
+uint32_t ToneBlanker::binMask(int64_t fromUs, int64_t toUs, const float* binHz, int bins) const {
+    uint32_t mask = 0;
+
+    for (int i = 0; i < count; i++) {
+        const OwnTone& t = tones[i];
+        if (!overlaps(t, fromUs, toUs)) continue;
+
+        for (int h = 1; h <= MAX_HARMONIC; h++) {
+            float hz = (float)t.frequency * h;
+            for (int b = 0; b < bins && b < 32; b++) {
+                if (fabsf(binHz[b] - hz) <= halfWidthHz) {
+                    mask |= 1UL << b;
+                }
+            }
+        }
+    }
+    return mask;
+}
+
+int ToneBlanker::activeTones(int64_t fromUs, int64_t toUs, uint16_t* frequencies, int maxTones) const {
+    int found = 0;
+
+    for (int i = 0; i < count && found < maxTones; i++) {
+        const OwnTone& t = tones[i];
+        if (!overlaps(t, fromUs, toUs)) continue;
+
+        bool seen = false;
+        for (int j = 0; j < found; j++) {
+            if (frequencies[j] == t.frequency) seen = true;
+        }
+        if (!seen) {
+            frequencies[found++] = t.frequency;
+        }
+    }
+    return found;
+}
+
+int ToneBlanker::notch(float* samples, int count, float frequency, float sampleRate) {
+    if (frequency <= 0) return 0;
+
+    for (int h = 1; h <= MAX_HARMONIC; h++) {
+        float hz = frequency * h;
+        if (hz >= sampleRate * 0.5f) break;
+
+        // RBJ cookbook notch, normalised to a0 = 1
+        float w0 = 2.0f * (float)M_PI * hz / sampleRate;
+        float alpha = sinf(w0) / (2.0f * NOTCH_Q);
+        float cosw = cosf(w0);
+        float a0 = 1.0f + alpha;
+        float b0 = 1.0f / a0;
+        float b1 = -2.0f * cosw / a0;
+        float a1 = b1;
+        float a2 = (1.0f - alpha) / a0;
+
+        float x1 = 0, x2 = 0, y1 = 0, y2 = 0;
+        for (int i = 0; i < count; i++) {
+            float x = samples[i];
+            float y = b0 * x + b1 * x1 + b0 * x2 - a1 * y1 - a2 * y2;
+            x2 = x1;
+            x1 = x;
+            y2 = y1;
+            y1 = y;
+            samples[i] = y;
+        }
+    }
+
+    // Transient decays with tau = 2Q / w0 (slowest at the fundamental);
+    // three time constants leave ~5% of the tone
+    float tauSamples = 2.0f * NOTCH_Q / (2.0f * (float)M_PI * frequency) * sampleRate;
+    int settle = (int)(3.0f * tauSamples) + 1;
+    return settle < count ? settle : count;
+}
@@ -0,0 +1,326 @@
+#include "widgets.h"
+
+Widget::Widget(int x, int y, int width, int height)
+    : x(x)
+    , y(y)
+    , width(width)
+    , height(height)
+    , dirty(true)
+    , visible(true)
+    , parent(nullptr)
+    , firstChild(nullptr)
+    , nextSibling(nullptr)
+{
+}
+
+void Widget::addChild(Widget* child) {
+    child->parent = this;
+    child->nextSibling = nullptr;
+
+    // Append - children paint in the order they were added
+    if (!firstChild) {
+        firstChild = child;
+        return;
+    }
+    Widget* last = firstChild;
+    while (last->nextSibling) last = last->nextSibling;
+    last->nextSibling = child;
+}
+
+void Widget::setVisible(bool show) {
+    if (show == visible) return;
+    visible = show;
+
+    if (parent) {
+        parent->invalidate();
+    } else {
+        dirty = true;
+    }
+}
+
+int Widget::paint(TileCanvas& target) {
+    if (!visible) return 0;
+
+    int painted = 0;
+    bool repainted = dirty;
+
+    if (dirty) {
+        draw(target);
+        target.addDamage(x, y, width, height);
+        dirty = false;
+        painted++;
+    } else if (drawChanges(target)) {
+        painted++;
+    }
+
+    for (Widget* child = firstChild; child; child = child->nextSibling) {
+        // Parent just painted over the child's area
+        if (repainted) child->dirty = true;
+        painted += child->paint(target);
+    }
+    return painted;
+}
+
+// ----------------------------------------------------------------------------
+
+PanelWidget::PanelWidget(int x, int y, int width, int height, uint16_t color)
+    : Widget(x, y, width, height)
+    , bgColor(color)
+{
+}
+
+void PanelWidget::setColor(uint16_t color) {
+    if (color == bgColor) return;
+    bgColor = color;
+    invalidate();
+}
+
+void PanelWidget::draw(TileCanvas& target) {
+    target.canvas().fillRect(x, y, width, height, target.color(bgColor));
+}
+
+// ----------------------------------------------------------------------------
+
+LabelWidget::LabelWidget(int x, int y, int width, int height, int textSize)
+    : Widget(x, y, width, height)
+    , textSize(textSize)
+    , fgColor(TFT_WHITE)
+    , bgColor(TFT_BLACK)
+{
+    text[0] = '\0';
+}
+
+void LabelWidget::setText(const char* newText) {
+    if (strncmp(text, newText, MAX_TEXT - 1) == 0) return;
+    strncpy(text, newText, MAX_TEXT - 1);
+    text[MAX_TEXT - 1] = '\0';
+    invalidate();
+}
+
+void LabelWidget::setColors(uint16_t fg, uint16_t bg) {
+    if (fg == fgColor && bg == bgColor) return;
+    fgColor = fg;
+    bgColor = bg;
+    invalidate();
+}
+
+void LabelWidget::draw(TileCanvas& target) {
+    LGFX_Sprite& g = target.canvas();
+    g.fillRect(x, y, width, height, target.color(bgColor));
+    g.setTextSize(textSize);
+    g.setTextColor(target.color(fgColor));
+    g.setCursor(x, y);
+    g.print(text);
+}
+
+// ----------------------------------------------------------------------------
+
+ReadoutWidget::ReadoutWidget(int x, int y, int width, GlyphCache* cache)
+    : Widget(x, y, width, GlyphCache::GLYPH_H)
+    , glyphs(cache)
+    , fgColor(TFT_WHITE)
+    , bgColor(TFT_BLACK)
+{
+    text[0] = '\0';
+}
+
+void ReadoutWidget::setText(const char* newText) {
+    if (strncmp(text, newText, MAX_TEXT - 1) == 0) return;
+    strncpy(text, newText, MAX_TEXT - 1);
+    text[MAX_TEXT - 1] = '\0';
+    invalidate();
+}
+
+void ReadoutWidget::setColors(uint16_t fg, uint16_t bg) {
+    if (fg == fgColor && bg == bgColor) return;
+    fgColor = fg;
+    bgColor = bg;
+    invalidate();
+}
+
+void ReadoutWidget::draw(TileCanvas& target) {
+    LGFX_Sprite& g = target.canvas();
+    g.fillRect(x, y, width, height, target.color(bgColor));
+
+    int textX = x + (width - GlyphCache::textWidth(strlen(text))) / 2;
+
+    if (glyphs && glyphs->isReady()) {
+        glyphs->setColors(fgColor, bgColor);
+        if (target.isIndexed()) {
+            glyphs->drawStringIndexed(g, textX, y, text, target.color(fgColor), target.color(bgColor));
+        } else {
+            glyphs->drawString(g, textX, y, text);
+        }
+    } else {
+        g.setTextSize(GlyphCache::TEXT_SIZE);
+        g.setTextColor(target.color(fgColor));
+        g.setCursor(textX, y);
+        g.print(text);
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+ProgressBarWidget::ProgressBarWidget(int x, int y, int width, int height)
+    : Widget(x, y, width, height)
+    , fillWidth(0)
+    , drawnFillWidth(0)
+    , fillColor(TFT_BLACK)
+{
+}
+
+void ProgressBarWidget::setValue(float percentage, uint16_t color) {
+    int newFill = (int)((width - 4) * percentage);
+    fillWidth = constrain(newFill, 0, width - 4);
+
+    // Fill changes are picked up by drawChanges()
+    if (color != fillColor) {
+        fillColor = color;
+        invalidate();
+    }
+}
+
+bool ProgressBarWidget::drawChanges(TileCanvas& target) {
+    if (fillWidth == drawnFillWidth) return false;
+
+    int from = min(fillWidth, drawnFillWidth);
+    int to = max(fillWidth, drawnFillWidth);
+    uint16_t color = (fillWidth > drawnFillWidth) ? fillColor : TFT_BLACK;
+
+    target.canvas().fillRect(x + 2 + from, y + 2, to - from, height - 4, target.color(color));
+    target.addDamage(x + 2 + from, y + 2, to - from, height - 4);
+    drawnFillWidth = fillWidth;
+    return true;
+}
+
+void ProgressBarWidget::draw(TileCanvas& target) {
+    LGFX_Sprite& g = target.canvas();
+    drawnFillWidth = fillWidth;
+
+    g.drawRect(x, y, width, height, target.color(TFT_DARKGREY));
+
+    if (fillWidth > 0) {
+        g.fillRect(x + 2, y + 2, fillWidth, height - 4, target.color(fillColor));
+    }
+
+    int remainWidth = (width - 4) - fillWidth;
+    if (remainWidth > 0) {
+        g.fillRect(x + 2 + fillWidth, y + 2, remainWidth, height - 4, target.color(TFT_BLACK));
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+BubbleWidget::BubbleWidget(int x, int y, int width, int height)
+    : Widget(x, y, width, height)
+    , fullScale(5.0f)
+    , markOffset(0)
+    , bubbleX((width - BUBBLE_W) / 2)
+    , drawnBubbleX((width - BUBBLE_W) / 2)
+{
+}
+
+void BubbleWidget::setScale(float fullScaleDeg, float toleranceDeg) {
+    int travel = (width - 4 - BUBBLE_W) / 2;
+    int marks = (int)(travel * toleranceDeg / fullScaleDeg) + BUBBLE_W / 2;
+    if (fullScaleDeg == fullScale && marks == markOffset) return;
+    fullScale = fullScaleDeg;
+    markOffset = marks;
+    invalidate();
+}
+
+int BubbleWidget::positionFor(float angle) const {
+    // Tilted CW (positive) raises the left end - the bubble goes left
+    int travel = (width - 4 - BUBBLE_W) / 2;
+    int offset = (int)lroundf(-angle / fullScale * travel);
+    offset = constrain(offset, -travel, travel);
+    return (width - BUBBLE_W) / 2 + offset;
+}
+
+void BubbleWidget::setAngle(float angle) {
+    // Position changes are picked up by drawChanges()
+    bubbleX = positionFor(angle);
+}
+
+void BubbleWidget::drawInterior(TileCanvas& target, int from, int to) {
+    // Vial columns [from, to), widget-local: liquid, marks, then the bubble
+    LGFX_Sprite& g = target.canvas();
+    int center = width / 2;
+    int top = y + 2;
+    int inner = height - 4;
+
+    g.fillRect(x + from, top, to - from, inner, target.color(TFT_BLACK));
+
+    const int marks[3] = {center - markOffset, center, center + markOffset};
+    for (int i = 0; i < 3; i++) {
+        if (marks[i] >= from && marks[i] < to) {
+            g.drawFastVLine(x + marks[i], top, inner, target.color(TFT_DARKGREY));
+        }
+    }
+
+    int b0 = max(bubbleX, from);
+    int b1 = min(bubbleX + BUBBLE_W, to);
+    if (b1 > b0) {
+        g.setClipRect(x + b0, top, b1 - b0, inner);
+        g.fillRoundRect(x + bubbleX, top + 2, BUBBLE_W, inner - 4, 6, target.color(TFT_WHITE));
+        g.clearClipRect();
+    }
+}
+
+bool BubbleWidget::drawChanges(TileCanvas& target) {
+    if (bubbleX == drawnBubbleX) return false;
+
+    int from = min(bubbleX, drawnBubbleX);
+    int to = max(bubbleX, drawnBubbleX) + BUBBLE_W;
+    drawInterior(target, from, to);
+    target.addDamage(x + from, y + 2, to - from, height - 4);
+    drawnBubbleX = bubbleX;
+    return true;
+}
+
+void BubbleWidget::draw(TileCanvas& target) {
+    drawnBubbleX = bubbleX;
+    target.canvas().drawRect(x, y, width, height, target.color(TFT_DARKGREY));
+    target.canvas().drawRect(x + 1, y + 1, width - 2, height - 2, target.color(TFT_BLACK));
+    drawInterior(target, 2, width - 2);
+}
+
+// ----------------------------------------------------------------------------
+
+BitmapWidget::BitmapWidget(int x, int y, int width, int height)
+    : Widget(x, y, width, height)
+    , bitmap(nullptr)
+    , fgColor(TFT_WHITE)
+    , bgColor(TFT_BLACK)
+{
+}
+
+void BitmapWidget::setBitmap(const RleAsset* asset) {
+    if (asset == bitmap) return;
+    bitmap = asset;
+    invalidate();
+}
+
+void BitmapWidget::setColors(uint16_t fg, uint16_t bg) {
+    if (fg == fgColor && bg == bgColor) return;
+    fgColor = fg;
+    bgColor = bg;
+    invalidate();
+}
+
+void BitmapWidget::draw(TileCanvas& target) {
+    LGFX_Sprite& g = target.canvas();
+    if (!bitmap) {
+        g.fillRect(x, y, width, height, target.color(bgColor));
+        return;
+    }
+
+    // 1-bit asset: index 0 background, 1 foreground
+    const uint16_t colors[2] = {target.color(bgColor), target.color(fgColor)};
+    int bx = x + (width - bitmap->width) / 2;
+    int by = y + (height - bitmap->height) / 2;
+    if (bitmap->width < width || bitmap->height < height) {
+        g.fillRect(x, y, width, height, colors[0]);
+    }
+    drawRleAsset(g, bx, by, *bitmap, colors);
+}
@@ -0,0 +1,170 @@
+#include <unity.h>
+#include "countdown_schedule.h"
+
+static const uint8_t YELLOW = 1 << COUNTDOWN_YELLOW;
+static const uint8_t RED = 1 << COUNTDOWN_RED;
+static const uint8_t FINISHED = 1 << COUNTDOWN_FINISHED;
+
+// 32-bit micros() wraps here (~71.6 min of uptime)
+static const uint64_t WRAP_32_US = 0x100000000ULL;
+
+struct Firing {
+    uint8_t events;
+    uint64_t atUs;
+};
+
+/**
+ * Drive a run with a virtual clock the way Timer does: wait for the next
+ * deadline, stepping stepUs at a time (the timer task's resolution), and
+ * fire what is due. Records every non-empty fireDue().
+ */
+static int runToEnd(CountdownSchedule& s, uint64_t nowUs, uint64_t stepUs, Firing* out, int max) {
+    int count = 0;
+    uint64_t deadlineUs;
+    while (s.nextDeadline(deadlineUs)) {
+        while (nowUs < deadlineUs) {
+            TEST_ASSERT_EQUAL_UINT8(0, s.fireDue(nowUs));
+            nowUs += stepUs;
+        }
+        uint8_t due = s.fireDue(nowUs);
+        TEST_ASSERT_TRUE(due != 0);
+        if (count < max) {
+            out[count].events = due;
+            out[count].atUs = nowUs;
+        }
+        count++;
+    }
+    return count;
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+void test_deadlines_from_par_and_warnings(void) {
+    CountdownSchedule s;
+    const uint64_t startUs = 5000000;
+    s.start(startUs, 60000, 10000, 5000);
+
+    TEST_ASSERT_TRUE(s.isRunning());
+    TEST_ASSERT_EQUAL_UINT64(startUs + 50000000ULL, s.getDeadline(COUNTDOWN_YELLOW));
+    TEST_ASSERT_EQUAL_UINT64(startUs + 55000000ULL, s.getDeadline(COUNTDOWN_RED));
+    TEST_ASSERT_EQUAL_UINT64(startUs + 60000000ULL, s.getDeadline(COUNTDOWN_FINISHED));
+
+    uint64_t nextUs = 0;
+    TEST_ASSERT_TRUE(s.nextDeadline(nextUs));
+    TEST_ASSERT_EQUAL_UINT64(startUs + 50000000ULL, nextUs);
+}
+
+void test_each_event_fires_once_on_its_deadline(void) {
+    CountdownSchedule s;
+    const uint64_t startUs = 1000;
+    s.start(startUs, 30000, 10000, 5000);
+
+    Firing firings[8];
+    int count = runToEnd(s, startUs, 1000, firings, 8);
+
+    TEST_ASSERT_EQUAL_INT(3, count);
+    TEST_ASSERT_EQUAL_UINT8(YELLOW, firings[0].events);
+    TEST_ASSERT_EQUAL_UINT64(startUs + 20000000ULL, firings[0].atUs);
+    TEST_ASSERT_EQUAL_UINT8(RED, firings[1].events);
+    TEST_ASSERT_EQUAL_UINT64(startUs + 25000000ULL, firings[1].atUs);
+    TEST_ASSERT_EQUAL_UINT8(FINISHED, firings[2].events);
+    TEST_ASSERT_EQUAL_UINT64(startUs + 30000000ULL, firings[2].atUs);
+
+    TEST_ASSERT_FALSE(s.isRunning());
+    TEST_ASSERT_TRUE(s.isFinished());
+    TEST_ASSERT_EQUAL_UINT8(0, s.fireDue(startUs + 40000000ULL));
+}
+
+void test_late_fire_delivers_everything_due_at_once(void) {
+    CountdownSchedule s;
+    s.start(0, 20000, 10000, 5000);
+
+    // Red due, yellow overdue - a stalled timer task catches up in one call
+    TEST_ASSERT_EQUAL_UINT8(YELLOW | RED, s.fireDue(16000000ULL));
+    TEST_ASSERT_TRUE(s.isRunning());
+    TEST_ASSERT_EQUAL_UINT8(0, s.fireDue(16500000ULL));
+    TEST_ASSERT_EQUAL_UINT8(FINISHED, s.fireDue(90000000ULL));
+    TEST_ASSERT_FALSE(s.isRunning());
+}
+
+void test_warnings_at_or_above_par_are_left_out(void) {
+    CountdownSchedule s;
+    s.start(0, 10000, 10000, 15000);
+
+    uint64_t nextUs = 0;
+    TEST_ASSERT_TRUE(s.nextDeadline(nextUs));
+    TEST_ASSERT_EQUAL_UINT64(10000000ULL, nextUs);
+    TEST_ASSERT_EQUAL_UINT8(0, s.fireDue(0));
+    TEST_ASSERT_EQUAL_UINT8(FINISHED, s.fireDue(10000000ULL));
+}
+
+void test_stop_disarms_and_restart_rearms(void) {
+    CountdownSchedule s;
+    uint64_t nextUs = 0;
+
+    s.start(0, 20000, 10000, 5000);
+    TEST_ASSERT_EQUAL_UINT8(YELLOW, s.fireDue(10000000ULL));
+    s.stop();
+    TEST_ASSERT_FALSE(s.nextDeadline(nextUs));
+    TEST_ASSERT_EQUAL_UINT8(0, s.fireDue(30000000ULL));
+    TEST_ASSERT_EQUAL_UINT32(0, s.remainingMs(11000000ULL));
+
+    // A new run fires its warnings again
+    s.start(40000000ULL, 20000, 10000, 5000);
+    TEST_ASSERT_EQUAL_UINT8(YELLOW, s.fireDue(50000000ULL));
+}
+
+void test_remaining_ms_rounds_up(void) {
+    CountdownSchedule s;
+    s.start(100, 1500, 1000, 500);
+
+    TEST_ASSERT_EQUAL_UINT32(1500, s.remainingMs(100));
+    TEST_ASSERT_EQUAL_UINT32(1500, s.remainingMs(101));
+    TEST_ASSERT_EQUAL_UINT32(1499, s.remainingMs(1100));
+    TEST_ASSERT_EQUAL_UINT32(1, s.remainingMs(100 + 1499999));
+    TEST_ASSERT_EQUAL_UINT32(0, s.remainingMs(100 + 1500000));
+}
+
+void test_run_across_32bit_microsecond_wrap(void) {
+    CountdownSchedule s;
+    // Yellow before the wrap, red and the finish after it
+    const uint64_t startUs = WRAP_32_US - 12000000ULL;
+    s.start(startUs, 20000, 10000, 5000);
+
+    TEST_ASSERT_TRUE(s.getDeadline(COUNTDOWN_YELLOW) < WRAP_32_US);
+    TEST_ASSERT_TRUE(s.getDeadline(COUNTDOWN_RED) > WRAP_32_US);
+
+    // remainingMs counts down smoothly through the wrap
+    uint32_t last = s.remainingMs(startUs);
+    for (uint64_t t = WRAP_32_US - 2000; t <= WRAP_32_US + 2000; t += 250) {
+        uint32_t left = s.remainingMs(t);
+        TEST_ASSERT_LESS_OR_EQUAL_UINT32(last, left);
+        TEST_ASSERT_EQUAL_UINT32((uint32_t)((startUs + 20000000ULL - t + 999) / 1000), left);
+        last = left;
+    }
+
+    Firing firings[8];
+    int count = runToEnd(s, startUs, 1000, firings, 8);
+
+    TEST_ASSERT_EQUAL_INT(3, count);
+    TEST_ASSERT_EQUAL_UINT8(YELLOW, firings[0].events);
+    TEST_ASSERT_EQUAL_UINT64(startUs + 10000000ULL, firings[0].atUs);
+    TEST_ASSERT_EQUAL_UINT8(RED, firings[1].events);
+    TEST_ASSERT_EQUAL_UINT64(startUs + 15000000ULL, firings[1].atUs);
+    TEST_ASSERT_EQUAL_UINT8(FINISHED, firings[2].events);
+    TEST_ASSERT_EQUAL_UINT64(startUs + 20000000ULL, firings[2].atUs);
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_deadlines_from_par_and_warnings);
+    RUN_TEST(test_each_event_fires_once_on_its_deadline);
+    RUN_TEST(test_late_fire_delivers_everything_due_at_once);
+    RUN_TEST(test_warnings_at_or_above_par_are_left_out);
+    RUN_TEST(test_stop_disarms_and_restart_rearms);
+    RUN_TEST(test_remaining_ms_rounds_up);
+    RUN_TEST(test_run_across_32bit_microsecond_wrap);
+    return UNITY_END();
+}
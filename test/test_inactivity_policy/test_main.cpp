@@ -0,0 +1,143 @@
+#include <unity.h>
+#include "inactivity_policy.h"
+
+// Same timeouts as PowerManager
+static const uint32_t LIGHT_MS = 2UL * 60UL * 1000UL;
+static const uint32_t DEEP_MS = 10UL * 60UL * 1000UL;
+
+/**
+ * Step a simulated clock from startMs to endMs (exclusive) in stepMs
+ * increments, the way loop() polls the policy
+ * @return time of the first non-NONE action (0 if none), action in 'action'
+ */
+static uint32_t runUntilAction(InactivityPolicy& p, uint32_t startMs, uint32_t endMs,
+                               uint32_t stepMs, PowerAction& action) {
+    action = POWER_ACTION_NONE;
+    for (uint32_t t = startMs; (int32_t)(endMs - t) > 0; t += stepMs) {
+        action = p.update(t);
+        if (action != POWER_ACTION_NONE) return t;
+    }
+    return 0;
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+void test_light_then_deep_sleep_on_idle(void) {
+    InactivityPolicy p;
+    p.configure(LIGHT_MS, DEEP_MS);
+    p.notifyActivity(1000);
+
+    PowerAction action;
+    uint32_t at = runUntilAction(p, 1000, 1000 + DEEP_MS * 2, 100, action);
+    TEST_ASSERT_EQUAL_INT(POWER_ACTION_LIGHT_SLEEP, action);
+    TEST_ASSERT_EQUAL_UINT32(1000 + LIGHT_MS, at);
+    TEST_ASSERT_EQUAL_INT(POWER_LIGHT_SLEEP, p.getState());
+
+    // Light sleep is reported once, deep sleep follows from the same idle start
+    at = runUntilAction(p, at, 1000 + DEEP_MS * 2, 100, action);
+    TEST_ASSERT_EQUAL_INT(POWER_ACTION_DEEP_SLEEP, action);
+    TEST_ASSERT_EQUAL_UINT32(1000 + DEEP_MS, at);
+    TEST_ASSERT_EQUAL_INT(POWER_DEEP_SLEEP, p.getState());
+
+    TEST_ASSERT_EQUAL_INT(POWER_ACTION_NONE, p.update(1000 + DEEP_MS * 3));
+    TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, p.msUntilNextTransition(1000 + DEEP_MS * 3));
+}
+
+void test_activity_restarts_the_idle_countdown(void) {
+    InactivityPolicy p;
+    p.configure(LIGHT_MS, DEEP_MS);
+    p.notifyActivity(0);
+
+    TEST_ASSERT_EQUAL_INT(POWER_ACTION_NONE, p.update(LIGHT_MS - 1));
+    p.notifyActivity(LIGHT_MS - 1);
+    TEST_ASSERT_EQUAL_INT(POWER_ACTION_NONE, p.update(LIGHT_MS + 5000));
+    TEST_ASSERT_EQUAL_UINT32(LIGHT_MS - 5001, p.msUntilNextTransition(LIGHT_MS + 5000));
+
+    // Motion wakes a light-sleeping unit back to ACTIVE
+    TEST_ASSERT_EQUAL_INT(POWER_ACTION_LIGHT_SLEEP, p.update(2 * LIGHT_MS - 1));
+    p.notifyActivity(2 * LIGHT_MS);
+    TEST_ASSERT_EQUAL_INT(POWER_ACTIVE, p.getState());
+    TEST_ASSERT_EQUAL_UINT32(LIGHT_MS, p.msUntilNextTransition(2 * LIGHT_MS));
+}
+
+void test_inhibit_blocks_sleep_and_restarts_on_release(void) {
+    InactivityPolicy p;
+    p.configure(LIGHT_MS, DEEP_MS);
+    p.notifyActivity(0);
+
+    // Timer running or menu open: never sleeps, however long
+    p.setInhibited(true, 1000);
+    TEST_ASSERT_TRUE(p.isInhibited());
+    TEST_ASSERT_EQUAL_INT(POWER_ACTION_NONE, p.update(DEEP_MS * 5));
+    TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, p.msUntilNextTransition(DEEP_MS * 5));
+
+    // Repeating the same state is not activity
+    p.setInhibited(true, DEEP_MS * 5);
+    TEST_ASSERT_EQUAL_UINT32(DEEP_MS * 5 - 1000, p.getIdleMs(DEEP_MS * 5));
+
+    // Release: the countdown starts over from here
+    const uint32_t releaseMs = DEEP_MS * 6;
+    p.setInhibited(false, releaseMs);
+    TEST_ASSERT_EQUAL_INT(POWER_ACTION_NONE, p.update(releaseMs + LIGHT_MS - 1));
+    TEST_ASSERT_EQUAL_INT(POWER_ACTION_LIGHT_SLEEP, p.update(releaseMs + LIGHT_MS));
+}
+
+void test_disabled_levels(void) {
+    InactivityPolicy deepOnly;
+    deepOnly.configure(0, DEEP_MS);
+    deepOnly.notifyActivity(0);
+    TEST_ASSERT_EQUAL_UINT32(DEEP_MS, deepOnly.msUntilNextTransition(0));
+    TEST_ASSERT_EQUAL_INT(POWER_ACTION_NONE, deepOnly.update(LIGHT_MS * 2));
+    // Straight from ACTIVE to deep sleep
+    TEST_ASSERT_EQUAL_INT(POWER_ACTION_DEEP_SLEEP, deepOnly.update(DEEP_MS));
+
+    InactivityPolicy never;
+    never.configure(0, 0);
+    never.notifyActivity(0);
+    TEST_ASSERT_EQUAL_INT(POWER_ACTION_NONE, never.update(UINT32_MAX / 2));
+    TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, never.msUntilNextTransition(UINT32_MAX / 2));
+}
+
+void test_late_update_goes_straight_to_deep_sleep(void) {
+    InactivityPolicy p;
+    p.configure(LIGHT_MS, DEEP_MS);
+    p.notifyActivity(0);
+
+    // Nothing polled in between (e.g. a long blocking call)
+    TEST_ASSERT_EQUAL_INT(POWER_ACTION_DEEP_SLEEP, p.update(DEEP_MS + 10));
+    TEST_ASSERT_EQUAL_INT(POWER_ACTION_NONE, p.update(DEEP_MS + 20));
+}
+
+void test_millis_wraparound(void) {
+    InactivityPolicy p;
+    p.configure(LIGHT_MS, DEEP_MS);
+
+    // Last activity 30 s before millis() wraps
+    const uint32_t activityMs = 0xFFFFFFFFUL - 30000UL;
+    p.notifyActivity(activityMs);
+
+    TEST_ASSERT_EQUAL_UINT32(LIGHT_MS, p.msUntilNextTransition(activityMs));
+    TEST_ASSERT_EQUAL_UINT32(LIGHT_MS - 40001, p.msUntilNextTransition(10000));
+
+    PowerAction action;
+    uint32_t at = runUntilAction(p, activityMs, activityMs + DEEP_MS + 1, 1000, action);
+    TEST_ASSERT_EQUAL_INT(POWER_ACTION_LIGHT_SLEEP, action);
+    TEST_ASSERT_EQUAL_UINT32(activityMs + LIGHT_MS, at);
+
+    at = runUntilAction(p, at, activityMs + DEEP_MS + 1, 1000, action);
+    TEST_ASSERT_EQUAL_INT(POWER_ACTION_DEEP_SLEEP, action);
+    TEST_ASSERT_EQUAL_UINT32(activityMs + DEEP_MS, at);
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_light_then_deep_sleep_on_idle);
+    RUN_TEST(test_activity_restarts_the_idle_countdown);
+    RUN_TEST(test_inhibit_blocks_sleep_and_restarts_on_release);
+    RUN_TEST(test_disabled_levels);
+    RUN_TEST(test_late_update_goes_straight_to_deep_sleep);
+    RUN_TEST(test_millis_wraparound);
+    return UNITY_END();
+}
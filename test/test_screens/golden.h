@@ -0,0 +1,24 @@
+#ifndef SCREEN_GOLDEN_H
+#define SCREEN_GOLDEN_H
+
+#include <stdint.h>
+
+/**
+ * Golden values per screen from the host render build: view hash of the
+ * whole panel and the bus bytes of the frame that drew it (from the
+ * screen the test starts at). A screen without an entry prints its line
+ * and is ignored; paste the line here. After an intended change to a
+ * screen, rebuild with -DRECORD_GOLDEN to print the whole table.
+ */
+struct ScreenGolden {
+    const char* name;
+    uint32_t hash;
+    uint32_t bytes;
+};
+
+static const ScreenGolden SCREEN_GOLDEN[] = {
+    // name                  hash        bytes
+    {nullptr, 0, 0}
+};
+
+#endif
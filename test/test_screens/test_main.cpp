@@ -0,0 +1,559 @@
+#include <unity.h>
+#include <Arduino.h>
+#include <RotaryEncoder.h>
+#include "display_manager.h"
+#include "menu_system.h"
+#include "render_queue.h"
+#include "settings.h"
+#include "shot_log.h"
+#include "golden.h"
+
+// Screens rendered by the real DisplayManager/MenuSystem through LovyanGFX
+// and Bus_Capture: a golden view hash and frame cost per screen, plus the
+// redraw invariants that hold without recorded values.
+
+// Every pixel of a region, as a full push sends it (RGB565)
+static const uint32_t LEVEL_REGION_BYTES = 170UL * LEVEL_REGION_HEIGHT * 2;
+static const uint32_t TIMER_REGION_BYTES = 170UL * TIMER_REGION_HEIGHT * 2;
+
+// Top page rows (menu_system.cpp TOP_ITEMS)
+enum { TOP_LEVEL, TOP_TIMER, TOP_DISPLAY, TOP_MIC, TOP_PROFILE, TOP_EXIT };
+
+// Last row (Back) of each submenu
+static const int LEVEL_BACK = 3;
+static const int TIMER_BACK = 5;
+static const int DISPLAY_BACK = 4;
+static const int MIC_BACK = 2;
+static const int PROFILE_BACK = 4;
+
+static RotaryEncoder encoder(0, 0);
+static int missingGolden;
+
+// Cost of the last frame on the bus
+struct FrameCost {
+    uint32_t bytes;       // commands + parameters + pixels
+    uint32_t pixelBytes;  // RAMWR payload only
+};
+
+// Main screen inputs, as loop() feeds them
+struct MainScreen {
+    LevelDisplayMode mode;
+    float angle;
+    uint16_t levelColor;
+    uint32_t remainingMs;
+    bool running;
+    float percent;
+    uint16_t timerColor;
+    const char* state;
+};
+
+static const MainScreen IDLE = {
+    LEVEL_DISPLAY_DEGREES, 0.0f, COLOR_GREEN, 60000, false, 1.0f, COLOR_GREEN, "Long press to ready"
+};
+
+static St7789Capture& panel() {
+    return display.getTFT()->capture();
+}
+
+static uint32_t regionHash(int y, int h) {
+    return panel().viewHash(0, y, panel().viewWidth(), h);
+}
+
+static uint32_t screenHash() {
+    return regionHash(0, panel().viewHeight());
+}
+
+static FrameCost costSince(const CaptureStats& before) {
+    const CaptureStats& now = panel().getStats();
+    FrameCost cost;
+    cost.pixelBytes = now.pixelBytes - before.pixelBytes;
+    cost.bytes = (now.commands - before.commands) + (now.paramBytes - before.paramBytes) + cost.pixelBytes;
+    return cost;
+}
+
+// Let everything queued reach the panel: render queue steps, then DMA tiles
+static void drain() {
+    renderQueue.flush();
+    for (int i = 0; i < 100000 && !display.service(); i++) {}
+    hostAdvanceMicros(16000);
+}
+
+// One main-screen frame of loop()
+static FrameCost drawMain(const MainScreen& s, const ShotLog* shots = nullptr) {
+    CaptureStats before = panel().getStats();
+    settings.levelDisplayMode = s.mode;
+    display.setLevel(s.angle, s.levelColor, 0.0f, micros());
+    display.setTimer(s.remainingMs, s.running, s.percent, s.timerColor, s.state);
+    display.setShots(shots);
+    display.present();
+    drain();
+    return costSince(before);
+}
+
+// Back on the main screen after the menu drew over the panel
+static FrameCost returnToMain(const MainScreen& s) {
+    display.invalidate();
+    return drawMain(s);
+}
+
+// One menu pass of loop(): repaint what the input changed, replay it
+static FrameCost menuFrame() {
+    CaptureStats before = panel().getStats();
+    menu.render();
+    drain();
+    return costSince(before);
+}
+
+static void press() {
+    menu.handleButton();
+}
+
+static void turn(int detents) {
+    encoder.setPosition(encoder.getPosition() + detents);
+    menu.handleRotation(detents);
+}
+
+// From the main screen into a submenu (its first row selected)
+static FrameCost openSubmenu(int topRow) {
+    press();
+    menuFrame();
+    turn(topRow);
+    menuFrame();
+    press();
+    return menuFrame();
+}
+
+// From a submenu with its first row selected back to the main screen
+static void closeSubmenu(int backRow, int topRow) {
+    turn(backRow);
+    press();
+    menuFrame();
+    turn(TOP_EXIT - topRow);
+    press();
+    menuFrame();
+    returnToMain(IDLE);
+}
+
+// The incremental frames left exactly what a full push shows
+static void assertMatchesFullPush() {
+    uint32_t incremental = screenHash();
+    display.invalidate();
+    display.present();
+    drain();
+    TEST_ASSERT_EQUAL_HEX32_MESSAGE(incremental, screenHash(), "tile diff missed a change");
+}
+
+// The rows a menu turn repainted match a full page redraw of the same state
+static void assertMatchesFullRedraw(int detents) {
+    uint32_t partial = screenHash();
+    menu.setFullRedraw(true);
+    turn(detents);
+    menuFrame();
+    turn(-detents);
+    menuFrame();
+    menu.setFullRedraw(false);
+    TEST_ASSERT_EQUAL_HEX32_MESSAGE(partial, screenHash(), "partial repaint differs from full redraw");
+}
+
+/**
+ * Compare a screen with its golden entry: same hash, and no more bytes
+ * than recorded (more is a redraw regression). Missing entries print
+ * their golden.h line; finishGolden() then ignores the test.
+ */
+static void checkGolden(const char* name, uint32_t hash, const FrameCost& cost) {
+    const ScreenGolden* golden = nullptr;
+#ifndef RECORD_GOLDEN
+    for (const ScreenGolden* g = SCREEN_GOLDEN; g->name; g++) {
+        if (strcmp(g->name, name) == 0) golden = g;
+    }
+#endif
+    if (!golden) {
+        printf("    {\"%s\", 0x%08lX, %lu},\n", name, (unsigned long)hash, (unsigned long)cost.bytes);
+        missingGolden++;
+        return;
+    }
+    TEST_ASSERT_EQUAL_HEX32_MESSAGE(golden->hash, hash, name);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32_MESSAGE(golden->bytes, cost.bytes, name);
+}
+
+static void finishGolden() {
+#ifndef RECORD_GOLDEN
+    if (missingGolden > 0) {
+        TEST_IGNORE_MESSAGE("golden values missing - add the lines printed above to golden.h");
+    }
+#endif
+}
+
+void setUp(void) {
+    missingGolden = 0;
+    settings.levelDisplayMode = LEVEL_DISPLAY_DEGREES;
+    settings.timerFineDigits = 1;
+    display.showPerfOverlay(false);
+}
+
+void tearDown(void) {
+}
+
+// ---------------------------------------------------------------------------
+// Main screen
+// ---------------------------------------------------------------------------
+
+void test_main_idle(void) {
+    FrameCost cost = returnToMain(IDLE);
+
+    // Both regions in full, then nothing: a repeated frame sends no byte
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(LEVEL_REGION_BYTES + TIMER_REGION_BYTES, cost.pixelBytes);
+    TEST_ASSERT_EQUAL_UINT32(0, drawMain(IDLE).bytes);
+    assertMatchesFullPush();
+
+    checkGolden("main_idle", screenHash(), cost);
+    finishGolden();
+}
+
+void test_level_change_leaves_timer_face(void) {
+    returnToMain(IDLE);
+    uint32_t timerFace = regionHash(TIMER_REGION_Y, TIMER_REGION_HEIGHT);
+
+    MainScreen tilted = IDLE;
+    tilted.angle = 3.4f;
+    tilted.levelColor = COLOR_RED;
+    FrameCost cost = drawMain(tilted);
+
+    TEST_ASSERT_EQUAL_HEX32(timerFace, regionHash(TIMER_REGION_Y, TIMER_REGION_HEIGHT));
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(LEVEL_REGION_BYTES, cost.pixelBytes);
+    assertMatchesFullPush();
+
+    checkGolden("main_tilted_red", screenHash(), cost);
+    finishGolden();
+}
+
+void test_arrow_mode(void) {
+    returnToMain(IDLE);
+    MainScreen arrow = IDLE;
+    arrow.mode = LEVEL_DISPLAY_ARROW;
+    arrow.angle = -1.2f;
+    arrow.levelColor = COLOR_YELLOW;
+    FrameCost cost = drawMain(arrow);
+
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(LEVEL_REGION_BYTES, cost.pixelBytes);
+    assertMatchesFullPush();
+
+    checkGolden("main_arrow", screenHash(), cost);
+    finishGolden();
+}
+
+void test_bubble_mode(void) {
+    returnToMain(IDLE);
+    MainScreen bubble = IDLE;
+    bubble.mode = LEVEL_DISPLAY_BUBBLE;
+    bubble.angle = 1.0f;
+    FrameCost cost = drawMain(bubble);
+    checkGolden("main_bubble", screenHash(), cost);
+
+    // A bubble step repaints the columns it left and entered, not the strip
+    uint32_t timerFace = regionHash(TIMER_REGION_Y, TIMER_REGION_HEIGHT);
+    bubble.angle = 1.3f;
+    FrameCost step = drawMain(bubble);
+    TEST_ASSERT_EQUAL_HEX32(timerFace, regionHash(TIMER_REGION_Y, TIMER_REGION_HEIGHT));
+    TEST_ASSERT_LESS_THAN_UINT32(LEVEL_REGION_BYTES / 4, step.pixelBytes);
+    assertMatchesFullPush();
+
+    checkGolden("main_bubble_step", screenHash(), step);
+    finishGolden();
+}
+
+void test_running_tick_pushes_only_the_timer_face(void) {
+    returnToMain(IDLE);
+    MainScreen running = IDLE;
+    running.running = true;
+    running.state = "RUNNING";
+    running.remainingMs = 42000;
+    running.percent = 0.7f;
+    drawMain(running);
+
+    uint32_t levelStrip = regionHash(0, LEVEL_REGION_HEIGHT);
+    running.remainingMs = 41000;
+    running.percent = 0.683f;
+    FrameCost tick = drawMain(running);
+
+    TEST_ASSERT_EQUAL_HEX32(levelStrip, regionHash(0, LEVEL_REGION_HEIGHT));
+    TEST_ASSERT_GREATER_THAN_UINT32(0, tick.pixelBytes);
+    TEST_ASSERT_LESS_THAN_UINT32(TIMER_REGION_BYTES / 2, tick.pixelBytes);
+    assertMatchesFullPush();
+
+    checkGolden("main_running_tick", screenHash(), tick);
+    finishGolden();
+}
+
+void test_fine_digits(void) {
+    returnToMain(IDLE);
+    settings.timerFineDigits = 2;
+    MainScreen running = IDLE;
+    running.running = true;
+    running.state = "RUNNING";
+    running.remainingMs = 7250;
+    running.percent = 0.121f;
+    running.timerColor = COLOR_RED;
+    FrameCost cost = drawMain(running);
+    assertMatchesFullPush();
+
+    checkGolden("main_fine_digits", screenHash(), cost);
+    finishGolden();
+}
+
+void test_finished(void) {
+    returnToMain(IDLE);
+    MainScreen finished = IDLE;
+    finished.remainingMs = 0;
+    finished.percent = 0.0f;
+    finished.timerColor = COLOR_RED;
+    finished.state = "TIME!";
+    FrameCost cost = drawMain(finished);
+    assertMatchesFullPush();
+
+    checkGolden("main_finished", screenHash(), cost);
+    finishGolden();
+}
+
+void test_shot_splits(void) {
+    returnToMain(IDLE);
+    ShotLog log;
+    log.beginStage(10);
+    log.record(1820000, SHOT_MIC);
+    log.record(2770000, SHOT_MIC);
+    log.record(3490000, SHOT_MIC);
+
+    MainScreen running = IDLE;
+    running.running = true;
+    running.state = "RUNNING";
+    running.remainingMs = 55000;
+    running.percent = 0.917f;
+    FrameCost cost = drawMain(running, &log);
+    assertMatchesFullPush();
+
+    checkGolden("main_shots", screenHash(), cost);
+    finishGolden();
+}
+
+void test_perf_overlay(void) {
+    returnToMain(IDLE);
+    uint32_t idle = screenHash();
+
+    display.showPerfOverlay(true);
+    display.setPerfLine(0, "frame 1.8ms  58fps");
+    display.setPerfLine(1, "spi 12.4KB/f");
+    display.setPerfLine(2, "block 0.9ms");
+    display.setPerfLine(3, "heap 182K");
+    FrameCost cost = drawMain(IDLE);
+    TEST_ASSERT_LESS_THAN_UINT32(TIMER_REGION_BYTES, cost.pixelBytes);
+    assertMatchesFullPush();
+    checkGolden("main_perf_overlay", screenHash(), cost);
+
+    // Turning it off leaves nothing behind
+    display.showPerfOverlay(false);
+    drawMain(IDLE);
+    TEST_ASSERT_EQUAL_HEX32(idle, screenHash());
+    finishGolden();
+}
+
+void test_shooter_ready(void) {
+    returnToMain(IDLE);
+    uint32_t idle = screenHash();
+
+    CaptureStats before = panel().getStats();
+    display.showShooterReady();
+    drain();
+    FrameCost cost = costSince(before);
+    uint32_t ready = screenHash();
+    TEST_ASSERT_EQUAL_HEX16(COLOR_YELLOW, panel().viewPixel(0, 0));
+
+    // The next frame pushes the intact canvases back
+    drawMain(IDLE);
+    TEST_ASSERT_EQUAL_HEX32(idle, screenHash());
+
+    checkGolden("shooter_ready", ready, cost);
+    finishGolden();
+}
+
+// ---------------------------------------------------------------------------
+// Menu
+// ---------------------------------------------------------------------------
+
+void test_menu_top(void) {
+    returnToMain(IDLE);
+    press();
+    FrameCost page = menuFrame();
+    TEST_ASSERT_EQUAL_INT(MENU_PAGE, menu.getState());
+    uint32_t pageHash = screenHash();
+
+    // A detent repaints the two rows it moved between
+    FrameCost row = menuFrame();
+    TEST_ASSERT_EQUAL_UINT32(0, row.bytes);
+    turn(1);
+    row = menuFrame();
+    TEST_ASSERT_GREATER_THAN_UINT32(0, row.pixelBytes);
+    TEST_ASSERT_LESS_THAN_UINT32(page.pixelBytes / 2, row.pixelBytes);
+    assertMatchesFullRedraw(1);
+    uint32_t rowHash = screenHash();
+
+    // Back on the first row it looks like the fresh page
+    turn(-1);
+    menuFrame();
+    TEST_ASSERT_EQUAL_HEX32(pageHash, screenHash());
+
+    turn(TOP_EXIT);
+    press();
+    menuFrame();
+    returnToMain(IDLE);
+
+    checkGolden("menu_top", pageHash, page);
+    checkGolden("menu_top_turn", rowHash, row);
+    finishGolden();
+}
+
+void test_menu_exit_restores_main(void) {
+    returnToMain(IDLE);
+    uint32_t idle = screenHash();
+
+    press();
+    menuFrame();
+    TEST_ASSERT_TRUE(screenHash() != idle);
+    turn(TOP_EXIT);
+    press();
+    menuFrame();
+    TEST_ASSERT_FALSE(menu.isInMenu());
+
+    returnToMain(IDLE);
+    TEST_ASSERT_EQUAL_HEX32(idle, screenHash());
+}
+
+void test_menu_level_page(void) {
+    returnToMain(IDLE);
+    FrameCost page = openSubmenu(TOP_LEVEL);
+    uint32_t pageHash = screenHash();
+
+    // Display mode row cycles degrees -> arrow -> bubble in place
+    turn(2);
+    menuFrame();
+    press();
+    FrameCost mode = menuFrame();
+    TEST_ASSERT_EQUAL_INT(LEVEL_DISPLAY_ARROW, settings.levelDisplayMode);
+    TEST_ASSERT_LESS_THAN_UINT32(page.pixelBytes / 2, mode.pixelBytes);
+    assertMatchesFullRedraw(1);
+    uint32_t modeHash = screenHash();
+    press();
+    menuFrame();
+    press();
+    menuFrame();
+    TEST_ASSERT_EQUAL_INT(LEVEL_DISPLAY_DEGREES, settings.levelDisplayMode);
+
+    turn(-2);
+    menuFrame();
+    closeSubmenu(LEVEL_BACK, TOP_LEVEL);
+
+    checkGolden("menu_level", pageHash, page);
+    checkGolden("menu_level_mode_arrow", modeHash, mode);
+    finishGolden();
+}
+
+void test_menu_timer_page(void) {
+    returnToMain(IDLE);
+    FrameCost page = openSubmenu(TOP_TIMER);
+    uint32_t pageHash = screenHash();
+    closeSubmenu(TIMER_BACK, TOP_TIMER);
+
+    checkGolden("menu_timer", pageHash, page);
+    finishGolden();
+}
+
+void test_menu_adjust_par(void) {
+    returnToMain(IDLE);
+    openSubmenu(TOP_TIMER);
+
+    // Par Time is the first row
+    press();
+    FrameCost adjust = menuFrame();
+    TEST_ASSERT_EQUAL_INT(ADJUSTING_VALUE, menu.getState());
+    uint32_t adjustHash = screenHash();
+
+    // A detent repaints the value box only
+    int par = settings.profile->parTimeSeconds;
+    turn(1);
+    FrameCost step = menuFrame();
+    TEST_ASSERT_TRUE(settings.profile->parTimeSeconds != par);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, step.pixelBytes);
+    TEST_ASSERT_LESS_THAN_UINT32(adjust.pixelBytes / 2, step.pixelBytes);
+    assertMatchesFullRedraw(1);
+    uint32_t stepHash = screenHash();
+
+    turn(-1);
+    menuFrame();
+    TEST_ASSERT_EQUAL_INT(par, settings.profile->parTimeSeconds);
+    TEST_ASSERT_EQUAL_HEX32(adjustHash, screenHash());
+    press();
+    menuFrame();
+    closeSubmenu(TIMER_BACK, TOP_TIMER);
+
+    checkGolden("menu_adjust_par", adjustHash, adjust);
+    checkGolden("menu_adjust_par_step", stepHash, step);
+    finishGolden();
+}
+
+void test_menu_display_page(void) {
+    returnToMain(IDLE);
+    FrameCost page = openSubmenu(TOP_DISPLAY);
+    uint32_t pageHash = screenHash();
+    closeSubmenu(DISPLAY_BACK, TOP_DISPLAY);
+
+    checkGolden("menu_display", pageHash, page);
+    finishGolden();
+}
+
+void test_menu_mic_page(void) {
+    returnToMain(IDLE);
+    FrameCost page = openSubmenu(TOP_MIC);
+    uint32_t pageHash = screenHash();
+    closeSubmenu(MIC_BACK, TOP_MIC);
+
+    checkGolden("menu_mic", pageHash, page);
+    finishGolden();
+}
+
+void test_menu_profile_page(void) {
+    returnToMain(IDLE);
+    // Opens on the active profile - the first one
+    FrameCost page = openSubmenu(TOP_PROFILE);
+    uint32_t pageHash = screenHash();
+    closeSubmenu(PROFILE_BACK, TOP_PROFILE);
+
+    checkGolden("menu_profile", pageHash, page);
+    finishGolden();
+}
+
+int main(int argc, char** argv) {
+    Serial.setQuiet(true);
+    hostSetMicros(1000000);
+    display.begin();
+    menu.begin(&renderQueue, &encoder);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_main_idle);
+    RUN_TEST(test_level_change_leaves_timer_face);
+    RUN_TEST(test_arrow_mode);
+    RUN_TEST(test_bubble_mode);
+    RUN_TEST(test_running_tick_pushes_only_the_timer_face);
+    RUN_TEST(test_fine_digits);
+    RUN_TEST(test_finished);
+    RUN_TEST(test_shot_splits);
+    RUN_TEST(test_perf_overlay);
+    RUN_TEST(test_shooter_ready);
+    RUN_TEST(test_menu_top);
+    RUN_TEST(test_menu_exit_restores_main);
+    RUN_TEST(test_menu_level_page);
+    RUN_TEST(test_menu_timer_page);
+    RUN_TEST(test_menu_adjust_par);
+    RUN_TEST(test_menu_display_page);
+    RUN_TEST(test_menu_mic_page);
+    RUN_TEST(test_menu_profile_page);
+    return UNITY_END();
+}
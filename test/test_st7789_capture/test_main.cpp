@@ -0,0 +1,159 @@
+#include <unity.h>
+#include "st7789_capture.h"
+
+// Same panel as the LGFX config: 170 columns from RAM column 35
+static const int VIEW_X = 35;
+static const int VIEW_W = 170;
+
+static St7789Capture* cap;
+
+static void send(uint8_t cmd, const uint8_t* params, uint32_t length) {
+    cap->command(cmd);
+    if (length) cap->data(params, length);
+}
+
+// CASET/RASET in view coordinates, as Panel_ST7789 sends them
+static void window(int x0, int y0, int x1, int y1) {
+    uint16_t c0 = x0 + VIEW_X, c1 = x1 + VIEW_X;
+    const uint8_t caset[] = {(uint8_t)(c0 >> 8), (uint8_t)c0, (uint8_t)(c1 >> 8), (uint8_t)c1};
+    const uint8_t raset[] = {(uint8_t)(y0 >> 8), (uint8_t)y0, (uint8_t)(y1 >> 8), (uint8_t)y1};
+    send(0x2A, caset, 4);
+    send(0x2B, raset, 4);
+}
+
+// RAMWR of count pixels of one colour (high byte first on the wire)
+static void fill(uint16_t color, uint32_t count) {
+    const uint8_t pixel[] = {(uint8_t)(color >> 8), (uint8_t)color};
+    cap->command(0x2C);
+    cap->dataRepeat(pixel, 2, count);
+}
+
+void setUp(void) {
+    cap = new St7789Capture(VIEW_X, VIEW_W);
+}
+
+void tearDown(void) {
+    delete cap;
+}
+
+void test_power_on_state(void) {
+    TEST_ASSERT_FALSE(cap->isSleeping());
+    TEST_ASSERT_TRUE(cap->isDisplayOn());
+    TEST_ASSERT_FALSE(cap->isPartialMode());
+    TEST_ASSERT_FALSE(cap->isIdleMode());
+    TEST_ASSERT_EQUAL_INT(VIEW_W, cap->viewWidth());
+    TEST_ASSERT_EQUAL_INT(320, cap->viewHeight());
+    TEST_ASSERT_EQUAL_HEX16(0, cap->viewPixel(0, 0));
+    TEST_ASSERT_EQUAL_HEX16(0, cap->viewPixel(VIEW_W - 1, 319));
+    TEST_ASSERT_EQUAL_UINT32(0, cap->totalBytes());
+}
+
+void test_window_write_lands_in_view_and_counts_bytes(void) {
+    window(10, 20, 19, 24);
+    fill(0xF800, 50);
+
+    // Exactly the 10x5 window, offset by the panel's first column
+    TEST_ASSERT_EQUAL_HEX16(0xF800, cap->viewPixel(10, 20));
+    TEST_ASSERT_EQUAL_HEX16(0xF800, cap->viewPixel(19, 24));
+    TEST_ASSERT_EQUAL_HEX16(0, cap->viewPixel(9, 20));
+    TEST_ASSERT_EQUAL_HEX16(0, cap->viewPixel(20, 20));
+    TEST_ASSERT_EQUAL_HEX16(0, cap->viewPixel(10, 25));
+
+    const CaptureStats& s = cap->getStats();
+    TEST_ASSERT_EQUAL_UINT32(3, s.commands);
+    TEST_ASSERT_EQUAL_UINT32(8, s.paramBytes);
+    TEST_ASSERT_EQUAL_UINT32(100, s.pixelBytes);
+    TEST_ASSERT_EQUAL_UINT32(50, s.pixels);
+    TEST_ASSERT_EQUAL_UINT32(1, s.windows);
+    TEST_ASSERT_EQUAL_UINT32(111, cap->totalBytes());
+
+    cap->resetStats();
+    TEST_ASSERT_EQUAL_UINT32(0, cap->totalBytes());
+    // Counters only - the picture stays
+    TEST_ASSERT_EQUAL_HEX16(0xF800, cap->viewPixel(15, 22));
+}
+
+void test_write_continues_and_wraps_in_the_window(void) {
+    window(0, 0, 3, 1);
+    // Row 0 red, then RAMWRC continues on row 1 in green
+    fill(0xF800, 4);
+    const uint8_t green[] = {0x07, 0xE0};
+    cap->command(0x3C);
+    cap->dataRepeat(green, 2, 4);
+    TEST_ASSERT_EQUAL_HEX16(0xF800, cap->viewPixel(3, 0));
+    TEST_ASSERT_EQUAL_HEX16(0x07E0, cap->viewPixel(0, 1));
+    TEST_ASSERT_EQUAL_HEX16(0x07E0, cap->viewPixel(3, 1));
+    TEST_ASSERT_EQUAL_UINT32(1, cap->getStats().windows);
+
+    // Past the end of the window the pointer wraps to its origin
+    fill(0x001F, 9);
+    TEST_ASSERT_EQUAL_HEX16(0x001F, cap->viewPixel(0, 0));
+    TEST_ASSERT_EQUAL_HEX16(0x001F, cap->viewPixel(3, 1));
+    TEST_ASSERT_EQUAL_HEX16(0, cap->viewPixel(4, 0));
+}
+
+void test_vertical_scroll_maps_view_rows(void) {
+    // Fixed top 10 rows, scroll area 300, fixed bottom 10
+    const uint8_t vscrdef[] = {0, 10, 0x01, 0x2C, 0, 10};
+    send(0x33, vscrdef, 6);
+
+    // Mark RAM rows 9, 10 and 11
+    window(0, 9, 0, 9);
+    fill(0x1111, 1);
+    window(0, 10, 0, 10);
+    fill(0x2222, 1);
+    window(0, 11, 0, 11);
+    fill(0x3333, 1);
+
+    // Scroll start one row in: view row 10 shows RAM row 11, the last
+    // scroll row wraps to RAM row 10, fixed rows stay put
+    const uint8_t vscsad[] = {0, 11};
+    send(0x37, vscsad, 2);
+    TEST_ASSERT_EQUAL_HEX16(0x1111, cap->viewPixel(0, 9));
+    TEST_ASSERT_EQUAL_HEX16(0x3333, cap->viewPixel(0, 10));
+    TEST_ASSERT_EQUAL_HEX16(0x2222, cap->viewPixel(0, 309));
+}
+
+void test_sleep_and_display_off_blank_the_view(void) {
+    window(0, 0, VIEW_W - 1, 319);
+    fill(0xFFFF, VIEW_W * 320);
+
+    cap->command(0x28);
+    TEST_ASSERT_FALSE(cap->isDisplayOn());
+    TEST_ASSERT_EQUAL_HEX16(0, cap->viewPixel(50, 50));
+    cap->command(0x29);
+    TEST_ASSERT_EQUAL_HEX16(0xFFFF, cap->viewPixel(50, 50));
+
+    cap->command(0x10);
+    TEST_ASSERT_TRUE(cap->isSleeping());
+    TEST_ASSERT_EQUAL_HEX16(0, cap->viewPixel(50, 50));
+    cap->command(0x11);
+    TEST_ASSERT_EQUAL_HEX16(0xFFFF, cap->viewPixel(50, 50));
+}
+
+void test_view_hash_tells_screens_apart(void) {
+    uint32_t blank = cap->viewHash(0, 0, VIEW_W, 320);
+
+    window(100, 200, 100, 200);
+    fill(0x0001, 1);
+    uint32_t onePixel = cap->viewHash(0, 0, VIEW_W, 320);
+    TEST_ASSERT_TRUE(onePixel != blank);
+    // A rect away from the change keeps its value
+    TEST_ASSERT_EQUAL_HEX32(cap->viewHash(0, 0, VIEW_W, 100),
+                            St7789Capture(VIEW_X, VIEW_W).viewHash(0, 0, VIEW_W, 100));
+
+    // Same pixels, same hash; reset brings the blank screen back
+    cap->reset();
+    TEST_ASSERT_EQUAL_HEX32(blank, cap->viewHash(0, 0, VIEW_W, 320));
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_power_on_state);
+    RUN_TEST(test_window_write_lands_in_view_and_counts_bytes);
+    RUN_TEST(test_write_continues_and_wraps_in_the_window);
+    RUN_TEST(test_vertical_scroll_maps_view_rows);
+    RUN_TEST(test_sleep_and_display_off_blank_the_view);
+    RUN_TEST(test_view_hash_tells_screens_apart);
+    return UNITY_END();
+}
@@ -0,0 +1,157 @@
+#include <unity.h>
+#include <Arduino.h>
+#include "display_manager.h"
+#include "render_queue.h"
+
+// Standby through the real DisplayManager: setStandby() and present() on
+// LovyanGFX, the panel on Bus_Capture
+
+static St7789Capture& panel() {
+    return display.getTFT()->capture();
+}
+
+static uint32_t rowsHash(int y0, int y1) {
+    return panel().viewHash(0, y0, panel().viewWidth(), y1 - y0);
+}
+
+static bool rowsDark(int y0, int y1) {
+    for (int y = y0; y < y1; y++) {
+        for (int x = 0; x < panel().viewWidth(); x++) {
+            if (panel().viewPixel(x, y) != 0) return false;
+        }
+    }
+    return true;
+}
+
+static bool rectHasColor(int x0, int y0, int w, int h, uint16_t color) {
+    for (int y = y0; y < y0 + h; y++) {
+        for (int x = x0; x < x0 + w; x++) {
+            if (panel().viewPixel(x, y) == color) return true;
+        }
+    }
+    return false;
+}
+
+// Let queued tiles reach the panel
+static void drain() {
+    renderQueue.flush();
+    for (int i = 0; i < 100000 && !display.service(); i++) {}
+    hostAdvanceMicros(16000);
+}
+
+// One main-screen frame of loop(), idle countdown at 'remainingMs'
+static void frame(float angle, uint16_t levelColor, uint32_t remainingMs) {
+    display.setLevel(angle, levelColor, 0.0f, micros());
+    display.setTimer(remainingMs, false, remainingMs / 60000.0f, COLOR_GREEN, "Long press to ready");
+    display.setShots(nullptr);
+    display.present();
+    drain();
+}
+
+// The standby state label (DisplayManager stateLabel) in view rows
+static const int LABEL_Y = TIMER_REGION_Y + 10;
+static const int LABEL_H = 8;
+
+void setUp(void) {
+    display.setStandby(false);
+    display.invalidate();
+    frame(0.0f, COLOR_GREEN, 60000);
+}
+
+void tearDown(void) {
+}
+
+void test_enter_lights_only_the_top_rows_in_eight_colours(void) {
+    display.setStandby(true);
+    drain();
+
+    TEST_ASSERT_TRUE(display.isStandby());
+    TEST_ASSERT_TRUE(panel().isPartialMode());
+    TEST_ASSERT_TRUE(panel().isIdleMode());
+
+    // Level strip and timer face lit, everything from STANDBY_ROWS down dark
+    TEST_ASSERT_FALSE(rowsDark(0, LEVEL_REGION_HEIGHT));
+    TEST_ASSERT_FALSE(rowsDark(TIMER_REGION_Y + 50, DisplayManager::STANDBY_ROWS));
+    TEST_ASSERT_TRUE(rowsDark(DisplayManager::STANDBY_ROWS, panel().viewHeight()));
+
+    // The label was repainted in white before freezing - dark grey has no
+    // colour MSBs and would vanish in idle mode
+    TEST_ASSERT_TRUE(rectHasColor(10, LABEL_Y, 150, LABEL_H, COLOR_WHITE));
+}
+
+void test_level_strip_stays_live_timer_face_frozen(void) {
+    display.setStandby(true);
+    drain();
+    uint32_t level = rowsHash(0, LEVEL_REGION_HEIGHT);
+    uint32_t face = rowsHash(TIMER_REGION_Y, DisplayManager::STANDBY_ROWS);
+
+    CaptureStats before = panel().getStats();
+    frame(3.4f, COLOR_RED, 42000);
+    uint32_t pixelBytes = panel().getStats().pixelBytes - before.pixelBytes;
+
+    TEST_ASSERT_TRUE(rowsHash(0, LEVEL_REGION_HEIGHT) != level);
+    TEST_ASSERT_EQUAL_HEX32(face, rowsHash(TIMER_REGION_Y, DisplayManager::STANDBY_ROWS));
+    // Only the level region went out
+    TEST_ASSERT_GREATER_THAN_UINT32(0, pixelBytes);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(170UL * LEVEL_REGION_HEIGHT * 2, pixelBytes);
+}
+
+void test_leave_restores_the_panel_from_controller_ram(void) {
+    uint32_t below = rowsHash(DisplayManager::STANDBY_ROWS, panel().viewHeight());
+    uint32_t whole = rowsHash(0, panel().viewHeight());
+    display.setStandby(true);
+    drain();
+
+    CaptureStats before = panel().getStats();
+    display.setStandby(false);
+    const CaptureStats& after = panel().getStats();
+
+    TEST_ASSERT_FALSE(panel().isPartialMode());
+    TEST_ASSERT_FALSE(panel().isIdleMode());
+    // IDMOFF and NORON, no pixels: the rows that were dark come back as
+    // they were, in full colour
+    TEST_ASSERT_EQUAL_UINT32(2, after.commands - before.commands);
+    TEST_ASSERT_EQUAL_UINT32(0, after.pixelBytes - before.pixelBytes);
+    TEST_ASSERT_EQUAL_HEX32(below, rowsHash(DisplayManager::STANDBY_ROWS, panel().viewHeight()));
+
+    // The next frame puts the state label back - the screen as it was
+    frame(0.0f, COLOR_GREEN, 60000);
+    TEST_ASSERT_EQUAL_HEX32(whole, rowsHash(0, panel().viewHeight()));
+}
+
+void test_timer_face_catches_up_after_leaving(void) {
+    frame(0.0f, COLOR_GREEN, 42000);
+    uint32_t expected = rowsHash(0, panel().viewHeight());
+    uint32_t expectedFace = rowsHash(TIMER_REGION_Y, DisplayManager::STANDBY_ROWS);
+    frame(0.0f, COLOR_GREEN, 60000);
+
+    display.setStandby(true);
+    drain();
+    frame(0.0f, COLOR_GREEN, 42000);
+    display.setStandby(false);
+
+    // Full colour again, the face still shows the time standby froze
+    TEST_ASSERT_TRUE(rowsHash(TIMER_REGION_Y, DisplayManager::STANDBY_ROWS) != expectedFace);
+
+    // One frame later the panel is what it would be without standby
+    frame(0.0f, COLOR_GREEN, 42000);
+    TEST_ASSERT_EQUAL_HEX32(expected, rowsHash(0, panel().viewHeight()));
+
+    // And standby can be entered again
+    display.setStandby(true);
+    drain();
+    TEST_ASSERT_TRUE(rowsDark(DisplayManager::STANDBY_ROWS, panel().viewHeight()));
+}
+
+int main(int argc, char** argv) {
+    Serial.setQuiet(true);
+    hostSetMicros(1000000);
+    display.begin();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_enter_lights_only_the_top_rows_in_eight_colours);
+    RUN_TEST(test_level_strip_stays_live_timer_face_frozen);
+    RUN_TEST(test_leave_restores_the_panel_from_controller_ram);
+    RUN_TEST(test_timer_face_catches_up_after_leaving);
+    return UNITY_END();
+}
@@ -0,0 +1,237 @@
+#include <unity.h>
+#include "timer_wheel.h"
+
+// Virtual clock: the wheel only ever sees the times passed to advance()
+static uint32_t nowMs;
+
+struct Fired {
+    int id;
+    uint32_t atMs;
+};
+
+static Fired fired[64];
+static int firedCount;
+
+// Job that records when it ran; id is the job's index in the test
+struct Probe {
+    int id;
+    WheelJob job;
+    WheelJob* cancelOther;  // cancelled from inside this job's callback
+
+    static void onFire(void* arg) {
+        Probe* p = static_cast<Probe*>(arg);
+        if (firedCount < 64) {
+            fired[firedCount].id = p->id;
+            fired[firedCount].atMs = nowMs;
+            firedCount++;
+        }
+        if (p->cancelOther) {
+            scheduler.cancel(*p->cancelOther);
+        }
+    }
+
+    Probe() : id(0), job(onFire, this), cancelOther(nullptr) {}
+};
+
+// Step the clock one millisecond at a time, like a loop() that never stalls
+static void runUntil(uint32_t endMs) {
+    while ((int32_t)(endMs - nowMs) > 0) {
+        nowMs++;
+        scheduler.advance(nowMs);
+    }
+}
+
+void setUp(void) {
+    nowMs = 0;
+    firedCount = 0;
+}
+
+void tearDown(void) {}
+
+void test_one_shots_fire_in_deadline_order_across_all_levels(void) {
+    // Level 0 under 64 ms, level 1 under 4 s, level 2 under 4.4 min, level 3 beyond
+    static const uint32_t delays[] = {
+        300000, 37, 4095, 64, 262144, 4096, 1, 63, 262143, 200000, 5000, 4097
+    };
+    const int count = sizeof(delays) / sizeof(delays[0]);
+    Probe probes[count];
+
+    nowMs = 1000;
+    scheduler.begin(nowMs);
+    // Inserted out of order on purpose
+    for (int i = 0; i < count; i++) {
+        probes[i].id = i;
+        scheduler.schedule(probes[i].job, delays[i]);
+    }
+    TEST_ASSERT_EQUAL_INT(count, scheduler.getPending());
+
+    runUntil(1000 + 300001);
+
+    TEST_ASSERT_EQUAL_INT(count, firedCount);
+    TEST_ASSERT_EQUAL_INT(0, scheduler.getPending());
+    for (int i = 0; i < count; i++) {
+        // Each job exactly on its deadline (no jitter when advanced every tick)
+        TEST_ASSERT_EQUAL_UINT32(1000 + delays[fired[i].id], fired[i].atMs);
+        if (i > 0) {
+            TEST_ASSERT_LESS_OR_EQUAL_UINT32(fired[i].atMs, fired[i - 1].atMs);
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, scheduler.getMaxLatenessMs());
+}
+
+void test_late_advance_runs_overdue_jobs_in_order(void) {
+    Probe a, b, c;
+    a.id = 0;
+    b.id = 1;
+    c.id = 2;
+
+    scheduler.begin(nowMs);
+    scheduler.schedule(c.job, 70000);
+    scheduler.schedule(a.job, 10);
+    scheduler.schedule(b.job, 500);
+
+    // One big jump, as after a long blocking call
+    nowMs = 80000;
+    TEST_ASSERT_EQUAL_INT(3, scheduler.advance(nowMs));
+    TEST_ASSERT_EQUAL_INT(3, firedCount);
+    TEST_ASSERT_EQUAL_INT(0, fired[0].id);
+    TEST_ASSERT_EQUAL_INT(1, fired[1].id);
+    TEST_ASSERT_EQUAL_INT(2, fired[2].id);
+    TEST_ASSERT_EQUAL_UINT32(80000 - 10, scheduler.getMaxLatenessMs());
+}
+
+void test_periodic_job_rearms_on_its_grid(void) {
+    Probe p;
+    scheduler.begin(nowMs);
+    scheduler.schedule(p.job, 7, 7);
+
+    runUntil(7 * 5);
+    TEST_ASSERT_EQUAL_INT(5, firedCount);
+    for (int i = 0; i < 5; i++) {
+        TEST_ASSERT_EQUAL_UINT32(7 * (i + 1), fired[i].atMs);
+    }
+    TEST_ASSERT_TRUE(p.job.isPending());
+    TEST_ASSERT_EQUAL_UINT32(42, p.job.getExpiresMs());
+
+    // Stall past three deadlines: runs once, drops the rest, keeps the grid
+    nowMs = 60;
+    scheduler.advance(nowMs);
+    TEST_ASSERT_EQUAL_INT(6, firedCount);
+    TEST_ASSERT_EQUAL_UINT32(2, scheduler.getMissedPeriods());
+    TEST_ASSERT_EQUAL_UINT32(63, p.job.getExpiresMs());
+
+    runUntil(63);
+    TEST_ASSERT_EQUAL_INT(7, firedCount);
+    TEST_ASSERT_EQUAL_UINT32(63, fired[6].atMs);
+
+    // Probes live on the stack - nothing may stay linked past the test
+    scheduler.cancel(p.job);
+}
+
+void test_cancel_during_dispatch(void) {
+    Probe first, second, self;
+    first.id = 0;
+    second.id = 1;
+    self.id = 2;
+
+    scheduler.begin(nowMs);
+    // Same tick: linked head-first, so the job scheduled last runs first
+    // and cancels the other one off the running list
+    scheduler.schedule(first.job, 20);
+    scheduler.schedule(second.job, 20);
+    second.cancelOther = &first.job;
+    // A periodic job that cancels itself is not re-armed
+    self.cancelOther = &self.job;
+    scheduler.schedule(self.job, 30, 10);
+
+    runUntil(100);
+
+    TEST_ASSERT_EQUAL_INT(2, firedCount);
+    TEST_ASSERT_EQUAL_INT(1, fired[0].id);
+    TEST_ASSERT_EQUAL_UINT32(20, fired[0].atMs);
+    TEST_ASSERT_EQUAL_INT(2, fired[1].id);
+    TEST_ASSERT_EQUAL_UINT32(30, fired[1].atMs);
+    TEST_ASSERT_FALSE(first.job.isPending());
+    TEST_ASSERT_FALSE(self.job.isPending());
+    TEST_ASSERT_EQUAL_INT(0, scheduler.getPending());
+
+    // The cancelled job is clean and can be armed again
+    scheduler.schedule(first.job, 5);
+    TEST_ASSERT_EQUAL_INT(1, scheduler.getPending());
+    runUntil(110);
+    TEST_ASSERT_EQUAL_INT(3, firedCount);
+    TEST_ASSERT_EQUAL_INT(0, fired[2].id);
+    TEST_ASSERT_EQUAL_UINT32(105, fired[2].atMs);
+    TEST_ASSERT_EQUAL_INT(0, scheduler.getPending());
+}
+
+void test_millis_wraparound(void) {
+    Probe near, far, periodic;
+    near.id = 0;
+    far.id = 1;
+    periodic.id = 2;
+
+    nowMs = 0xFFFFFF00UL;
+    scheduler.begin(nowMs);
+    scheduler.schedule(near.job, 0x200);        // level 1, past the wrap
+    scheduler.schedule(far.job, 300000);        // level 3, past the wrap
+    scheduler.schedule(periodic.job, 100, 100);
+
+    uint32_t delayMs = 0;
+    TEST_ASSERT_TRUE(scheduler.nextDeadline(nowMs, delayMs));
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(100, delayMs);
+
+    runUntil(0x00000100UL);
+    // Periodic every 100 ms from -0x100, then the level 1 job on 0x100
+    TEST_ASSERT_EQUAL_INT(6, firedCount);
+    TEST_ASSERT_EQUAL_UINT32(0xFFFFFF64UL, fired[0].atMs);
+    TEST_ASSERT_EQUAL_UINT32(0xFFFFFFC8UL, fired[1].atMs);
+    TEST_ASSERT_EQUAL_UINT32(0x0000002CUL, fired[2].atMs);
+    TEST_ASSERT_EQUAL_UINT32(0x00000090UL, fired[3].atMs);
+    TEST_ASSERT_EQUAL_UINT32(0x000000F4UL, fired[4].atMs);
+    TEST_ASSERT_EQUAL_INT(0, fired[5].id);
+    TEST_ASSERT_EQUAL_UINT32(0x00000100UL, fired[5].atMs);
+
+    scheduler.cancel(periodic.job);
+    runUntil((uint32_t)(0xFFFFFF00UL + 300000));
+    TEST_ASSERT_EQUAL_INT(7, firedCount);
+    TEST_ASSERT_EQUAL_INT(1, fired[6].id);
+    TEST_ASSERT_EQUAL_UINT32((uint32_t)(0xFFFFFF00UL + 300000), fired[6].atMs);
+    TEST_ASSERT_EQUAL_UINT32(0, scheduler.getMaxLatenessMs());
+}
+
+void test_begin_drops_linked_jobs(void) {
+    Probe a, b;
+    a.id = 0;
+    b.id = 1;
+
+    scheduler.begin(nowMs);
+    scheduler.schedule(a.job, 50);
+    scheduler.schedule(b.job, 5000);
+
+    // Restart with both still linked (e.g. a static job armed before setup())
+    scheduler.begin(nowMs);
+    TEST_ASSERT_EQUAL_INT(0, scheduler.getPending());
+    TEST_ASSERT_FALSE(a.job.isPending());
+    TEST_ASSERT_FALSE(b.job.isPending());
+
+    scheduler.schedule(b.job, 10);
+    scheduler.cancel(a.job);
+    TEST_ASSERT_EQUAL_INT(1, scheduler.getPending());
+
+    runUntil(6000);
+    TEST_ASSERT_EQUAL_INT(1, firedCount);
+    TEST_ASSERT_EQUAL_INT(1, fired[0].id);
+    TEST_ASSERT_EQUAL_UINT32(10, fired[0].atMs);
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_one_shots_fire_in_deadline_order_across_all_levels);
+    RUN_TEST(test_late_advance_runs_overdue_jobs_in_order);
+    RUN_TEST(test_periodic_job_rearms_on_its_grid);
+    RUN_TEST(test_cancel_during_dispatch);
+    RUN_TEST(test_millis_wraparound);
+    RUN_TEST(test_begin_drops_linked_jobs);
+    return UNITY_END();
+}
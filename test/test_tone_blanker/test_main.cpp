@@ -0,0 +1,202 @@
+#include <unity.h>
+#include <math.h>
+#include "tone_blanker.h"
+
+// Same front end as MicDetector: 16 kHz blocks of 512, beep bins every
+// 100 Hz from 1400 to 2300 Hz, shot onset at half full scale
+static const float SAMPLE_RATE = 16000.0f;
+static const int BLOCK_SIZE = 512;
+static const int BINS = 10;
+static const float SHOT_LEVEL = 0.5f;
+static const uint32_t RING_DOWN_US = 30000;
+static const float HALF_WIDTH_HZ = 150.0f;
+
+// Block recorded from t = 1 s, 32 ms long
+static const int64_t BLOCK_FROM_US = 1000000;
+static const int64_t BLOCK_TO_US = BLOCK_FROM_US + (int64_t)(BLOCK_SIZE * 1000000.0f / SAMPLE_RATE);
+
+static float binHz[BINS];
+static float block[BLOCK_SIZE];
+static ToneBlanker blanker;
+
+// Our buzzer: harmonics 1..5 at 1/k, loud enough on its own to cross the shot level
+static void addBuzzer(float* samples, float frequency, float amplitude) {
+    for (int i = 0; i < BLOCK_SIZE; i++) {
+        float t = i / SAMPLE_RATE;
+        float v = 0;
+        for (int k = 1; k <= 5; k++) {
+            v += sinf(2.0f * (float)M_PI * frequency * k * t) / k;
+        }
+        samples[i] += amplitude * v;
+    }
+}
+
+// Plain tone, e.g. the start beep of another timer on the line
+static void addTone(float* samples, float frequency, float amplitude) {
+    for (int i = 0; i < BLOCK_SIZE; i++) {
+        samples[i] += amplitude * sinf(2.0f * (float)M_PI * frequency * i / SAMPLE_RATE);
+    }
+}
+
+// Report: near-saturating positive pressure step that decays over ~2 ms,
+// with broadband noise on top (fixed seed, reproducible)
+static void addShot(float* samples, int onset) {
+    uint32_t seed = 12345;
+    for (int i = onset; i < BLOCK_SIZE; i++) {
+        seed = seed * 1664525UL + 1013904223UL;
+        float noise = ((seed >> 8) & 0xFFFF) / 32768.0f - 1.0f;
+        float envelope = expf(-(i - onset) / 32.0f);
+        samples[i] += envelope * (0.9f + 0.1f * noise);
+    }
+}
+
+// Goertzel magnitude of one bin, normalised so a full-scale sine reads ~1
+static float goertzel(const float* samples, int count, float frequency) {
+    float coeff = 2.0f * cosf(2.0f * (float)M_PI * frequency / SAMPLE_RATE);
+    float q1 = 0, q2 = 0;
+    for (int i = 0; i < count; i++) {
+        float q0 = coeff * q1 - q2 + samples[i];
+        q2 = q1;
+        q1 = q0;
+    }
+    float power = q1 * q1 + q2 * q2 - coeff * q1 * q2;
+    return 2.0f * sqrtf(power > 0 ? power : 0) / count;
+}
+
+// Peak over the bins not blanked, as MicDetector::processMultiFrequency
+static float peakMagnitude(const float* samples, uint32_t blankMask, int* peakBin) {
+    float peak = 0;
+    *peakBin = -1;
+    for (int b = 0; b < BINS; b++) {
+        if (blankMask & (1UL << b)) continue;
+        float m = goertzel(samples, BLOCK_SIZE, binHz[b]);
+        if (m > peak) {
+            peak = m;
+            *peakBin = b;
+        }
+    }
+    return peak;
+}
+
+// Shot path of MicDetector::updateShots: notch our tones, then find the
+// first sample over the shot level after the notch transient
+static int shotOnset(float* samples, int64_t fromUs, int64_t toUs) {
+    uint16_t tones[ToneBlanker::MAX_TONES];
+    int count = blanker.activeTones(fromUs, toUs, tones, ToneBlanker::MAX_TONES);
+    int first = 0;
+    for (int t = 0; t < count; t++) {
+        int settle = ToneBlanker::notch(samples, BLOCK_SIZE, tones[t], SAMPLE_RATE);
+        if (settle > first) first = settle;
+    }
+    for (int i = first; i < BLOCK_SIZE; i++) {
+        if (fabsf(samples[i]) >= SHOT_LEVEL) return i;
+    }
+    return -1;
+}
+
+void setUp(void) {
+    for (int b = 0; b < BINS; b++) {
+        binHz[b] = 1400.0f + 100.0f * b;
+    }
+    for (int i = 0; i < BLOCK_SIZE; i++) {
+        block[i] = 0;
+    }
+    blanker.clear();
+    blanker.configure(RING_DOWN_US, HALF_WIDTH_HZ);
+}
+
+void tearDown(void) {}
+
+void test_bin_mask_covers_tone_harmonics_and_ring_down(void) {
+    // Yellow warning tone: bins 1400-1600 Hz
+    blanker.addTone(BLOCK_FROM_US + 5000, BLOCK_FROM_US + 105000, 1500);
+    TEST_ASSERT_EQUAL_HEX32(0x007, blanker.binMask(BLOCK_FROM_US, BLOCK_TO_US, binHz, BINS));
+
+    // Finish alarm: 800 Hz is below the bins, its 2nd and 3rd harmonics are not
+    blanker.clear();
+    blanker.addTone(BLOCK_FROM_US, BLOCK_FROM_US + 1000000, 800);
+    TEST_ASSERT_EQUAL_HEX32(0x20E, blanker.binMask(BLOCK_FROM_US, BLOCK_TO_US, binHz, BINS));
+
+    // Still blanked during the ring-down, free after it
+    blanker.clear();
+    blanker.addTone(0, BLOCK_FROM_US - 29000, 1500);
+    TEST_ASSERT_EQUAL_HEX32(0x007, blanker.binMask(BLOCK_FROM_US, BLOCK_TO_US, binHz, BINS));
+    blanker.clear();
+    blanker.addTone(0, BLOCK_FROM_US - 31000, 1500);
+    TEST_ASSERT_EQUAL_HEX32(0, blanker.binMask(BLOCK_FROM_US, BLOCK_TO_US, binHz, BINS));
+}
+
+void test_own_beep_rejected_other_beep_still_heard(void) {
+    int peakBin;
+    blanker.addTone(BLOCK_FROM_US - 10000, BLOCK_TO_US + 50000, 1500);
+    uint32_t mask = blanker.binMask(BLOCK_FROM_US, BLOCK_TO_US, binHz, BINS);
+
+    // Our own beep alone: loud unblanked, nothing left once blanked
+    addBuzzer(block, 1500, 0.4f);
+    float unblanked = peakMagnitude(block, 0, &peakBin);
+    TEST_ASSERT_EQUAL_INT(1, peakBin);
+    TEST_ASSERT_GREATER_THAN(0.3f, unblanked);
+    float blanked = peakMagnitude(block, mask, &peakBin);
+    TEST_ASSERT_LESS_THAN(unblanked * 0.05f, blanked);
+
+    // A quieter start beep from another timer at 2100 Hz under ours
+    addTone(block, 2100, 0.1f);
+    float heard = peakMagnitude(block, mask, &peakBin);
+    TEST_ASSERT_EQUAL_INT(7, peakBin);
+    TEST_ASSERT_FLOAT_WITHIN(0.02f, 0.1f, heard);
+}
+
+void test_beep_alone_is_not_a_shot(void) {
+    addBuzzer(block, 1500, 0.4f);
+    // The raw beep crosses the shot level - without the notch it would count
+    float raw[BLOCK_SIZE];
+    for (int i = 0; i < BLOCK_SIZE; i++) {
+        raw[i] = block[i];
+    }
+    int rawOnset = -1;
+    for (int i = 0; i < BLOCK_SIZE && rawOnset < 0; i++) {
+        if (fabsf(raw[i]) >= SHOT_LEVEL) rawOnset = i;
+    }
+    TEST_ASSERT_TRUE(rawOnset >= 0);
+
+    blanker.addTone(BLOCK_FROM_US - 10000, BLOCK_TO_US + 50000, 1500);
+    TEST_ASSERT_EQUAL_INT(-1, shotOnset(block, BLOCK_FROM_US, BLOCK_TO_US));
+}
+
+void test_shot_under_beep_still_detected(void) {
+    static const int SHOT_AT = 300;
+    static const uint16_t OWN_TONES[] = {1500, 1200, 2000, 800};
+
+    for (unsigned t = 0; t < sizeof(OWN_TONES) / sizeof(OWN_TONES[0]); t++) {
+        for (int i = 0; i < BLOCK_SIZE; i++) {
+            block[i] = 0;
+        }
+        blanker.clear();
+        blanker.addTone(BLOCK_FROM_US - 10000, BLOCK_TO_US + 50000, OWN_TONES[t]);
+
+        addBuzzer(block, OWN_TONES[t], 0.4f);
+        addShot(block, SHOT_AT);
+
+        // Onset within 0.5 ms of the true one (splits show 0.01 s); the
+        // notches shave the first samples, most for the 800 Hz alarm
+        int onset = shotOnset(block, BLOCK_FROM_US, BLOCK_TO_US);
+        TEST_ASSERT_TRUE_MESSAGE(onset >= SHOT_AT, "shot lost or early under own tone");
+        TEST_ASSERT_LESS_OR_EQUAL(SHOT_AT + 8, onset);
+    }
+}
+
+void test_shot_without_tones_passes_untouched(void) {
+    addShot(block, 100);
+    // No tones reported: nothing is notched, onset on the exact sample
+    TEST_ASSERT_EQUAL_INT(100, shotOnset(block, BLOCK_FROM_US, BLOCK_TO_US));
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_bin_mask_covers_tone_harmonics_and_ring_down);
+    RUN_TEST(test_own_beep_rejected_other_beep_still_heard);
+    RUN_TEST(test_beep_alone_is_not_a_shot);
+    RUN_TEST(test_shot_under_beep_still_detected);
+    RUN_TEST(test_shot_without_tones_passes_untouched);
+    return UNITY_END();
+}
@@ -0,0 +1,246 @@
+#!/usr/bin/env python3
+"""
+Convert the images in assets/ into run-length encoded C++ assets.
+
+Sources listed in assets/manifest.txt are read (XBM, PBM or PPM - no
+third-party modules needed), reduced to a palette of at most 16 colours
+and written to include/assets.h as constexpr data for drawRleAsset().
+
+Encoding, one token per run, pixels in row-major order:
+    byte  iiii nnnn   palette index i, run length n + 1 (1..15)
+    n == 15           run length is 16 + the next byte (16..271)
+
+Runs continue across row ends, so the decoder can stream a whole asset
+into one address window.
+
+Runs as a PlatformIO pre-build script (extra_scripts) and only rewrites
+the header when its content changes. Can also be run by hand:
+    python3 tools/build_assets.py
+"""
+
+import os
+import re
+import sys
+
+MAX_COLORS = 16
+SHORT_RUN_MAX = 15          # n < 15: run = n + 1
+LONG_RUN_BASE = 16
+LONG_RUN_MAX = LONG_RUN_BASE + 255
+
+
+# ---------------------------------------------------------------- readers
+
+def read_xbm(path):
+    text = open(path).read()
+    width = int(re.search(r"_width\s+(\d+)", text).group(1))
+    height = int(re.search(r"_height\s+(\d+)", text).group(1))
+    body = text[text.index("{") + 1:text.rindex("}")]
+    data = [int(v, 16) for v in re.findall(r"0x[0-9A-Fa-f]+", body)]
+
+    stride = (width + 7) // 8
+    pixels = []
+    for y in range(height):
+        for x in range(width):
+            bit = (data[y * stride + x // 8] >> (x % 8)) & 1
+            pixels.append(bit)
+    # 1-bit sources: index 0 background, 1 foreground (caller picks colours)
+    return width, height, pixels, [0x0000, 0xFFFF]
+
+
+def _netpbm_tokens(data, count, start):
+    """Read count whitespace separated header tokens, skipping comments."""
+    tokens = []
+    pos = start
+    while len(tokens) < count:
+        while data[pos:pos + 1].isspace():
+            pos += 1
+        if data[pos:pos + 1] == b"#":
+            while data[pos:pos + 1] not in (b"\n", b""):
+                pos += 1
+            continue
+        end = pos
+        while end < len(data) and not data[end:end + 1].isspace():
+            end += 1
+        tokens.append(data[pos:end])
+        pos = end
+    return tokens, pos + 1
+
+
+def read_netpbm(path):
+    data = open(path, "rb").read()
+    magic = data[:2]
+
+    if magic in (b"P1", b"P4"):
+        (w, h), pos = _netpbm_tokens(data, 2, 2)
+        width, height = int(w), int(h)
+        if magic == b"P1":
+            bits = [int(c) for c in re.findall(rb"[01]", data[pos - 1:])]
+        else:
+            stride = (width + 7) // 8
+            bits = []
+            for y in range(height):
+                row = data[pos + y * stride:pos + (y + 1) * stride]
+                bits.extend((row[x // 8] >> (7 - x % 8)) & 1 for x in range(width))
+        # PBM: 1 is black ink - keep it as the foreground index
+        return width, height, bits[:width * height], [0x0000, 0xFFFF]
+
+    if magic in (b"P3", b"P6"):
+        (w, h, maxval), pos = _netpbm_tokens(data, 3, 2)
+        width, height, maxval = int(w), int(h), int(maxval)
+        if magic == b"P3":
+            values = [int(v) for v in data[pos - 1:].split()]
+        else:
+            values = list(data[pos:pos + width * height * 3])
+
+        colors = []
+        index_of = {}
+        pixels = []
+        for i in range(width * height):
+            r, g, b = (values[i * 3 + c] * 255 // maxval for c in range(3))
+            rgb565 = ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3)
+            if rgb565 not in index_of:
+                index_of[rgb565] = len(colors)
+                colors.append(rgb565)
+            pixels.append(index_of[rgb565])
+        return width, height, pixels, colors
+
+    raise ValueError("%s: unsupported netpbm type %r" % (path, magic))
+
+
+def read_image(path):
+    if path.endswith(".xbm"):
+        return read_xbm(path)
+    return read_netpbm(path)
+
+
+# ---------------------------------------------------------------- encoder
+
+def mirror(width, height, pixels):
+    out = []
+    for y in range(height):
+        out.extend(reversed(pixels[y * width:(y + 1) * width]))
+    return out
+
+
+def encode(pixels):
+    tokens = bytearray()
+    i = 0
+    while i < len(pixels):
+        index = pixels[i]
+        run = 1
+        while i + run < len(pixels) and pixels[i + run] == index and run < LONG_RUN_MAX:
+            run += 1
+        if run < LONG_RUN_BASE:
+            tokens.append((index << 4) | (run - 1))
+        else:
+            tokens.append((index << 4) | SHORT_RUN_MAX)
+            tokens.append(run - LONG_RUN_BASE)
+        i += run
+    return bytes(tokens)
+
+
+def decode(tokens, count):
+    """Reference decoder - used to verify every asset before writing it."""
+    pixels = []
+    i = 0
+    while i < len(tokens):
+        index, n = tokens[i] >> 4, tokens[i] & 0x0F
+        i += 1
+        if n == SHORT_RUN_MAX:
+            run = LONG_RUN_BASE + tokens[i]
+            i += 1
+        else:
+            run = n + 1
+        pixels.extend([index] * run)
+    return pixels[:count]
+
+
+# ---------------------------------------------------------------- output
+
+def c_name(name):
+    return "ASSET_" + re.sub(r"\W", "_", name).upper()
+
+
+def format_bytes(data, indent="    ", per_line=16):
+    lines = []
+    for i in range(0, len(data), per_line):
+        lines.append(indent + ", ".join("0x%02X" % b for b in data[i:i + per_line]) + ",")
+    return "\n".join(lines)
+
+
+def build(root):
+    asset_dir = os.path.join(root, "assets")
+    manifest = os.path.join(asset_dir, "manifest.txt")
+    out_path = os.path.join(root, "include", "assets.h")
+
+    entries = []
+    for line in open(manifest):
+        line = line.split("#", 1)[0].strip()
+        if not line:
+            continue
+        fields = line.split()
+        name, source, options = fields[0], fields[1], fields[2:]
+
+        width, height, pixels, palette = read_image(os.path.join(asset_dir, source))
+        if "mirror" in options:
+            pixels = mirror(width, height, pixels)
+        if len(palette) > MAX_COLORS:
+            raise ValueError("%s: %d colours, at most %d" % (source, len(palette), MAX_COLORS))
+
+        data = encode(pixels)
+        if decode(data, width * height) != pixels:
+            raise AssertionError("%s: RLE round trip failed" % name)
+
+        entries.append((name, source, options, width, height, palette, data))
+
+    out = []
+    out.append("// Generated by tools/build_assets.py from assets/manifest.txt - do not edit")
+    out.append("#ifndef ASSETS_H")
+    out.append("#define ASSETS_H")
+    out.append("")
+    out.append('#include "rle_asset.h"')
+
+    for name, source, options, width, height, palette, data in entries:
+        cname = c_name(name)
+        raw1 = ((width + 7) // 8) * height
+        raw16 = width * height * 2
+        out.append("")
+        out.append("// %s: %dx%d, %d colours from %s%s" %
+                   (name, width, height, len(palette), source,
+                    " (" + " ".join(options) + ")" if options else ""))
+        out.append("// %d bytes RLE vs %d bytes 1-bit / %d bytes RGB565" %
+                   (len(data), raw1, raw16))
+        out.append("static constexpr uint16_t %s_PALETTE[] = {%s};" %
+                   (cname, ", ".join("0x%04X" % c for c in palette)))
+        out.append("static constexpr uint8_t %s_DATA[] = {" % cname)
+        out.append(format_bytes(data))
+        out.append("};")
+        out.append("static constexpr RleAsset %s = {" % cname)
+        out.append('    "%s", %d, %d, %d, %s_PALETTE, %s_DATA, sizeof(%s_DATA)' %
+                   (name, width, height, len(palette), cname, cname, cname))
+        out.append("};")
+
+    out.append("")
+    out.append("// Every asset, for the render benchmark")
+    out.append("static constexpr const RleAsset* ASSET_LIST[] = {")
+    for entry in entries:
+        out.append("    &%s," % c_name(entry[0]))
+    out.append("};")
+    out.append("static constexpr int ASSET_COUNT = %d;" % len(entries))
+    out.append("")
+    out.append("#endif")
+    text = "\n".join(out) + "\n"
+
+    old = open(out_path).read() if os.path.exists(out_path) else None
+    if text != old:
+        with open(out_path, "w") as f:
+            f.write(text)
+        print("Assets: wrote %s (%d assets)" % (out_path, len(entries)))
+
+
+try:
+    Import("env")  # noqa: F821 - defined when run by PlatformIO
+    build(env["PROJECT_DIR"])  # noqa: F821
+except NameError:
+    if __name__ == "__main__":
+        build(os.path.dirname(os.path.dirname(os.path.abspath(__file__))))